@@ -37,6 +37,12 @@ public:                                            \
     }                                              \
     friend class GC::Heap;
 
+// Declares that the cell calls did_store_edge() whenever it stores an edge after its constructor has run, so that
+// minor collections only have to visit it if that happened since the last collection. Like GC_DECLARE_ALLOCATOR, this
+// only covers the class it appears in, not the classes that inherit from it.
+#define GC_DECLARE_WRITE_BARRIER(ClassName) \
+    using WriteBarrierCellType = ClassName
+
 class Cell {
     AK_MAKE_NONCOPYABLE(Cell);
     AK_MAKE_NONMOVABLE(Cell);
@@ -44,16 +50,27 @@ class Cell {
 public:
     virtual ~Cell() = default;
 
-    bool is_marked() const { return m_mark; }
-    void set_marked(bool b) { m_mark = b; }
+    bool is_marked() const { return HeapBlockBase::from_cell(this)->is_cell_marked(this); }
+    void set_marked(bool b) { HeapBlockBase::from_cell(this)->set_cell_marked(this, b); }
+
+    // Used by parallel marking, returns whether the cell was already marked.
+    bool test_and_set_marked() { return HeapBlockBase::from_cell(this)->test_and_set_cell_marked(this); }
+
+    // Cells start out young and are promoted to the old generation once they survive a collection.
+    // Minor collections only trace and sweep young cells.
+    bool is_old() const { return HeapBlockBase::from_cell(this)->is_cell_old(this); }
+    void set_old(bool b) { HeapBlockBase::from_cell(this)->set_cell_old(this, b); }
+
+    // The write barrier for cells declared with GC_DECLARE_WRITE_BARRIER. Old cells without one are treated as
+    // if they had stored an edge since the last collection.
+    void did_store_edge() const { HeapBlockBase::from_cell(this)->set_cell_remembered(this, true); }
 
     enum class State : bool {
         Live,
         Dead,
     };
 
-    State state() const { return m_state; }
-    void set_state(State state) { m_state = state; }
+    State state() const { return HeapBlockBase::from_cell(this)->is_cell_live(this) ? State::Live : State::Dead; }
 
     virtual StringView class_name() const = 0;
 
@@ -188,9 +205,7 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
-    bool m_mark { false };
     bool m_overrides_must_survive_garbage_collection { false };
-    State m_state { State::Live };
 } SWIFT_UNSAFE_REFERENCE;
 
 }
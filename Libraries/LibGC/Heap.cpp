@@ -12,6 +12,7 @@
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
@@ -20,6 +21,9 @@
 #include <LibGC/HeapBlock.h>
 #include <LibGC/NanBoxedValue.h>
 #include <LibGC/Root.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ThreadPool.h>
 #include <setjmp.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
@@ -51,15 +55,27 @@ void Heap::will_allocate(size_t size)
 {
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(collection_type_for_automatic_collection());
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(collection_type_for_automatic_collection());
     }
 
     m_allocated_bytes_since_last_gc += size;
 }
 
+Heap::CollectionType Heap::collection_type_for_automatic_collection() const
+{
+    if (!m_generational_collection_enabled)
+        return CollectionType::CollectGarbage;
+
+    // Once the old generation has grown by as much as survived the last full collection, do another full collection.
+    if (m_promoted_bytes_since_last_major_gc >= m_gc_bytes_threshold)
+        return CollectionType::CollectGarbage;
+
+    return CollectionType::CollectMinor;
+}
+
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(NanBoxedValue)) {
@@ -241,24 +257,28 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 {
     VERIFY(!m_collecting_garbage);
 
+    // Uprooted cells may already have been promoted, and only a full collection is guaranteed to reclaim those.
+    if (collection_type == CollectionType::CollectMinor && !m_uprooted_cells.is_empty())
+        collection_type = CollectionType::CollectGarbage;
+
     {
         TemporaryChange change(m_collecting_garbage, true);
 
-        Core::ElapsedTimer collection_measurement_timer;
-        if (print_report)
-            collection_measurement_timer.start();
+        auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
-        if (collection_type == CollectionType::CollectGarbage) {
+        if (collection_type != CollectionType::CollectEverything) {
             if (m_gc_deferrals) {
                 m_should_gc_when_deferral_ends = true;
                 return;
             }
             HashMap<Cell*, HeapRoot> roots;
             gather_roots(roots);
-            mark_live_cells(roots);
+            record_root_statistics(roots);
+            mark_live_cells(roots, collection_type);
         }
-        finalize_unmarked_cells();
-        sweep_dead_cells(print_report, collection_measurement_timer);
+        finalize_unmarked_cells(collection_type);
+        sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+        record_collection_pause(collection_type, collection_measurement_timer.elapsed_time());
     }
 
     auto tasks = move(m_post_gc_tasks);
@@ -266,11 +286,79 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
         task();
 }
 
+bool Heap::collect_garbage_during_idle_period(AK::Duration idle_time_remaining)
+{
+    if (m_collecting_garbage || m_gc_deferrals || should_collect_on_every_allocation())
+        return false;
+
+    if (m_allocated_bytes_since_last_gc < m_gc_bytes_threshold / 2)
+        return false;
+
+    auto collection_type = collection_type_for_automatic_collection();
+    if (expected_pause_time(collection_type) > idle_time_remaining)
+        return false;
+
+    m_allocated_bytes_since_last_gc = 0;
+    collect_garbage(collection_type);
+    return true;
+}
+
+AK::Duration Heap::expected_pause_time(CollectionType collection_type)
+{
+    auto const& statistics = m_collection_statistics;
+    if (collection_type == CollectionType::CollectMinor && statistics.minor_collections)
+        return AK::Duration::from_microseconds(statistics.total_minor_pause_time.to_microseconds() / static_cast<i64>(statistics.minor_collections));
+    if (collection_type != CollectionType::CollectMinor && statistics.major_collections)
+        return AK::Duration::from_microseconds(statistics.total_major_pause_time.to_microseconds() / static_cast<i64>(statistics.major_collections));
+
+    // Until we've seen a collection of this type, assume it has to go through the whole heap at a pessimistic rate.
+    // This keeps the first idle-time collection of a large heap from blowing way past the idle period.
+    static constexpr size_t conservative_collected_bytes_per_millisecond = 256 * KiB;
+    size_t heap_size = 0;
+    for_each_block([&](auto&) {
+        heap_size += HeapBlock::block_size;
+        return IterationDecision::Continue;
+    });
+    return AK::Duration::from_microseconds(static_cast<i64>(heap_size * 1000 / conservative_collected_bytes_per_millisecond));
+}
+
+void Heap::record_collection_pause(CollectionType collection_type, AK::Duration pause_time)
+{
+    auto& statistics = m_collection_statistics;
+    if (collection_type == CollectionType::CollectMinor) {
+        ++statistics.minor_collections;
+        statistics.total_minor_pause_time += pause_time;
+        statistics.longest_minor_pause_time = max(statistics.longest_minor_pause_time, pause_time);
+    } else {
+        ++statistics.major_collections;
+        statistics.total_major_pause_time += pause_time;
+        statistics.longest_major_pause_time = max(statistics.longest_major_pause_time, pause_time);
+    }
+}
+
 void Heap::enqueue_post_gc_task(AK::Function<void()> task)
 {
     m_post_gc_tasks.append(move(task));
 }
 
+void Heap::record_root_statistics(HashMap<Cell*, HeapRoot> const& roots)
+{
+    size_t conservative_roots = 0;
+    for (auto const& it : roots) {
+        switch (it.value.type) {
+        case HeapRoot::Type::ConservativeVector:
+        case HeapRoot::Type::RegisterPointer:
+        case HeapRoot::Type::StackPointer:
+            ++conservative_roots;
+            break;
+        default:
+            break;
+        }
+    }
+    m_collection_statistics.conservative_roots = conservative_roots;
+    m_collection_statistics.precise_roots = roots.size() - conservative_roots;
+}
+
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
 {
     m_gather_embedder_roots(roots);
@@ -330,15 +418,29 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     FlatPtr min_block_address, max_block_address;
     find_min_and_max_block_addresses(min_block_address, max_block_address);
 
-    for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
-        add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, min_block_address, max_block_address);
+    if (m_conservative_stack_scanning_enabled) {
+        for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
+            add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, min_block_address, max_block_address);
 
-    auto stack_reference = bit_cast<FlatPtr>(&dummy);
+        Vector<StackRange> precisely_scanned_ranges;
+        if (m_gather_precisely_scanned_stack_ranges)
+            m_gather_precisely_scanned_stack_ranges(precisely_scanned_ranges);
+        quick_sort(precisely_scanned_ranges, [](auto const& a, auto const& b) { return a.start < b.start; });
 
-    for (FlatPtr stack_address = stack_reference; stack_address < m_stack_info.top(); stack_address += sizeof(FlatPtr)) {
-        auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
-        gather_asan_fake_stack_roots(possible_pointers, data, min_block_address, max_block_address);
+        auto stack_reference = bit_cast<FlatPtr>(&dummy);
+
+        // The stack is walked upwards, so the precisely scanned ranges can be skipped in a single pass over them.
+        size_t range_index = 0;
+        for (FlatPtr stack_address = stack_reference; stack_address < m_stack_info.top(); stack_address += sizeof(FlatPtr)) {
+            while (range_index < precisely_scanned_ranges.size() && precisely_scanned_ranges[range_index].end <= stack_address)
+                ++range_index;
+            if (range_index < precisely_scanned_ranges.size() && precisely_scanned_ranges[range_index].start <= stack_address)
+                continue;
+
+            auto data = *reinterpret_cast<FlatPtr*>(stack_address);
+            add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
+            gather_asan_fake_stack_roots(possible_pointers, data, min_block_address, max_block_address);
+        }
     }
 
     for (auto& vector : m_conservative_vectors) {
@@ -363,14 +465,132 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     });
 }
 
+// The cells a visitor still has to visit. It's used as a stack, but work is shared from the other end, so the oldest
+// entries can be taken in constant time as well.
+class MarkingWorkQueue {
+public:
+    bool is_empty() const { return m_head == m_cells.size(); }
+    size_t size() const { return m_cells.size() - m_head; }
+
+    void append(Cell& cell) { m_cells.append(cell); }
+
+    Ref<Cell> take_last()
+    {
+        auto cell = m_cells.take_last();
+        if (is_empty())
+            clear();
+        return cell;
+    }
+
+    Vector<Ref<Cell>> take_oldest(size_t count)
+    {
+        VERIFY(count <= size());
+        Vector<Ref<Cell>> cells;
+        cells.ensure_capacity(count);
+        for (size_t i = 0; i < count; ++i)
+            cells.unchecked_append(m_cells[m_head + i]);
+        m_head += count;
+        if (is_empty()) {
+            clear();
+        } else if (m_head >= 1024 && m_head * 2 >= m_cells.size()) {
+            // Reclaim the taken entries once they make up most of the storage, which keeps this amortized constant.
+            m_cells.remove(0, m_head);
+            m_head = 0;
+        }
+        return cells;
+    }
+
+    void replace_with(Vector<Ref<Cell>>&& cells)
+    {
+        m_cells = move(cells);
+        m_head = 0;
+    }
+
+private:
+    void clear()
+    {
+        m_cells.clear_with_capacity();
+        m_head = 0;
+    }
+
+    Vector<Ref<Cell>> m_cells;
+    size_t m_head { 0 };
+};
+
+// Marking work is shared between threads in fixed-size packets. A visitor whose work queue has grown large while
+// other visitors are starving hands its oldest entries over to the shared pool, and idle visitors take packets
+// from the pool. Marking is complete once every visitor is idle and the pool is empty.
+class ParallelMarkingContext {
+public:
+    static constexpr size_t work_packet_size = 64;
+
+    explicit ParallelMarkingContext(size_t visitor_count)
+        : m_visitor_count(visitor_count)
+    {
+    }
+
+    // Must be the last thing a helper thread does with the context.
+    void helper_did_finish()
+    {
+        Threading::MutexLocker locker(m_mutex);
+        ++m_finished_helper_count;
+        m_helpers_finished.signal();
+    }
+
+    void wait_for_helpers_to_finish()
+    {
+        Threading::MutexLocker locker(m_mutex);
+        while (m_finished_helper_count < m_visitor_count - 1)
+            m_helpers_finished.wait();
+    }
+
+    bool has_idle_visitors() const { return m_idle_visitor_count.load(AK::memory_order_relaxed) > 0; }
+
+    void donate_work(Vector<Ref<Cell>>&& packet)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_work_packets.append(move(packet));
+        m_work_available.signal();
+    }
+
+    // Blocks until there is work available, returns false once marking is complete.
+    bool take_work(MarkingWorkQueue& work_queue)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_idle_visitor_count.fetch_add(1, AK::memory_order_relaxed);
+        for (;;) {
+            if (!m_work_packets.is_empty()) {
+                m_idle_visitor_count.fetch_sub(1, AK::memory_order_relaxed);
+                work_queue.replace_with(m_work_packets.take_last());
+                return true;
+            }
+            if (m_idle_visitor_count.load(AK::memory_order_relaxed) == m_visitor_count) {
+                m_work_available.broadcast();
+                return false;
+            }
+            m_work_available.wait();
+        }
+    }
+
+private:
+    size_t const m_visitor_count;
+    Atomic<size_t> m_idle_visitor_count { 0 };
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_work_available { m_mutex };
+    Vector<Vector<Ref<Cell>>> m_work_packets;
+    size_t m_finished_helper_count { 0 };
+    Threading::ConditionVariable m_helpers_finished { m_mutex };
+};
+
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
-        : m_heap(heap)
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, Heap::CollectionType collection_type)
+        : m_only_mark_young_cells(collection_type == Heap::CollectionType::CollectMinor)
+        , m_all_live_heap_blocks(&m_owned_live_heap_blocks)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
+        heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
+        heap.for_each_block([&](auto& block) {
+            m_owned_live_heap_blocks.set(&block);
             return IterationDecision::Continue;
         });
 
@@ -379,13 +599,24 @@ public:
         }
     }
 
+    // Creates a visitor for a marking helper thread, sharing the heap block lookup of the collecting thread's visitor.
+    MarkingVisitor(MarkingVisitor const& main_visitor, ParallelMarkingContext& parallel_marking_context)
+        : m_only_mark_young_cells(main_visitor.m_only_mark_young_cells)
+        , m_all_live_heap_blocks(main_visitor.m_all_live_heap_blocks)
+        , m_min_block_address(main_visitor.m_min_block_address)
+        , m_max_block_address(main_visitor.m_max_block_address)
+        , m_parallel_marking_context(&parallel_marking_context)
+    {
+    }
+
+    void set_parallel_marking_context(ParallelMarkingContext* context) { m_parallel_marking_context = context; }
+
     virtual void visit_impl(Cell& cell) override
     {
-        if (cell.is_marked())
+        if (!mark(cell))
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
-        cell.set_marked(true);
         m_work_queue.append(cell);
     }
 
@@ -397,45 +628,130 @@ public:
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
-                return;
+        for_each_cell_among_possible_pointers(*m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
             if (cell->state() != Cell::State::Live)
                 return;
-            cell->set_marked(true);
+            if (!mark(*cell))
+                return;
             m_work_queue.append(*cell);
         });
     }
 
     void mark_all_live_cells()
     {
-        while (!m_work_queue.is_empty()) {
-            m_work_queue.take_last()->visit_edges(*this);
+        for (;;) {
+            while (!m_work_queue.is_empty()) {
+                m_work_queue.take_last()->visit_edges(*this);
+                if (m_parallel_marking_context)
+                    share_work_if_needed();
+            }
+            if (!m_parallel_marking_context || !m_parallel_marking_context->take_work(m_work_queue))
+                return;
         }
     }
 
 private:
-    Heap& m_heap;
-    Vector<Ref<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    // Returns whether the cell was newly marked and needs to have its edges visited.
+    ALWAYS_INLINE bool mark(Cell& cell)
+    {
+        if (m_only_mark_young_cells && cell.is_old())
+            return false;
+        if (m_parallel_marking_context)
+            return !cell.test_and_set_marked();
+        if (cell.is_marked())
+            return false;
+        cell.set_marked(true);
+        return true;
+    }
+
+    void share_work_if_needed()
+    {
+        static constexpr auto packet_size = ParallelMarkingContext::work_packet_size;
+        if (m_work_queue.size() < 2 * packet_size || !m_parallel_marking_context->has_idle_visitors())
+            return;
+
+        // Hand out the oldest entries, as they tend to lead to the largest unexplored parts of the graph.
+        m_parallel_marking_context->donate_work(m_work_queue.take_oldest(packet_size));
+    }
+
+    bool m_only_mark_young_cells { false };
+    MarkingWorkQueue m_work_queue;
+    HashTable<HeapBlock*> m_owned_live_heap_blocks;
+    HashTable<HeapBlock*> const* m_all_live_heap_blocks { nullptr };
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
+    ParallelMarkingContext* m_parallel_marking_context { nullptr };
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::set_marking_helper_thread_count(size_t count)
 {
-    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+    if (count == m_marking_helper_thread_count)
+        return;
+    m_marking_helper_thread_count = count;
+    m_marking_thread_pool = nullptr;
+}
 
-    MarkingVisitor visitor(*this, roots);
+void Heap::mark_all_live_cells_in_parallel(MarkingVisitor& visitor)
+{
+    // The helper threads are kept around between collections.
+    if (!m_marking_thread_pool)
+        m_marking_thread_pool = make<Threading::ThreadPool>(m_marking_helper_thread_count, "GC Marker"sv);
+
+    ParallelMarkingContext context(m_marking_helper_thread_count + 1);
+    visitor.set_parallel_marking_context(&context);
+
+    for (size_t i = 0; i < m_marking_helper_thread_count; ++i) {
+        m_marking_thread_pool->submit([main_visitor = &visitor, context = &context] {
+            {
+                MarkingVisitor helper_visitor(*main_visitor, *context);
+                helper_visitor.mark_all_live_cells();
+            }
+            context->helper_did_finish();
+        },
+            Threading::ThreadPool::Priority::High);
+    }
 
     visitor.mark_all_live_cells();
+    context.wait_for_helpers_to_finish();
+
+    visitor.set_parallel_marking_context(nullptr);
+}
+
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, CollectionType collection_type)
+{
+    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+
+    bool is_minor_collection = collection_type == CollectionType::CollectMinor;
+
+    MarkingVisitor visitor(*this, roots, collection_type);
+
+    if (is_minor_collection) {
+        // Old cells are implicitly live during a minor collection, so the only edges into the young generation
+        // we have to find are the ones from old cells. Cells with a write barrier tell us when they store an edge,
+        // but most can store them anywhere (including NanBoxedValues in malloc'ed storage), so the old cells
+        // without one are always treated as remembered. The visitor never follows an edge into another old cell,
+        // so this doesn't trace the old graph.
+        for_each_block([&](auto& block) {
+            block.for_each_remembered_old_cell([&](Cell* cell) {
+                cell->visit_edges(visitor);
+            });
+            return IterationDecision::Continue;
+        });
+    }
+
+    if (m_marking_helper_thread_count > 0)
+        mark_all_live_cells_in_parallel(visitor);
+    else
+        visitor.mark_all_live_cells();
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
     for_each_block([&](auto& block) {
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked() && cell_must_survive_garbage_collection(*cell))
+        if (is_minor_collection && !block.has_young_cells())
+            return IterationDecision::Continue;
+        block.for_each_unmarked_live_cell(is_minor_collection, [&](Cell* cell) {
+            if (cell_must_survive_garbage_collection(*cell))
                 cell->visit_edges(visitor);
         });
         return IterationDecision::Continue;
@@ -451,45 +767,47 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
     return cell.must_survive_garbage_collection();
 }
 
-void Heap::finalize_unmarked_cells()
+void Heap::finalize_unmarked_cells(CollectionType collection_type)
 {
+    bool is_minor_collection = collection_type == CollectionType::CollectMinor;
+
     for_each_block([&](auto& block) {
-        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
-            if (!cell->is_marked())
-                cell->finalize();
+        if (is_minor_collection && !block.has_young_cells())
+            return IterationDecision::Continue;
+        block.for_each_unmarked_live_cell(is_minor_collection, [](Cell* cell) {
+            cell->finalize();
         });
         return IterationDecision::Continue;
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
 
+    bool is_minor_collection = collection_type == CollectionType::CollectMinor;
+
     size_t collected_cells = 0;
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t promoted_cells = 0;
+    size_t promoted_cell_bytes = 0;
 
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
+        if (is_minor_collection && !block.has_young_cells())
+            return IterationDecision::Continue;
         bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked()) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
-            }
-        });
-        if (!block_has_live_cells)
+        auto result = block.sweep(is_minor_collection);
+        collected_cells += result.collected_cells;
+        collected_cell_bytes += result.collected_cells * block.cell_size();
+        live_cells += result.live_cells;
+        live_cell_bytes += result.live_cells * block.cell_size();
+        promoted_cells += result.promoted_cells;
+        promoted_cell_bytes += result.promoted_cells * block.cell_size();
+        if (!result.live_cells)
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
@@ -516,7 +834,12 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    if (is_minor_collection) {
+        m_promoted_bytes_since_last_major_gc += promoted_cell_bytes;
+    } else {
+        m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+        m_promoted_bytes_since_last_major_gc = 0;
+    }
 
     if (print_report) {
         AK::Duration const time_spent = measurement_timer.elapsed_time();
@@ -526,10 +849,13 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
             return IterationDecision::Continue;
         });
 
-        dbgln("Garbage collection report");
+        dbgln("Garbage collection report{}", is_minor_collection ? " (minor)"sv : ""sv);
         dbgln("=============================================");
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
+        if (is_minor_collection)
+            dbgln(" Promoted cells: {} ({} bytes)", promoted_cells, promoted_cell_bytes);
+        else
+            dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
@@ -549,7 +875,7 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(collection_type_for_automatic_collection());
         m_should_gc_when_deferral_ends = false;
     }
 }
@@ -12,8 +12,10 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -27,9 +29,12 @@
 #include <LibGC/RootHashMap.h>
 #include <LibGC/RootVector.h>
 #include <LibGC/WeakContainer.h>
+#include <LibThreading/Forward.h>
 
 namespace GC {
 
+class MarkingVisitor;
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -42,6 +47,8 @@ public:
     Ref<T> allocate(Args&&... args)
     {
         auto* memory = allocate_cell<T>();
+        if constexpr (has_write_barrier<T>())
+            HeapBlockBase::from_cell(memory)->set_cell_has_write_barrier(memory, true);
         defer_gc();
         new (memory) T(forward<Args>(args)...);
         undefer_gc();
@@ -50,6 +57,7 @@ public:
 
     enum class CollectionType {
         CollectGarbage,
+        CollectMinor,
         CollectEverything,
     };
 
@@ -59,6 +67,48 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // When enabled, collections triggered by allocation pressure only collect the young generation,
+    // until enough cells have been promoted since the last full collection to warrant another one.
+    bool is_generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool b) { m_generational_collection_enabled = b; }
+
+    // Number of threads that help the collecting thread mark live cells. This requires visit_edges() to be safe to
+    // call concurrently for different cells, which is why it's off by default.
+    size_t marking_helper_thread_count() const { return m_marking_helper_thread_count; }
+    void set_marking_helper_thread_count(size_t);
+
+    // Parts of the native stack whose contents the embedder already reports precisely when gathering roots,
+    // such as interpreter frames allocated with alloca(). These are skipped when scanning the stack conservatively.
+    struct StackRange {
+        FlatPtr start { 0 };
+        FlatPtr end { 0 };
+    };
+    void set_gather_precisely_scanned_stack_ranges(AK::Function<void(Vector<StackRange>&)> callback) { m_gather_precisely_scanned_stack_ranges = move(callback); }
+
+    // When disabled, the native stack and registers are not scanned at all. This is only safe if no native frame
+    // holds the sole reference to a cell, so it's meant for measuring how many roots are known precisely.
+    bool is_conservative_stack_scanning_enabled() const { return m_conservative_stack_scanning_enabled; }
+    void set_conservative_stack_scanning_enabled(bool b) { m_conservative_stack_scanning_enabled = b; }
+
+    struct CollectionStatistics {
+        size_t minor_collections { 0 };
+        size_t major_collections { 0 };
+        AK::Duration total_minor_pause_time;
+        AK::Duration total_major_pause_time;
+        AK::Duration longest_minor_pause_time;
+        AK::Duration longest_major_pause_time;
+
+        // Roots found by the most recent collection. Cells that were found both precisely and conservatively
+        // are counted as precise roots.
+        size_t precise_roots { 0 };
+        size_t conservative_roots { 0 };
+    };
+    CollectionStatistics const& collection_statistics() const { return m_collection_statistics; }
+
+    // Lets the embedder run a collection while it's idle, before allocation pressure would force one at a worse time.
+    // A collection is only performed if one is at least halfway due and the expected pause fits in the idle time.
+    bool collect_garbage_during_idle_period(AK::Duration idle_time_remaining);
+
     void did_create_root(Badge<RootImpl>, RootImpl&);
     void did_destroy_root(Badge<RootImpl>, RootImpl&);
 
@@ -93,6 +143,14 @@ private:
 
     static bool cell_must_survive_garbage_collection(Cell const&);
 
+    template<typename T>
+    static consteval bool has_write_barrier()
+    {
+        if constexpr (requires { typename T::WriteBarrierCellType; })
+            return IsSame<T, typename T::WriteBarrierCellType>;
+        return false;
+    }
+
     template<typename T>
     Cell* allocate_cell()
     {
@@ -106,14 +164,19 @@ private:
     }
 
     void will_allocate(size_t);
+    CollectionType collection_type_for_automatic_collection() const;
+    AK::Duration expected_pause_time(CollectionType);
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
-    void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, CollectionType);
+    void mark_all_live_cells_in_parallel(MarkingVisitor&);
+    void finalize_unmarked_cells(CollectionType);
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
+    void record_collection_pause(CollectionType, AK::Duration);
+    void record_root_statistics(HashMap<Cell*, HeapRoot> const&);
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -138,8 +201,15 @@ private:
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
+    size_t m_promoted_bytes_since_last_major_gc { 0 };
 
     bool m_should_collect_on_every_allocation { false };
+    bool m_generational_collection_enabled { false };
+    size_t m_marking_helper_thread_count { 0 };
+    OwnPtr<Threading::ThreadPool> m_marking_thread_pool;
+    bool m_conservative_stack_scanning_enabled { true };
+
+    CollectionStatistics m_collection_statistics;
 
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
@@ -158,6 +228,7 @@ private:
     bool m_collecting_garbage { false };
     StackInfo m_stack_info;
     AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> m_gather_embedder_roots;
+    AK::Function<void(Vector<StackRange>&)> m_gather_precisely_scanned_stack_ranges;
 
     Vector<AK::Function<void()>> m_post_gc_tasks;
 } SWIFT_IMMORTAL_REFERENCE;
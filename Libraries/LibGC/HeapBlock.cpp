@@ -5,6 +5,7 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/Debug.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Platform.h>
 #include <LibGC/Heap.h>
@@ -32,9 +33,14 @@ HeapBlock::HeapBlock(Heap& heap, CellAllocator& cell_allocator, size_t cell_size
     : HeapBlockBase(heap)
     , m_cell_allocator(cell_allocator)
     , m_cell_size(cell_size)
+    , m_cell_count((block_size - sizeof(HeapBlock) - bitmaps_size_in_bytes()) / cell_size)
 {
     VERIFY(cell_size >= sizeof(FreelistEntry));
-    ASAN_POISON_MEMORY_REGION(m_storage, block_size - sizeof(HeapBlock));
+    VERIFY(cell_size >= granule_size);
+    m_bitmaps = reinterpret_cast<u64*>(m_storage);
+    __builtin_memset(m_bitmaps, 0, bitmaps_size_in_bytes());
+    VERIFY(granule_index(cell(0)) * granule_size == bit_cast<FlatPtr>(cell(0)) - bit_cast<FlatPtr>(this));
+    ASAN_POISON_MEMORY_REGION(cell(0), block_size - sizeof(HeapBlock) - bitmaps_size_in_bytes());
 }
 
 void HeapBlock::deallocate(Cell* cell)
@@ -45,8 +51,11 @@ void HeapBlock::deallocate(Cell* cell)
     VERIFY(!cell->is_marked());
 
     cell->~Cell();
+    set_bit(live_bitmap(), cell, false);
+    set_bit(old_bitmap(), cell, false);
+    set_bit(write_barrier_bitmap(), cell, false);
+    set_bit(remembered_bitmap(), cell, false);
     auto* freelist_entry = new (cell) FreelistEntry();
-    freelist_entry->set_state(Cell::State::Dead);
     freelist_entry->next = m_freelist;
     m_freelist = freelist_entry;
 
@@ -61,4 +70,64 @@ void HeapBlock::deallocate(Cell* cell)
 #endif
 }
 
+HeapBlock::SweepResult HeapBlock::sweep(bool is_minor_collection)
+{
+    auto word_count = bitmap_word_count();
+    auto* live = live_bitmap();
+    auto* mark = mark_bitmap();
+    auto* old = old_bitmap();
+    auto* remembered = remembered_bitmap();
+
+    // Old cells are never marked by a minor collection, but they survive it regardless.
+    auto surviving_cells = [&](size_t word_index) {
+        return live[word_index] & (is_minor_collection ? mark[word_index] | old[word_index] : mark[word_index]);
+    };
+
+    SweepResult result;
+    for (size_t i = 0; i < word_count; ++i) {
+        auto surviving = surviving_cells(i);
+        result.live_cells += popcount(surviving);
+        result.promoted_cells += popcount(surviving & ~old[i]);
+        result.collected_cells += popcount(live[i] & ~surviving);
+    }
+
+    m_has_young_cells = false;
+
+    // Every survivor gets promoted, so no old cell can point to a young one after this.
+    if (!is_minor_collection) {
+        for (size_t i = 0; i < word_count; ++i)
+            remembered[i] = 0;
+    }
+
+    if (result.collected_cells == 0) {
+        // Everything survived, so there's nothing to do besides promoting the survivors.
+        for (size_t i = 0; i < word_count; ++i) {
+            old[i] |= live[i];
+            mark[i] = 0;
+        }
+        return result;
+    }
+
+    if (result.live_cells == 0) {
+        // Nothing survived. The block is about to be returned to the BlockAllocator, so don't bother building a freelist.
+        for_each_cell_in_bitmap([&](size_t word_index) { return live[word_index]; }, [&](Cell* cell) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            cell->~Cell();
+        });
+        __builtin_memset(m_bitmaps, 0, bitmaps_size_in_bytes());
+        return result;
+    }
+
+    for_each_cell_in_bitmap([&](size_t word_index) { return live[word_index] & ~surviving_cells(word_index); }, [&](Cell* cell) {
+        dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+        deallocate(cell);
+    });
+
+    for (size_t i = 0; i < word_count; ++i) {
+        old[i] |= live[i];
+        mark[i] = 0;
+    }
+    return result;
+}
+
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Platform.h>
 #include <AK/StringView.h>
@@ -29,7 +30,7 @@ public:
     static NonnullOwnPtr<HeapBlock> create_with_cell_size(Heap&, CellAllocator&, size_t cell_size, char const* class_name);
 
     size_t cell_size() const { return m_cell_size; }
-    size_t cell_count() const { return (block_size - sizeof(HeapBlock)) / m_cell_size; }
+    size_t cell_count() const { return m_cell_count; }
     bool is_full() const { return !has_lazy_freelist() && !m_freelist; }
 
     ALWAYS_INLINE Cell* allocate()
@@ -44,12 +45,24 @@ public:
 
         if (allocated_cell) {
             ASAN_UNPOISON_MEMORY_REGION(allocated_cell, m_cell_size);
+            set_bit(live_bitmap(), allocated_cell, true);
+            m_has_young_cells = true;
         }
         return allocated_cell;
     }
 
     void deallocate(Cell*);
 
+    struct SweepResult {
+        size_t live_cells { 0 };
+        size_t collected_cells { 0 };
+        size_t promoted_cells { 0 };
+    };
+
+    // Destroys every unmarked cell (only the young ones in a minor collection), clears the mark bits and
+    // promotes the survivors to the old generation.
+    SweepResult sweep(bool is_minor_collection);
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -61,10 +74,37 @@ public:
     template<Cell::State state, typename Callback>
     void for_each_cell_in_state(Callback callback)
     {
-        for_each_cell([&](auto* cell) {
-            if (cell->state() == state)
-                callback(cell);
-        });
+        if constexpr (state == Cell::State::Live) {
+            for_each_cell_in_bitmap([&](size_t word_index) { return live_bitmap()[word_index]; }, callback);
+        } else {
+            for_each_cell([&](auto* cell) {
+                if (cell->state() == state)
+                    callback(cell);
+            });
+        }
+    }
+
+    template<typename Callback>
+    void for_each_unmarked_live_cell(bool only_young_cells, Callback callback)
+    {
+        for_each_cell_in_bitmap([&](size_t word_index) {
+            auto word = live_bitmap()[word_index] & ~mark_bitmap()[word_index];
+            return only_young_cells ? word & ~old_bitmap()[word_index] : word;
+        },
+            callback);
+    }
+
+    // Calls the callback for every old cell that may have stored an edge to a young cell since the last collection,
+    // i.e. the ones that called did_store_edge() and the ones without a write barrier, and forgets about the former.
+    template<typename Callback>
+    void for_each_remembered_old_cell(Callback callback)
+    {
+        for_each_cell_in_bitmap([&](size_t word_index) {
+            auto remembered = remembered_bitmap()[word_index] | ~write_barrier_bitmap()[word_index];
+            remembered_bitmap()[word_index] = 0;
+            return live_bitmap()[word_index] & old_bitmap()[word_index] & remembered;
+        },
+            callback);
     }
 
     static HeapBlock* from_cell(Cell const* cell)
@@ -74,9 +114,10 @@ public:
 
     Cell* cell_from_possible_pointer(FlatPtr pointer)
     {
-        if (pointer < reinterpret_cast<FlatPtr>(m_storage))
+        auto cells_begin = reinterpret_cast<FlatPtr>(cell(0));
+        if (pointer < cells_begin)
             return nullptr;
-        size_t cell_index = (pointer - reinterpret_cast<FlatPtr>(m_storage)) / m_cell_size;
+        size_t cell_index = (pointer - cells_begin) / m_cell_size;
         auto end = has_lazy_freelist() ? m_next_lazy_freelist_index : cell_count();
         if (cell_index >= end)
             return nullptr;
@@ -88,6 +129,10 @@ public:
         return cell_from_possible_pointer((FlatPtr)cell);
     }
 
+    // Set when a cell is allocated from this block, cleared by the sweeper once every cell in it has been promoted.
+    bool has_young_cells() const { return m_has_young_cells; }
+    void set_has_young_cells(bool b) { m_has_young_cells = b; }
+
     IntrusiveListNode<HeapBlock> m_list_node;
 
     CellAllocator& cell_allocator() { return m_cell_allocator; }
@@ -103,14 +148,44 @@ private:
         RawPtr<FreelistEntry> next;
     };
 
+    // The bitmaps occupy the start of the storage, cells follow them at a granule-aligned offset.
+    static size_t bitmaps_size_in_bytes() { return round_up_to_power_of_two(bitmap_count * bitmap_word_count() * sizeof(u64), granule_size); }
+
     Cell* cell(size_t index)
     {
-        return reinterpret_cast<Cell*>(&m_storage[index * cell_size()]);
+        return reinterpret_cast<Cell*>(&m_storage[bitmaps_size_in_bytes() + index * cell_size()]);
+    }
+
+    Cell* cell_at_granule(size_t granule_index)
+    {
+        // Cells are at least a granule large and the first one is granule-aligned, so the cell starting in
+        // this granule is the first one at or after the granule's start address.
+        auto first_cell_granule = (bit_cast<FlatPtr>(cell(0)) - bit_cast<FlatPtr>(this)) / granule_size;
+        auto offset = (granule_index - first_cell_granule) * granule_size;
+        return cell((offset + m_cell_size - 1) / m_cell_size);
+    }
+
+    // Calls the callback for every cell whose bit is set in the words produced by compute_word, without
+    // touching the memory of any other cell.
+    template<typename WordCallback, typename Callback>
+    void for_each_cell_in_bitmap(WordCallback compute_word, Callback callback)
+    {
+        auto word_count = bitmap_word_count();
+        for (size_t word_index = 0; word_index < word_count; ++word_index) {
+            u64 word = compute_word(word_index);
+            while (word) {
+                auto bit = count_trailing_zeroes(word);
+                word &= word - 1;
+                callback(cell_at_granule(word_index * 64 + bit));
+            }
+        }
     }
 
     CellAllocator& m_cell_allocator;
     size_t m_cell_size { 0 };
+    size_t m_cell_count { 0 };
     size_t m_next_lazy_freelist_index { 0 };
+    bool m_has_young_cells { false };
     Ptr<FreelistEntry> m_freelist;
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Types.h>
 #include <LibGC/Export.h>
 #include <LibGC/Forward.h>
@@ -42,13 +43,66 @@ public:
 
     Heap& heap() { return m_heap; }
 
+    // Per-cell GC state is kept in bitmaps at the start of each block rather than in the cells themselves,
+    // so the collector can find the cells it cares about without touching the memory of the others.
+    // Each bit covers one granule of the block, and every cell starts in a distinct granule.
+    static constexpr size_t granule_size = 16;
+    static constexpr size_t bitmap_count = 5;
+    static size_t bitmap_word_count() { return block_size / granule_size / 64; }
+
+    bool is_cell_live(Cell const* cell) const { return test_bit(live_bitmap(), cell); }
+    bool is_cell_marked(Cell const* cell) const { return test_bit(mark_bitmap(), cell); }
+    bool is_cell_old(Cell const* cell) const { return test_bit(old_bitmap(), cell); }
+    bool cell_has_write_barrier(Cell const* cell) const { return test_bit(write_barrier_bitmap(), cell); }
+
+    void set_cell_marked(Cell const* cell, bool b) { set_bit(mark_bitmap(), cell, b); }
+    void set_cell_old(Cell const* cell, bool b) { set_bit(old_bitmap(), cell, b); }
+    void set_cell_has_write_barrier(Cell const* cell, bool b) { set_bit(write_barrier_bitmap(), cell, b); }
+    void set_cell_remembered(Cell const* cell, bool b) { set_bit(remembered_bitmap(), cell, b); }
+
+    // Returns whether the cell was already marked. Safe to call from several threads at once.
+    bool test_and_set_cell_marked(Cell const* cell)
+    {
+        auto index = granule_index(cell);
+        u64 mask = static_cast<u64>(1) << (index % 64);
+        return AK::atomic_fetch_or(&mark_bitmap()[index / 64], mask, AK::memory_order_relaxed) & mask;
+    }
+
 protected:
     HeapBlockBase(Heap& heap)
         : m_heap(heap)
     {
     }
 
+    u64* live_bitmap() const { return m_bitmaps; }
+    u64* mark_bitmap() const { return m_bitmaps + bitmap_word_count(); }
+    u64* old_bitmap() const { return m_bitmaps + 2 * bitmap_word_count(); }
+    u64* write_barrier_bitmap() const { return m_bitmaps + 3 * bitmap_word_count(); }
+    u64* remembered_bitmap() const { return m_bitmaps + 4 * bitmap_word_count(); }
+
+    ALWAYS_INLINE size_t granule_index(Cell const* cell) const
+    {
+        return (bit_cast<FlatPtr>(cell) - bit_cast<FlatPtr>(this)) / granule_size;
+    }
+
+    ALWAYS_INLINE bool test_bit(u64 const* bitmap, Cell const* cell) const
+    {
+        auto index = granule_index(cell);
+        return bitmap[index / 64] & (static_cast<u64>(1) << (index % 64));
+    }
+
+    ALWAYS_INLINE void set_bit(u64* bitmap, Cell const* cell, bool b)
+    {
+        auto index = granule_index(cell);
+        u64 mask = static_cast<u64>(1) << (index % 64);
+        if (b)
+            bitmap[index / 64] |= mask;
+        else
+            bitmap[index / 64] &= ~mask;
+    }
+
     Heap& m_heap;
+    u64* m_bitmaps { nullptr };
 };
 
 }
@@ -35,6 +35,7 @@
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/ValueInlines.h>
+#include <LibJS/SourceCode.h>
 #include <memory>
 #include <typeinfo>
 
@@ -844,6 +845,17 @@ FunctionNode::FunctionNode(RefPtr<Identifier const> name, ByteString source_text
 
 FunctionNode::~FunctionNode() = default;
 
+StringView LazyFunctionBody::source_text() const
+{
+    return source_code->code().bytes_as_string_view().substring_view(start.offset, end_offset - start.offset);
+}
+
+void FunctionNode::drop_body(NonnullRefPtr<LazyFunctionBody const> lazy_body)
+{
+    m_lazy_body = move(lazy_body);
+    m_body = nullptr;
+}
+
 void FunctionNode::set_shared_data(RefPtr<SharedFunctionInstanceData> shared_data) const
 {
     m_shared_data = move(shared_data);
@@ -888,6 +900,11 @@ void FunctionNode::dump(int indent, ByteString const& class_name) const
     }
     print_indent(indent + 1);
     outln("(Body)");
+    if (m_lazy_body) {
+        print_indent(indent + 2);
+        outln("(Not parsed yet)");
+        return;
+    }
     body().dump(indent + 2);
 }
 
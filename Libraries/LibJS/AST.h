@@ -777,13 +777,43 @@ struct FunctionParsingInsights {
     bool might_need_arguments_object { false };
 };
 
+// Everything needed to parse the body of a function again after it was dropped, see g_lazy_function_parsing.
+struct LazyFunctionBody : public RefCounted<LazyFunctionBody> {
+    explicit LazyFunctionBody(NonnullRefPtr<SourceCode const> source_code)
+        : source_code(move(source_code))
+    {
+    }
+
+    // The function's text is not copied, it's found again through these offsets into the source code.
+    StringView source_text() const;
+
+    NonnullRefPtr<SourceCode const> source_code;
+    Position start;
+    size_t end_offset { 0 };
+    Program::Type program_type { Program::Type::Script };
+    u16 parse_options { 0 };
+    bool strict_mode { false };
+
+    // One identifier for every name that the function refers to without declaring it. The enclosing code decides
+    // how these resolve (e.g. as globals), so their flags are copied over to the reparsed function.
+    Vector<NonnullRefPtr<Identifier const>> free_identifiers;
+};
+
 class FunctionNode {
 public:
     FlyString name() const { return m_name ? m_name->string() : ""_fly_string; }
     RefPtr<Identifier const> name_identifier() const { return m_name; }
     ByteString const& source_text() const { return m_source_text; }
-    Statement const& body() const { return *m_body; }
+    Statement const& body() const
+    {
+        VERIFY(m_body);
+        return *m_body;
+    }
     auto const& body_ptr() const { return m_body; }
+
+    // If set, the body was dropped after parsing and body_ptr() is null.
+    RefPtr<LazyFunctionBody const> const& lazy_body() const { return m_lazy_body; }
+    void drop_body(NonnullRefPtr<LazyFunctionBody const>);
     auto const& parameters() const { return m_parameters; }
     i32 function_length() const { return m_function_length; }
     Vector<LocalVariable> const& local_variables_names() const { return m_local_variables_names; }
@@ -811,7 +841,8 @@ protected:
 
 private:
     ByteString m_source_text;
-    NonnullRefPtr<Statement const> m_body;
+    RefPtr<Statement const> m_body;
+    RefPtr<LazyFunctionBody const> m_lazy_body;
     NonnullRefPtr<FunctionParameters const> m_parameters;
     i32 const m_function_length;
     FunctionKind m_kind;
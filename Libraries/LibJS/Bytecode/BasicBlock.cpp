@@ -37,4 +37,14 @@ void BasicBlock::grow(size_t additional_size)
     m_buffer.resize(m_buffer.size() + additional_size);
 }
 
+void BasicBlock::set_instruction_stream(Vector<u8> buffer, HashMap<size_t, SourceRecord> source_map)
+{
+    m_buffer = move(buffer);
+    m_source_map = move(source_map);
+
+    m_last_instruction_start_offset = 0;
+    for (InstructionStreamIterator it(instruction_stream()); !it.at_end(); ++it)
+        m_last_instruction_start_offset = it.offset();
+}
+
 }
@@ -30,6 +30,7 @@ public:
     ~BasicBlock();
 
     u32 index() const { return m_index; }
+    void set_index(u32 index) { m_index = index; }
 
     ReadonlyBytes instruction_stream() const { return m_buffer.span(); }
     u8* data() { return m_buffer.data(); }
@@ -44,6 +45,10 @@ public:
 
     void grow(size_t additional_size);
 
+    // Takes ownership of the instructions in the new stream. The instructions in the old one must already have been
+    // moved over or destroyed by the caller.
+    void set_instruction_stream(Vector<u8>, HashMap<size_t, SourceRecord> source_map);
+
     void terminate(Badge<Generator>) { m_terminated = true; }
     bool is_terminated() const { return m_terminated; }
 
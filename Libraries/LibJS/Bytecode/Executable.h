@@ -32,7 +32,18 @@ struct PropertyLookupCache {
         WeakPtr<Object> prototype;
         WeakPtr<PrototypeChainValidity> prototype_chain_validity;
     };
+
+    // How many different shapes this site has seen. Once it has seen more than it can remember, its entries are
+    // no longer used, and lookups go through the VM-wide StubCache instead.
+    enum class State : u8 {
+        Uninitialized,
+        Monomorphic,
+        Polymorphic,
+        Megamorphic,
+    };
+
     AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+    State state { State::Uninitialized };
 };
 
 struct GlobalVariableCache : public PropertyLookupCache {
@@ -97,6 +108,12 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+    // Baseline JIT state. The hotness counter is bumped every time the executable is entered or jumps backwards while
+    // the JIT is enabled, and compilation is only attempted once.
+    u32 jit_hotness { 0 };
+    bool did_attempt_jit_compilation { false };
+    OwnPtr<JIT::NativeExecutable> native_executable;
+
     String const& get_string(StringTableIndex index) const { return string_table->get(index); }
     FlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
@@ -346,10 +346,18 @@ public:
 
     [[nodiscard]] Value get_constant(ScopedOperand const& operand) const
     {
-        VERIFY(operand.operand().is_constant());
-        return m_constants[operand.operand().index()];
+        return get_constant(operand.operand());
     }
 
+    [[nodiscard]] Value get_constant(Operand const& operand) const
+    {
+        VERIFY(operand.is_constant());
+        return m_constants[operand.index()];
+    }
+
+    // NOTE: Only the optimization passes should touch this, after code generation is done.
+    [[nodiscard]] Vector<NonnullOwnPtr<BasicBlock>>& basic_blocks() { return m_root_basic_blocks; }
+
     UnwindContext const* current_unwind_context() const { return m_current_unwind_context; }
 
     [[nodiscard]] bool is_finished() const { return m_finished; }
@@ -17,6 +17,7 @@
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Export.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -190,6 +191,15 @@ Interpreter::~Interpreter()
 {
 }
 
+void Interpreter::visit_edges(Cell::Visitor& visitor)
+{
+    visitor.visit(m_current_executable);
+    visitor.visit(m_realm);
+    visitor.visit(m_global_object);
+    visitor.visit(m_global_declarative_environment);
+    visitor.visit(m_argument_values_buffer);
+}
+
 ALWAYS_INLINE Value Interpreter::get(Operand op) const
 {
     return m_registers_and_constants_and_locals_arguments.data()[op.index()];
@@ -359,6 +369,30 @@ NEVER_INLINE Interpreter::HandleExceptionResponse Interpreter::handle_exception(
     VERIFY_NOT_REACHED();
 }
 
+static JIT::NativeExecutable const* native_executable_if_hot(Executable& executable)
+{
+    if (executable.native_executable)
+        return executable.native_executable.ptr();
+    if (executable.did_attempt_jit_compilation || ++executable.jit_hotness < JIT::g_compile_threshold)
+        return nullptr;
+    executable.did_attempt_jit_compilation = true;
+    executable.native_executable = JIT::Compiler::compile(executable);
+    return executable.native_executable.ptr();
+}
+
+bool Interpreter::run_native_code(JIT::NativeExecutable const& native_executable, size_t& program_counter)
+{
+    switch (native_executable.run(*this, m_registers_and_constants_and_locals_arguments.data(), program_counter)) {
+    case JIT::NativeExecutable::Result::Finished:
+        return true;
+    case JIT::NativeExecutable::Result::Exception:
+        return handle_exception(program_counter, reg(Register::exception())) == HandleExceptionResponse::ExitFromExecutable;
+    case JIT::NativeExecutable::Result::Bailout:
+        return false;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 // FIXME: GCC takes a *long* time to compile with flattening, and it will time out our CI. :|
 #if defined(AK_COMPILER_CLANG)
 #    define FLATTEN_ON_CLANG FLATTEN
@@ -380,6 +414,13 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
     size_t& program_counter = running_execution_context.program_counter;
     program_counter = entry_point;
 
+    if (JIT::g_enabled) [[unlikely]] {
+        if (auto const* native_executable = native_executable_if_hot(executable)) {
+            if (run_native_code(*native_executable, program_counter))
+                return;
+        }
+    }
+
     // Declare a lookup table for computed goto with each of the `handle_*` labels
     // to avoid the overhead of a switch statement.
     // This is a GCC extension, but it's also supported by Clang.
@@ -419,7 +460,17 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
-            program_counter = instruction.target().address();
+            auto target = instruction.target().address();
+            // Backward jumps are loop iterations, which lets long-running loops tier up without waiting for another call.
+            if (JIT::g_enabled && target <= program_counter) [[unlikely]] {
+                if (auto const* native_executable = native_executable_if_hot(executable)) {
+                    program_counter = target;
+                    if (run_native_code(*native_executable, program_counter))
+                        return;
+                    goto start;
+                }
+            }
+            program_counter = target;
             goto start;
         }
 
@@ -992,8 +1043,10 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
     }
 
     auto& shape = base_obj->shape();
+    auto const& name = executable.get_identifier(property);
 
-    for (auto& cache_entry : cache.entries) {
+    // Returns the cached value of the property, or an empty Optional if the entry doesn't apply to this object.
+    auto try_cache_entry = [&](PropertyLookupCache::Entry const& cache_entry) -> ThrowCompletionOr<Optional<Value>> {
         if (cache_entry.prototype) {
             // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
             bool can_use_cache = [&]() -> bool {
@@ -1018,33 +1071,38 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
                 return TRY(call(vm, value.as_accessor().getter(), this_value));
             return value;
         }
+        return OptionalNone {};
+    };
+
+    auto& stub_cache = vm.bytecode_interpreter().stub_cache();
+    if (cache.state != PropertyLookupCache::State::Megamorphic) {
+        for (auto& cache_entry : cache.entries) {
+            if (auto value = TRY(try_cache_entry(cache_entry)); value.has_value())
+                return *value;
+        }
+    } else if (auto const* cache_entry = stub_cache.lookup(StubCache::Kind::Get, shape, name)) {
+        if (auto value = TRY(try_cache_entry(*cache_entry)); value.has_value())
+            return *value;
     }
 
     CacheablePropertyMetadata cacheable_metadata;
-    auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
+    auto value = TRY(base_obj->internal_get(name, this_value, &cacheable_metadata));
 
     // If internal_get() caused object's shape change, we can no longer be sure
     // that collected metadata is valid, e.g. if getter in prototype chain added
     // property with the same name into the object itself.
-    if (&shape == &base_obj->shape()) {
-        auto get_cache_slot = [&] -> PropertyLookupCache::Entry& {
-            for (size_t i = cache.entries.size() - 1; i >= 1; --i) {
-                cache.entries[i] = cache.entries[i - 1];
-            }
-            cache.entries[0] = {};
-            return cache.entries[0];
-        };
-        if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            auto& entry = get_cache_slot();
-            entry.shape = shape;
-            entry.property_offset = cacheable_metadata.property_offset.value();
-        } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-            auto& entry = get_cache_slot();
-            entry.shape = &base_obj->shape();
-            entry.property_offset = cacheable_metadata.property_offset.value();
+    if (&shape == &base_obj->shape() && cacheable_metadata.type != CacheablePropertyMetadata::Type::NotCacheable) {
+        PropertyLookupCache::Entry entry;
+        entry.shape = shape;
+        entry.property_offset = cacheable_metadata.property_offset.value();
+        if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
             entry.prototype = *cacheable_metadata.prototype;
             entry.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
         }
+        if (auto* slot = stub_cache.slot_for_new_shape(cache, name))
+            *slot = move(entry);
+        else
+            stub_cache.store(StubCache::Kind::Get, name, move(entry));
     }
 
     return value;
@@ -1234,36 +1292,48 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
     }
     case Op::PropertyKind::KeyValue: {
         auto& shape = object->shape();
-        if (caches) {
-            for (auto& cache : caches->entries) {
-                if (cache.prototype) {
-                    // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-                    bool can_use_cache = [&]() -> bool {
-                        if (&object->shape() != cache.shape)
-                            return false;
-                        if (!cache.prototype_chain_validity)
-                            return false;
-                        if (!cache.prototype_chain_validity->is_valid())
-                            return false;
+
+        // Returns true if the cache entry applied to this object and the property has been set.
+        auto try_cache_entry = [&](PropertyLookupCache::Entry const& cache) -> ThrowCompletionOr<bool> {
+            if (cache.prototype) {
+                // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+                bool can_use_cache = [&]() -> bool {
+                    if (&object->shape() != cache.shape)
+                        return false;
+                    if (!cache.prototype_chain_validity)
+                        return false;
+                    if (!cache.prototype_chain_validity->is_valid())
+                        return false;
+                    return true;
+                }();
+                if (can_use_cache) {
+                    auto value_in_prototype = cache.prototype->get_direct(cache.property_offset.value());
+                    if (value_in_prototype.is_accessor()) {
+                        TRY(call(vm, value_in_prototype.as_accessor().setter(), this_value, value));
                         return true;
-                    }();
-                    if (can_use_cache) {
-                        auto value_in_prototype = cache.prototype->get_direct(cache.property_offset.value());
-                        if (value_in_prototype.is_accessor()) {
-                            TRY(call(vm, value_in_prototype.as_accessor().setter(), this_value, value));
-                            return {};
-                        }
-                    }
-                } else if (cache.shape == &object->shape()) {
-                    auto value_in_object = object->get_direct(cache.property_offset.value());
-                    if (value_in_object.is_accessor()) {
-                        TRY(call(vm, value_in_object.as_accessor().setter(), this_value, value));
-                    } else {
-                        object->put_direct(*cache.property_offset, value);
                     }
-                    return {};
                 }
+            } else if (cache.shape == &object->shape()) {
+                auto value_in_object = object->get_direct(cache.property_offset.value());
+                if (value_in_object.is_accessor()) {
+                    TRY(call(vm, value_in_object.as_accessor().setter(), this_value, value));
+                } else {
+                    object->put_direct(*cache.property_offset, value);
+                }
+                return true;
             }
+            return false;
+        };
+
+        auto& stub_cache = vm.bytecode_interpreter().stub_cache();
+        if (caches && caches->state != PropertyLookupCache::State::Megamorphic) {
+            for (auto& cache : caches->entries) {
+                if (TRY(try_cache_entry(cache)))
+                    return {};
+            }
+        } else if (caches && name.is_string()) {
+            if (auto const* cache = stub_cache.lookup(StubCache::Kind::Put, shape, name.as_string()); cache && TRY(try_cache_entry(*cache)))
+                return {};
         }
 
         CacheablePropertyMetadata cacheable_metadata;
@@ -1272,24 +1342,19 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         // If internal_set() caused object's shape change, we can no longer be sure
         // that collected metadata is valid, e.g. if setter in prototype chain added
         // property with the same name into the object itself.
-        if (succeeded && caches && &shape == &object->shape()) {
-            auto get_cache_slot = [&] -> PropertyLookupCache::Entry& {
-                for (size_t i = caches->entries.size() - 1; i >= 1; --i) {
-                    caches->entries[i] = caches->entries[i - 1];
-                }
-                caches->entries[0] = {};
-                return caches->entries[0];
-            };
-            auto& cache = get_cache_slot();
-            if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-                cache.shape = object->shape();
-                cache.property_offset = cacheable_metadata.property_offset.value();
-            } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-                cache.shape = object->shape();
-                cache.property_offset = cacheable_metadata.property_offset.value();
+        if (succeeded && caches && &shape == &object->shape() && name.is_string()
+            && cacheable_metadata.type != CacheablePropertyMetadata::Type::NotCacheable) {
+            PropertyLookupCache::Entry cache;
+            cache.shape = object->shape();
+            cache.property_offset = cacheable_metadata.property_offset.value();
+            if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
                 cache.prototype = *cacheable_metadata.prototype;
                 cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
             }
+            if (auto* slot = stub_cache.slot_for_new_shape(*caches, name.as_string()))
+                *slot = move(cache);
+            else
+                stub_cache.store(StubCache::Kind::Put, name.as_string(), move(cache));
         }
 
         if (!succeeded && vm.in_strict_mode()) [[unlikely]] {
@@ -9,6 +9,7 @@
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Register.h>
+#include <LibJS/Bytecode/StubCache.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Runtime/FunctionKind.h>
@@ -30,6 +31,8 @@ public:
     VM& vm() { return m_vm; }
     VM const& vm() const { return m_vm; }
 
+    StubCache& stub_cache() { return m_stub_cache; }
+
     ThrowCompletionOr<Value> run(Script&, GC::Ptr<Environment> lexical_environment_override = nullptr);
     ThrowCompletionOr<Value> run(SourceTextModule&);
 
@@ -84,6 +87,10 @@ public:
 
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
+    // Reports the cells referenced by the interpreter itself. Registers and arguments of running code live in the
+    // ExecutionContexts on the VM's execution context stack, which are visited separately.
+    void visit_edges(Cell::Visitor&);
+
 private:
     void run_bytecode(size_t entry_point);
 
@@ -93,6 +100,9 @@ private:
     };
     [[nodiscard]] HandleExceptionResponse handle_exception(size_t& program_counter, Value exception);
 
+    // Returns true if the executable finished running, false if the interpreter should continue at program_counter.
+    [[nodiscard]] bool run_native_code(JIT::NativeExecutable const&, size_t& program_counter);
+
     VM& m_vm;
     Optional<size_t> m_scheduled_jump;
     GC::Ptr<Executable> m_current_executable { nullptr };
@@ -102,6 +112,7 @@ private:
     Span<Value> m_registers_and_constants_and_locals_arguments;
     Vector<Value> m_argument_values_buffer;
     ExecutionContext* m_running_execution_context { nullptr };
+    StubCache m_stub_cache;
 };
 
 JS_API extern bool g_dump_bytecode;
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/HashFunctions.h>
+#include <AK/Traits.h>
 #include <AK/Types.h>
 #include <LibJS/Forward.h>
 
@@ -168,4 +170,10 @@ private:
     JS::Bytecode::Operand m_value { JS::Bytecode::Operand::Type::Invalid, 0 };
 };
 
+template<>
+struct Traits<JS::Bytecode::Operand> : DefaultTraits<JS::Bytecode::Operand> {
+    static unsigned hash(JS::Bytecode::Operand const& operand) { return pair_int_hash(to_underlying(operand.type()), operand.index()); }
+    static constexpr bool is_trivial() { return true; }
+};
+
 }
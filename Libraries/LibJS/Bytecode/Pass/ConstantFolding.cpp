@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode::Passes {
+
+// NOTE: Operations on these values can't throw, call into user code or allocate, so evaluating them ahead of time is
+//       indistinguishable from evaluating them at runtime.
+static Optional<Value> foldable_constant(Generator& generator, Operand const& operand)
+{
+    if (!operand.is_constant())
+        return {};
+    auto value = generator.get_constant(operand);
+    if (value.is_number() || value.is_boolean() || value.is_nullish())
+        return value;
+    return {};
+}
+
+#define JS_ENUMERATE_FOLDABLE_BINARY_OPS(O)     \
+    O(Add, add)                                 \
+    O(BitwiseAnd, bitwise_and)                  \
+    O(BitwiseOr, bitwise_or)                    \
+    O(BitwiseXor, bitwise_xor)                  \
+    O(Div, div)                                 \
+    O(Exp, exp)                                 \
+    O(GreaterThan, greater_than)                \
+    O(GreaterThanEquals, greater_than_equals)   \
+    O(LeftShift, left_shift)                    \
+    O(LessThan, less_than)                      \
+    O(LessThanEquals, less_than_equals)         \
+    O(Mod, mod)                                 \
+    O(Mul, mul)                                 \
+    O(RightShift, right_shift)                  \
+    O(Sub, sub)                                 \
+    O(UnsignedRightShift, unsigned_right_shift)
+
+#define JS_ENUMERATE_FOLDABLE_UNARY_OPS(O) \
+    O(BitwiseNot, bitwise_not)             \
+    O(UnaryMinus, unary_minus)             \
+    O(UnaryPlus, unary_plus)
+
+static Value fold_binary_op(VM& vm, Instruction::Type type, Value lhs, Value rhs)
+{
+    switch (type) {
+#define __JS_FOLD_BINARY_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:                \
+        return Value { MUST(op_snake_case(vm, lhs, rhs)) };
+        JS_ENUMERATE_FOLDABLE_BINARY_OPS(__JS_FOLD_BINARY_OP)
+#undef __JS_FOLD_BINARY_OP
+    case Instruction::Type::LooselyEquals:
+        return Value { MUST(is_loosely_equal(vm, lhs, rhs)) };
+    case Instruction::Type::LooselyInequals:
+        return Value { !MUST(is_loosely_equal(vm, lhs, rhs)) };
+    case Instruction::Type::StrictlyEquals:
+        return Value { is_strictly_equal(lhs, rhs) };
+    case Instruction::Type::StrictlyInequals:
+        return Value { !is_strictly_equal(lhs, rhs) };
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+template<typename OpType>
+static void fold_binary_instruction(Generator& generator, OpType const& instruction, InstructionStreamRewriter& rewriter)
+{
+    auto lhs = foldable_constant(generator, instruction.lhs());
+    auto rhs = foldable_constant(generator, instruction.rhs());
+    if (!lhs.has_value() || !rhs.has_value()) {
+        rewriter.keep();
+        return;
+    }
+    auto result = fold_binary_op(generator.vm(), instruction.type(), *lhs, *rhs);
+    rewriter.replace_with<Op::Mov>(instruction.dst(), generator.add_constant(result));
+}
+
+template<typename OpType>
+static void fold_conditional_jump(OpType const& instruction, Optional<bool> condition, InstructionStreamRewriter& rewriter)
+{
+    if (!condition.has_value()) {
+        rewriter.keep();
+        return;
+    }
+    rewriter.replace_with<Op::Jump>(*condition ? instruction.true_target() : instruction.false_target());
+}
+
+static void fold_instruction(Generator& generator, Instruction& instruction, InstructionStreamRewriter& rewriter)
+{
+    auto& vm = generator.vm();
+
+    switch (instruction.type()) {
+#define __JS_FOLD_BINARY_INSTRUCTION(OpTitleCase, ...) \
+    case Instruction::Type::OpTitleCase:               \
+        return fold_binary_instruction(generator, static_cast<Op::OpTitleCase const&>(instruction), rewriter);
+        JS_ENUMERATE_FOLDABLE_BINARY_OPS(__JS_FOLD_BINARY_INSTRUCTION)
+        __JS_FOLD_BINARY_INSTRUCTION(LooselyEquals)
+        __JS_FOLD_BINARY_INSTRUCTION(LooselyInequals)
+        __JS_FOLD_BINARY_INSTRUCTION(StrictlyEquals)
+        __JS_FOLD_BINARY_INSTRUCTION(StrictlyInequals)
+#undef __JS_FOLD_BINARY_INSTRUCTION
+
+#define __JS_FOLD_UNARY_INSTRUCTION(OpTitleCase, op_snake_case)                                     \
+    case Instruction::Type::OpTitleCase: {                                                          \
+        auto const& unary = static_cast<Op::OpTitleCase const&>(instruction);                       \
+        auto src = foldable_constant(generator, unary.src());                                       \
+        if (!src.has_value())                                                                       \
+            break;                                                                                  \
+        auto result = MUST(op_snake_case(vm, *src));                                                \
+        return rewriter.replace_with<Op::Mov>(unary.dst(), generator.add_constant(result));         \
+    }
+        JS_ENUMERATE_FOLDABLE_UNARY_OPS(__JS_FOLD_UNARY_INSTRUCTION)
+#undef __JS_FOLD_UNARY_INSTRUCTION
+
+    case Instruction::Type::Not: {
+        auto const& not_ = static_cast<Op::Not const&>(instruction);
+        auto src = foldable_constant(generator, not_.src());
+        if (!src.has_value())
+            break;
+        return rewriter.replace_with<Op::Mov>(not_.dst(), generator.add_constant(Value(!src->to_boolean())));
+    }
+
+    case Instruction::Type::JumpIf: {
+        auto const& jump = static_cast<Op::JumpIf const&>(instruction);
+        auto condition = foldable_constant(generator, jump.condition());
+        return fold_conditional_jump(jump, condition.map([](auto value) { return value.to_boolean(); }), rewriter);
+    }
+    case Instruction::Type::JumpNullish: {
+        auto const& jump = static_cast<Op::JumpNullish const&>(instruction);
+        auto condition = foldable_constant(generator, jump.condition());
+        return fold_conditional_jump(jump, condition.map([](auto value) { return value.is_nullish(); }), rewriter);
+    }
+    case Instruction::Type::JumpUndefined: {
+        auto const& jump = static_cast<Op::JumpUndefined const&>(instruction);
+        auto condition = foldable_constant(generator, jump.condition());
+        return fold_conditional_jump(jump, condition.map([](auto value) { return value.is_undefined(); }), rewriter);
+    }
+
+#define __JS_FOLD_COMPARISON_JUMP(op_TitleCase, op_snake_case, numeric_operator)                    \
+    case Instruction::Type::Jump##op_TitleCase: {                                                   \
+        auto const& jump = static_cast<Op::Jump##op_TitleCase const&>(instruction);                 \
+        auto lhs = foldable_constant(generator, jump.lhs());                                        \
+        auto rhs = foldable_constant(generator, jump.rhs());                                        \
+        Optional<bool> condition;                                                                   \
+        if (lhs.has_value() && rhs.has_value())                                                     \
+            condition = fold_binary_op(vm, Instruction::Type::op_TitleCase, *lhs, *rhs).as_bool(); \
+        return fold_conditional_jump(jump, condition, rewriter);                                    \
+    }
+        JS_ENUMERATE_COMPARISON_OPS(__JS_FOLD_COMPARISON_JUMP)
+#undef __JS_FOLD_COMPARISON_JUMP
+
+    default:
+        break;
+    }
+    rewriter.keep();
+}
+
+void ConstantFolding::perform(Generator& generator)
+{
+    for (auto& block : generator.basic_blocks()) {
+        InstructionStreamRewriter::rewrite(*block, [&](Instruction& instruction, InstructionStreamRewriter& rewriter) {
+            fold_instruction(generator, instruction, rewriter);
+        });
+    }
+}
+
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Instructions that write their dst() operand and nothing else. Any other operand is only read, and dst() may be
+// read as well (e.g. Increment).
+#define ENUMERATE_INSTRUCTIONS_WRITING_ONLY_DST(O) \
+    O(Add)                                         \
+    O(BitwiseAnd)                                  \
+    O(BitwiseNot)                                  \
+    O(BitwiseOr)                                   \
+    O(BitwiseXor)                                  \
+    O(Call)                                        \
+    O(CallBuiltin)                                 \
+    O(CallConstruct)                               \
+    O(CallDirectEval)                              \
+    O(CallWithArgumentArray)                       \
+    O(Catch)                                       \
+    O(ConcatString)                                \
+    O(CopyObjectExcludingProperties)               \
+    O(Decrement)                                   \
+    O(DeleteById)                                  \
+    O(DeleteByIdWithThis)                          \
+    O(DeleteByValue)                               \
+    O(DeleteByValueWithThis)                       \
+    O(DeleteVariable)                              \
+    O(Div)                                         \
+    O(Exp)                                         \
+    O(GetBinding)                                  \
+    O(GetById)                                     \
+    O(GetByIdWithThis)                             \
+    O(GetByValue)                                  \
+    O(GetByValueWithThis)                          \
+    O(GetGlobal)                                   \
+    O(GetImportMeta)                               \
+    O(GetInitializedBinding)                       \
+    O(GetIterator)                                 \
+    O(GetLength)                                   \
+    O(GetLengthWithThis)                           \
+    O(GetMethod)                                   \
+    O(GetNewTarget)                                \
+    O(GetObjectPropertyIterator)                   \
+    O(GetPrivateById)                              \
+    O(GreaterThan)                                 \
+    O(GreaterThanEquals)                           \
+    O(HasPrivateId)                                \
+    O(ImportCall)                                  \
+    O(In)                                          \
+    O(Increment)                                   \
+    O(InstanceOf)                                  \
+    O(IteratorNext)                                \
+    O(IteratorToArray)                             \
+    O(LeftShift)                                   \
+    O(LessThan)                                    \
+    O(LessThanEquals)                              \
+    O(LooselyEquals)                               \
+    O(LooselyInequals)                             \
+    O(Mod)                                         \
+    O(Mov)                                         \
+    O(Mul)                                         \
+    O(NewArray)                                    \
+    O(NewClass)                                    \
+    O(NewFunction)                                 \
+    O(NewObject)                                   \
+    O(NewPrimitiveArray)                           \
+    O(NewRegExp)                                   \
+    O(Not)                                         \
+    O(ResolveSuperBase)                            \
+    O(RightShift)                                  \
+    O(StrictlyEquals)                              \
+    O(StrictlyInequals)                            \
+    O(Sub)                                         \
+    O(SuperCallWithArgumentArray)                  \
+    O(Typeof)                                      \
+    O(TypeofBinding)                               \
+    O(UnaryMinus)                                  \
+    O(UnaryPlus)                                   \
+    O(UnsignedRightShift)
+
+// Instructions that only read their operands.
+#define ENUMERATE_INSTRUCTIONS_WRITING_NO_OPERANDS(O) \
+    O(ArrayAppend)                                    \
+    O(AsyncIteratorClose)                             \
+    O(Await)                                          \
+    O(Dump)                                           \
+    O(End)                                            \
+    O(EnterObjectEnvironment)                         \
+    O(InitializeLexicalBinding)                       \
+    O(InitializeVariableBinding)                      \
+    O(IteratorClose)                                  \
+    O(Jump)                                           \
+    O(JumpFalse)                                      \
+    O(JumpGreaterThan)                                \
+    O(JumpGreaterThanEquals)                          \
+    O(JumpIf)                                         \
+    O(JumpLessThan)                                   \
+    O(JumpLessThanEquals)                             \
+    O(JumpLooselyEquals)                              \
+    O(JumpLooselyInequals)                            \
+    O(JumpNullish)                                    \
+    O(JumpStrictlyEquals)                             \
+    O(JumpStrictlyInequals)                           \
+    O(JumpTrue)                                       \
+    O(JumpUndefined)                                  \
+    O(PutById)                                        \
+    O(PutByIdWithThis)                                \
+    O(PutBySpread)                                    \
+    O(PutByValue)                                     \
+    O(PutByValueWithThis)                             \
+    O(PutPrivateById)                                 \
+    O(Return)                                         \
+    O(SetGlobal)                                      \
+    O(SetLexicalBinding)                              \
+    O(SetVariableBinding)                             \
+    O(Throw)                                          \
+    O(ThrowIfNotObject)                               \
+    O(ThrowIfNullish)                                 \
+    O(ThrowIfTDZ)                                     \
+    O(Yield)
+
+enum class WrittenOperands {
+    OnlyDst,
+    None,
+    Unknown,
+};
+
+static WrittenOperands written_operands(Instruction const& instruction, Optional<Operand>& dst)
+{
+    switch (instruction.type()) {
+#define __BYTECODE_OP(op)                                          \
+    case Instruction::Type::op:                                    \
+        dst = static_cast<Op::op const&>(instruction).dst();       \
+        return WrittenOperands::OnlyDst;
+        ENUMERATE_INSTRUCTIONS_WRITING_ONLY_DST(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return WrittenOperands::None;
+        ENUMERATE_INSTRUCTIONS_WRITING_NO_OPERANDS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        return WrittenOperands::Unknown;
+    }
+}
+
+// Temporaries are the only operands we track as copy destinations. The reserved registers (accumulator, exception,
+// etc.) are read and written implicitly by the interpreter, so they can't take part on either side of a copy.
+static bool is_temporary(Operand const& operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+static bool can_be_copy_source(Operand const& operand)
+{
+    // NOTE: Arguments are left alone, since a mapped arguments object may alias them.
+    return operand.is_constant() || operand.is_local() || is_temporary(operand);
+}
+
+static void propagate_copies_in_block(BasicBlock& block)
+{
+    // Maps a temporary to the operand it currently holds a copy of.
+    HashMap<Operand, Operand> copies;
+
+    auto invalidate = [&](Operand const& written) {
+        copies.remove(written);
+        copies.remove_all_matching([&](auto const&, auto const& source) { return source == written; });
+    };
+
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+        auto& instruction = const_cast<Instruction&>(*it);
+
+        Optional<Operand> dst;
+        auto written = written_operands(instruction, dst);
+
+        if (written == WrittenOperands::Unknown) {
+            instruction.visit_operands([&](Operand& operand) { invalidate(operand); });
+            continue;
+        }
+
+        if (!copies.is_empty()) {
+            instruction.visit_operands([&](Operand& operand) {
+                // NOTE: We can't tell which occurrence of the destination is the write, so it's never replaced.
+                if (dst.has_value() && operand == *dst)
+                    return;
+                if (auto source = copies.get(operand); source.has_value())
+                    operand = *source;
+            });
+        }
+
+        if (!dst.has_value())
+            continue;
+
+        invalidate(*dst);
+
+        if (instruction.type() == Instruction::Type::Mov) {
+            auto const& mov = static_cast<Op::Mov const&>(instruction);
+            if (is_temporary(mov.dst()) && can_be_copy_source(mov.src()) && mov.dst() != mov.src())
+                copies.set(mov.dst(), mov.src());
+        }
+    }
+}
+
+static bool remove_dead_movs(Generator& generator)
+{
+    HashMap<Operand, size_t> read_counts;
+    for (auto& block : generator.basic_blocks()) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            if (instruction.type() == Instruction::Type::Mov) {
+                ++read_counts.ensure(static_cast<Op::Mov const&>(instruction).src());
+                continue;
+            }
+            // NOTE: This overcounts operands that are only written, which just means we keep a few more Movs.
+            instruction.visit_operands([&](Operand& operand) { ++read_counts.ensure(operand); });
+        }
+    }
+
+    auto is_removable = [&](Instruction const& instruction) {
+        if (instruction.type() != Instruction::Type::Mov)
+            return false;
+        auto const& mov = static_cast<Op::Mov const&>(instruction);
+        if (mov.dst() == mov.src())
+            return true;
+        return is_temporary(mov.dst()) && read_counts.get(mov.dst()).value_or(0) == 0;
+    };
+
+    bool removed_any = false;
+    for (auto& block : generator.basic_blocks()) {
+        bool has_removable_instruction = false;
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end() && !has_removable_instruction; ++it)
+            has_removable_instruction = is_removable(*it);
+        if (!has_removable_instruction)
+            continue;
+
+        removed_any = true;
+        InstructionStreamRewriter::rewrite(*block, [&](Instruction& instruction, InstructionStreamRewriter& rewriter) {
+            if (!is_removable(instruction))
+                rewriter.keep();
+        });
+    }
+    return removed_any;
+}
+
+void CopyPropagation::perform(Generator& generator)
+{
+    for (auto& block : generator.basic_blocks())
+        propagate_copies_in_block(*block);
+
+    // Removing a Mov can leave its source without readers, so keep going until nothing changes.
+    while (remove_dead_movs(generator)) { }
+}
+
+}
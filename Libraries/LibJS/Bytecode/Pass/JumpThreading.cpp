@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static Optional<Label> jump_target_if_trampoline(BasicBlock const& block)
+{
+    if (!block.is_terminated() || block.size() == 0)
+        return {};
+    auto const& first_instruction = *InstructionStreamIterator(block.instruction_stream());
+    if (first_instruction.type() != Instruction::Type::Jump)
+        return {};
+    return static_cast<Op::Jump const&>(first_instruction).target();
+}
+
+template<typename OpType>
+static void replace_if_both_targets_are_equal(OpType const& jump, InstructionStreamRewriter& rewriter)
+{
+    if (jump.true_target().basic_block_index() == jump.false_target().basic_block_index())
+        rewriter.replace_with<Op::Jump>(jump.true_target());
+    else
+        rewriter.keep();
+}
+
+void JumpThreading::perform(Generator& generator)
+{
+    auto& blocks = generator.basic_blocks();
+
+    // For every block that consists of a single Jump, find where a chain of such blocks finally ends up.
+    Vector<Optional<Label>> trampoline_targets;
+    trampoline_targets.ensure_capacity(blocks.size());
+    for (auto& block : blocks)
+        trampoline_targets.unchecked_append(jump_target_if_trampoline(*block));
+
+    auto resolve = [&](Label label) {
+        // NOTE: Bounded so that a cycle of empty blocks (e.g. `for (;;) {}`) doesn't hang us.
+        for (size_t steps = 0; steps < blocks.size(); ++steps) {
+            auto const& next = trampoline_targets[label.basic_block_index()];
+            if (!next.has_value() || next->basic_block_index() == label.basic_block_index())
+                break;
+            label = *next;
+        }
+        return label;
+    };
+
+    for (auto& block : blocks) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) { label = resolve(label); });
+        }
+    }
+
+    // A conditional jump with two identical targets is just a jump, as evaluating these conditions has no side effects.
+    for (auto& block : blocks) {
+        if (!block->is_terminated())
+            continue;
+        auto const& terminator = *reinterpret_cast<Instruction const*>(block->data() + block->last_instruction_start_offset());
+        auto type = terminator.type();
+        if (type != Instruction::Type::JumpIf && type != Instruction::Type::JumpNullish && type != Instruction::Type::JumpUndefined)
+            continue;
+
+        InstructionStreamRewriter::rewrite(*block, [&](Instruction& instruction, InstructionStreamRewriter& rewriter) {
+            switch (instruction.type()) {
+            case Instruction::Type::JumpIf:
+                return replace_if_both_targets_are_equal(static_cast<Op::JumpIf const&>(instruction), rewriter);
+            case Instruction::Type::JumpNullish:
+                return replace_if_both_targets_are_equal(static_cast<Op::JumpNullish const&>(instruction), rewriter);
+            case Instruction::Type::JumpUndefined:
+                return replace_if_both_targets_are_equal(static_cast<Op::JumpUndefined const&>(instruction), rewriter);
+            default:
+                rewriter.keep();
+            }
+        });
+    }
+}
+
+}
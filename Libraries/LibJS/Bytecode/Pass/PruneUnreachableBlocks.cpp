@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void PruneUnreachableBlocks::perform(Generator& generator)
+{
+    auto& blocks = generator.basic_blocks();
+    if (blocks.is_empty())
+        return;
+
+    // NOTE: Exception handlers and finalizers are entered without an explicit jump, so they count as successors too.
+    Vector<bool> reachable;
+    reachable.resize(blocks.size());
+    Vector<BasicBlock*> worklist;
+
+    auto mark_reachable = [&](BasicBlock const& block) {
+        if (reachable[block.index()])
+            return;
+        reachable[block.index()] = true;
+        worklist.append(blocks[block.index()].ptr());
+    };
+
+    mark_reachable(*blocks.first());
+    while (!worklist.is_empty()) {
+        auto& block = *worklist.take_last();
+        for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) { mark_reachable(*blocks[label.basic_block_index()]); });
+        }
+        if (block.handler())
+            mark_reachable(*block.handler());
+        if (block.finalizer())
+            mark_reachable(*block.finalizer());
+    }
+
+    if (!reachable.contains_slow(false))
+        return;
+
+    Vector<u32> new_indices;
+    new_indices.resize(blocks.size());
+    Vector<NonnullOwnPtr<BasicBlock>> reachable_blocks;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!reachable[i])
+            continue;
+        new_indices[i] = reachable_blocks.size();
+        reachable_blocks.append(move(blocks[i]));
+    }
+
+    for (auto& block : reachable_blocks) {
+        block->set_index(new_indices[block->index()]);
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) { label = Label { new_indices[label.basic_block_index()] }; });
+        }
+    }
+
+    // NOTE: The unreachable blocks are destroyed here, after the reachable ones have been moved out.
+    blocks = move(reachable_blocks);
+}
+
+}
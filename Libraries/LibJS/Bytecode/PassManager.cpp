@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode {
+
+bool g_optimize_bytecode = false;
+
+PassManager& PassManager::default_pipeline()
+{
+    static auto pipeline = [] {
+        PassManager pipeline;
+        pipeline.add<Passes::CopyPropagation>();
+        pipeline.add<Passes::ConstantFolding>();
+        // NOTE: Folding turns instructions into Movs of constants, which can be propagated into their users.
+        pipeline.add<Passes::CopyPropagation>();
+        pipeline.add<Passes::JumpThreading>();
+        pipeline.add<Passes::PruneUnreachableBlocks>();
+        return pipeline;
+    }();
+    return pipeline;
+}
+
+static size_t instruction_count(Generator& generator)
+{
+    size_t count = 0;
+    for (auto& block : generator.basic_blocks()) {
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it)
+            ++count;
+    }
+    return count;
+}
+
+void PassManager::perform(Generator& generator)
+{
+    auto instructions_before = instruction_count(generator);
+    for (auto& entry : m_passes) {
+        auto start_time = MonotonicTime::now();
+        entry.pass->perform(generator);
+        entry.statistics.time += MonotonicTime::now() - start_time;
+
+        auto instructions_after = instruction_count(generator);
+        ++entry.statistics.runs;
+        entry.statistics.instructions_before += instructions_before;
+        entry.statistics.instructions_after += instructions_after;
+        instructions_before = instructions_after;
+    }
+}
+
+Vector<PassManager::PassStatistics> PassManager::statistics() const
+{
+    Vector<PassStatistics> statistics;
+    statistics.ensure_capacity(m_passes.size());
+    for (auto const& entry : m_passes)
+        statistics.unchecked_append(entry.statistics);
+    return statistics;
+}
+
+void PassManager::dump_statistics() const
+{
+    warnln("\033[37;1mBytecode optimization passes\033[0m");
+    for (auto const& entry : m_passes) {
+        auto const& statistics = entry.statistics;
+        auto delta = static_cast<i64>(statistics.instructions_after) - static_cast<i64>(statistics.instructions_before);
+        warnln("    {:24} {:6} runs {:8} us {:10} -> {:10} instructions ({:+})",
+            statistics.name,
+            statistics.runs,
+            statistics.time.to_microseconds(),
+            statistics.instructions_before,
+            statistics.instructions_after,
+            delta);
+    }
+}
+
+void InstructionStreamRewriter::rewrite(BasicBlock& block, Function<void(Instruction&, InstructionStreamRewriter&)> callback)
+{
+    InstructionStreamRewriter rewriter;
+    rewriter.m_buffer.ensure_capacity(block.size());
+
+    for (InstructionStreamIterator it(block.instruction_stream()); !it.at_end();) {
+        auto& instruction = const_cast<Instruction&>(*it);
+        auto offset = it.offset();
+        ++it;
+
+        rewriter.m_action = Action::Remove;
+        rewriter.m_source_record = block.source_map().get(offset);
+        callback(instruction, rewriter);
+
+        if (rewriter.m_action == Action::Keep) {
+            auto slot_offset = rewriter.m_buffer.size();
+            rewriter.m_buffer.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+            if (rewriter.m_source_record.has_value())
+                rewriter.m_source_map.set(slot_offset, *rewriter.m_source_record);
+            continue;
+        }
+
+        Instruction::destroy(instruction);
+    }
+
+    block.set_instruction_stream(move(rewriter.m_buffer), move(rewriter.m_source_map));
+}
+
+}
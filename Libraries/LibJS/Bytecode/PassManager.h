@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Export.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// Whether the optimization pipeline runs on newly generated bytecode. Off by default.
+JS_API extern bool g_optimize_bytecode;
+
+// An optimization pass over the basic blocks of a Generator, run after code generation and before the blocks are
+// linked into an Executable. At that point operands still carry their unshifted register/constant/local indices and
+// labels refer to basic block indices.
+class Pass {
+public:
+    virtual ~Pass() = default;
+
+    virtual StringView name() const = 0;
+    virtual void perform(Generator&) = 0;
+};
+
+class PassManager {
+public:
+    struct PassStatistics {
+        StringView name;
+        u64 runs { 0 };
+        AK::Duration time;
+        u64 instructions_before { 0 };
+        u64 instructions_after { 0 };
+    };
+
+    // The pipeline run by the Generator when g_optimize_bytecode is set. Statistics accumulate over all executables.
+    JS_API static PassManager& default_pipeline();
+
+    template<typename PassType, typename... Args>
+    void add(Args&&... args)
+    {
+        m_passes.append({ make<PassType>(forward<Args>(args)...), {} });
+        m_passes.last().statistics.name = m_passes.last().pass->name();
+    }
+
+    void perform(Generator&);
+
+    JS_API Vector<PassStatistics> statistics() const;
+    JS_API void dump_statistics() const;
+
+private:
+    struct Entry {
+        NonnullOwnPtr<Pass> pass;
+        PassStatistics statistics;
+    };
+    Vector<Entry> m_passes;
+};
+
+// Rebuilds the instruction stream of a block, letting a callback decide what happens to each instruction.
+// Instructions that are neither kept nor replaced are removed.
+class InstructionStreamRewriter {
+public:
+    static void rewrite(BasicBlock&, Function<void(Instruction&, InstructionStreamRewriter&)>);
+
+    void keep() { m_action = Action::Keep; }
+
+    template<typename OpType, typename... Args>
+    requires(!OpType::IsVariableLength)
+    void replace_with(Args&&... args)
+    {
+        VERIFY(m_action == Action::Remove);
+        m_action = Action::Replace;
+        auto slot_offset = m_buffer.size();
+        m_buffer.resize(slot_offset + sizeof(OpType));
+        new (m_buffer.data() + slot_offset) OpType(forward<Args>(args)...);
+        if (m_source_record.has_value())
+            m_source_map.set(slot_offset, *m_source_record);
+    }
+
+private:
+    enum class Action {
+        Remove,
+        Keep,
+        Replace,
+    };
+
+    InstructionStreamRewriter() = default;
+
+    Vector<u8> m_buffer;
+    HashMap<size_t, SourceRecord> m_source_map;
+    Optional<SourceRecord> m_source_record;
+    Action m_action { Action::Remove };
+};
+
+namespace Passes {
+
+// Within each basic block, replaces reads of a register that was last written by a Mov with the Mov's source, then
+// removes Movs whose destination register is never read anywhere.
+class CopyPropagation final : public Pass {
+public:
+    virtual StringView name() const override { return "CopyPropagation"sv; }
+    virtual void perform(Generator&) override;
+};
+
+// Evaluates arithmetic, comparisons and conditional jumps on numeric, boolean and nullish constants.
+class ConstantFolding final : public Pass {
+public:
+    virtual StringView name() const override { return "ConstantFolding"sv; }
+    virtual void perform(Generator&) override;
+};
+
+// Retargets labels that point at blocks consisting of a single Jump, and turns conditional jumps whose targets are
+// identical into plain jumps.
+class JumpThreading final : public Pass {
+public:
+    virtual StringView name() const override { return "JumpThreading"sv; }
+    virtual void perform(Generator&) override;
+};
+
+// Removes blocks that can't be reached from the entry block, and renumbers the remaining ones.
+class PruneUnreachableBlocks final : public Pass {
+public:
+    virtual StringView name() const override { return "PruneUnreachableBlocks"sv; }
+    virtual void perform(Generator&) override;
+};
+
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/StubCache.h>
+#include <LibJS/Runtime/Shape.h>
+
+namespace JS::Bytecode {
+
+PropertyLookupCache::Entry* StubCache::slot_for_new_shape(PropertyLookupCache& cache, FlyString const& name)
+{
+    using State = PropertyLookupCache::State;
+
+    switch (cache.state) {
+    case State::Uninitialized:
+        cache.state = State::Monomorphic;
+        ++m_statistics.monomorphic_sites;
+        break;
+    case State::Monomorphic:
+        cache.state = State::Polymorphic;
+        ++m_statistics.polymorphic_sites;
+        break;
+    case State::Polymorphic:
+        // NOTE: Entries whose shape has been garbage collected are free to reuse, so only a site that would have to
+        //       evict a live shape goes megamorphic.
+        if (!cache.entries.last().shape)
+            break;
+        cache.state = State::Megamorphic;
+        cache.entries = {};
+        ++m_statistics.megamorphic_sites;
+        ++m_statistics.megamorphic_sites_by_property_name.ensure(name, [] { return 0; });
+        return nullptr;
+    case State::Megamorphic:
+        return nullptr;
+    }
+
+    for (size_t i = cache.entries.size() - 1; i >= 1; --i)
+        cache.entries[i] = cache.entries[i - 1];
+    cache.entries[0] = {};
+    return &cache.entries[0];
+}
+
+void StubCache::dump_statistics() const
+{
+    warnln("Property lookup caches: {} monomorphic, {} polymorphic, {} megamorphic sites",
+        m_statistics.monomorphic_sites, m_statistics.polymorphic_sites, m_statistics.megamorphic_sites);
+    warnln("Stub cache: {} hits, {} misses, {} stores", m_statistics.hits, m_statistics.misses, m_statistics.stores);
+
+    if (m_statistics.megamorphic_sites_by_property_name.is_empty())
+        return;
+
+    Vector<FlyString> names;
+    for (auto const& it : m_statistics.megamorphic_sites_by_property_name)
+        names.append(it.key);
+    quick_sort(names, [&](auto const& a, auto const& b) {
+        return m_statistics.megamorphic_sites_by_property_name.get(a).value() > m_statistics.megamorphic_sites_by_property_name.get(b).value();
+    });
+
+    static constexpr size_t max_names_to_print = 20;
+    warnln("Megamorphic sites by property name:");
+    for (size_t i = 0; i < min(names.size(), max_names_to_print); ++i)
+        warnln("    {}: {}", names[i], m_statistics.megamorphic_sites_by_property_name.get(names[i]).value());
+}
+
+}
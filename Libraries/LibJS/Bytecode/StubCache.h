@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Export.h>
+
+namespace JS::Bytecode {
+
+// A VM-wide cache of property lookups keyed by (shape, property name). Property lookup sites that have seen more
+// shapes than they can remember themselves (i.e. megamorphic sites) consult this before doing a full lookup.
+// Like V8's stub cache, this is a direct-mapped table: a colliding store simply replaces the previous entry.
+class StubCache {
+public:
+    // Gets and puts are cached separately, since an entry that's good for reading a property may not be good for
+    // writing it (e.g. a non-writable data property in the prototype chain).
+    enum class Kind : u8 {
+        Get,
+        Put,
+    };
+
+    struct Statistics {
+        u64 monomorphic_sites { 0 };
+        u64 polymorphic_sites { 0 };
+        u64 megamorphic_sites { 0 };
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 stores { 0 };
+        HashMap<FlyString, u64> megamorphic_sites_by_property_name;
+    };
+
+    PropertyLookupCache::Entry const* lookup(Kind kind, Shape const& shape, FlyString const& name)
+    {
+        auto const& slot = m_slots[slot_index(kind, shape, name)];
+        if (slot.entry.shape == &shape && slot.name == name && slot.kind == kind) {
+            ++m_statistics.hits;
+            return &slot.entry;
+        }
+        ++m_statistics.misses;
+        return nullptr;
+    }
+
+    void store(Kind kind, FlyString const& name, PropertyLookupCache::Entry entry)
+    {
+        auto& slot = m_slots[slot_index(kind, *entry.shape, name)];
+        slot.entry = move(entry);
+        slot.name = name;
+        slot.kind = kind;
+        ++m_statistics.stores;
+    }
+
+    // Returns the slot of the site's own cache to remember a newly seen shape in, or nullptr if the site has now seen
+    // too many shapes and should only use this cache from now on.
+    PropertyLookupCache::Entry* slot_for_new_shape(PropertyLookupCache&, FlyString const& name);
+
+    Statistics const& statistics() const { return m_statistics; }
+    JS_API void dump_statistics() const;
+
+private:
+    static constexpr size_t number_of_slots = 2048;
+
+    struct Slot {
+        PropertyLookupCache::Entry entry;
+        FlyString name;
+        Kind kind { Kind::Get };
+    };
+
+    static size_t slot_index(Kind kind, Shape const& shape, FlyString const& name)
+    {
+        return (pair_int_hash(ptr_hash(&shape), name.hash()) + to_underlying(kind)) & (number_of_slots - 1);
+    }
+
+    AK::Array<Slot, number_of_slots> m_slots;
+    Statistics m_statistics;
+};
+
+}
@@ -190,6 +190,7 @@ class ImportStatement;
 class Identifier;
 class Intrinsics;
 class IteratorRecord;
+struct LazyFunctionBody;
 class MemberExpression;
 class MetaProperty;
 class ModuleEnvironment;
@@ -333,4 +334,10 @@ class Register;
 
 }
 
+namespace JIT {
+
+class NativeExecutable;
+
+}
+
 }
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BitCast.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace JS::JIT {
+
+// A minimal x86-64 assembler, covering just the instructions the baseline JIT emits.
+class Assembler {
+public:
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        NotOverflow = 0x1,
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+        Sign = 0x8,
+        NotSign = 0x9,
+        LessThan = 0xc,
+        GreaterThanOrEqual = 0xd,
+        LessThanOrEqual = 0xe,
+        GreaterThan = 0xf,
+    };
+
+    // A memory operand of the form [base + displacement].
+    struct Mem {
+        Reg base;
+        i32 displacement { 0 };
+    };
+
+    struct Label {
+        Optional<size_t> offset_in_instruction_stream;
+        Vector<size_t> jump_slot_offsets_in_instruction_stream;
+
+        void link(Assembler& assembler)
+        {
+            link_to(assembler, assembler.m_output.size());
+        }
+
+        void link_to(Assembler& assembler, size_t offset)
+        {
+            VERIFY(!offset_in_instruction_stream.has_value());
+            offset_in_instruction_stream = offset;
+            for (auto slot_offset : jump_slot_offsets_in_instruction_stream)
+                assembler.patch_jump_slot(slot_offset, offset);
+        }
+
+        void add_jump(Assembler& assembler, size_t slot_offset)
+        {
+            if (offset_in_instruction_stream.has_value())
+                assembler.patch_jump_slot(slot_offset, *offset_in_instruction_stream);
+            else
+                jump_slot_offsets_in_instruction_stream.append(slot_offset);
+        }
+    };
+
+    size_t size() const { return m_output.size(); }
+
+    void mov(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x89);
+        emit_modrm_reg(src, dst);
+    }
+
+    void mov32(Reg dst, Reg src)
+    {
+        emit_rex(false, src, dst);
+        emit8(0x89);
+        emit_modrm_reg(src, dst);
+    }
+
+    void mov(Reg dst, u64 imm)
+    {
+        if (imm <= NumericLimits<u32>::max()) {
+            // NOTE: Writing a 32-bit register clears the upper half of the 64-bit register.
+            emit_rex(false, Reg::RAX, dst);
+            emit8(0xb8 | (to_underlying(dst) & 7));
+            emit32(static_cast<u32>(imm));
+            return;
+        }
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xb8 | (to_underlying(dst) & 7));
+        emit64(imm);
+    }
+
+    void mov(Reg dst, Mem src)
+    {
+        emit_rex(true, dst, src.base);
+        emit8(0x8b);
+        emit_modrm_mem(dst, src);
+    }
+
+    void mov(Mem dst, Reg src)
+    {
+        emit_rex(true, src, dst.base);
+        emit8(0x89);
+        emit_modrm_mem(src, dst);
+    }
+
+    // Stores a sign-extended 32-bit immediate into a 64-bit memory slot.
+    void mov(Mem dst, i32 imm)
+    {
+        emit_rex(true, Reg::RAX, dst.base);
+        emit8(0xc7);
+        emit_modrm_mem(Reg::RAX, dst);
+        emit32(static_cast<u32>(imm));
+    }
+
+    void lea(Reg dst, Mem src)
+    {
+        emit_rex(true, dst, src.base);
+        emit8(0x8d);
+        emit_modrm_mem(dst, src);
+    }
+
+    void add32(Reg dst, Reg src)
+    {
+        emit_rex(false, src, dst);
+        emit8(0x01);
+        emit_modrm_reg(src, dst);
+    }
+
+    void sub32(Reg dst, Reg src)
+    {
+        emit_rex(false, src, dst);
+        emit8(0x29);
+        emit_modrm_reg(src, dst);
+    }
+
+    void and32(Reg dst, u32 imm)
+    {
+        emit_rex(false, Reg::RAX, dst);
+        emit8(0x81);
+        emit_modrm_reg(static_cast<Reg>(4), dst);
+        emit32(imm);
+    }
+
+    void or_(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x09);
+        emit_modrm_reg(src, dst);
+    }
+
+    void shr(Reg dst, u8 amount)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xc1);
+        emit_modrm_reg(static_cast<Reg>(5), dst);
+        emit8(amount);
+    }
+
+    void cmp(Reg lhs, Reg rhs)
+    {
+        emit_rex(true, rhs, lhs);
+        emit8(0x39);
+        emit_modrm_reg(rhs, lhs);
+    }
+
+    void cmp32(Reg lhs, Reg rhs)
+    {
+        emit_rex(false, rhs, lhs);
+        emit8(0x39);
+        emit_modrm_reg(rhs, lhs);
+    }
+
+    void cmp32(Reg lhs, u32 imm)
+    {
+        emit_rex(false, Reg::RAX, lhs);
+        emit8(0x81);
+        emit_modrm_reg(static_cast<Reg>(7), lhs);
+        emit32(imm);
+    }
+
+    void test32(Reg lhs, Reg rhs)
+    {
+        emit_rex(false, rhs, lhs);
+        emit8(0x85);
+        emit_modrm_reg(rhs, lhs);
+    }
+
+    void test8(Reg lhs, Reg rhs)
+    {
+        // NOTE: Only the legacy byte registers are supported, since SPL/BPL/SIL/DIL would need a REX prefix.
+        VERIFY(to_underlying(lhs) < 4 && to_underlying(rhs) < 4);
+        emit8(0x84);
+        emit_modrm_reg(rhs, lhs);
+    }
+
+    // Sets dst to 0 or 1 depending on the condition, zeroing the rest of the 64-bit register.
+    void set_if(Condition condition, Reg dst)
+    {
+        VERIFY(to_underlying(dst) < 4);
+        emit8(0x0f);
+        emit8(0x90 | to_underlying(condition));
+        emit_modrm_reg(Reg::RAX, dst);
+        // movzx dst32, dst8
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm_reg(dst, dst);
+    }
+
+    void push(Reg reg)
+    {
+        if (to_underlying(reg) >= 8)
+            emit8(0x41);
+        emit8(0x50 | (to_underlying(reg) & 7));
+    }
+
+    void pop(Reg reg)
+    {
+        if (to_underlying(reg) >= 8)
+            emit8(0x41);
+        emit8(0x58 | (to_underlying(reg) & 7));
+    }
+
+    void call(Reg target)
+    {
+        emit_rex(false, Reg::RAX, target);
+        emit8(0xff);
+        emit_modrm_reg(static_cast<Reg>(2), target);
+    }
+
+    void jump(Reg target)
+    {
+        emit_rex(false, Reg::RAX, target);
+        emit8(0xff);
+        emit_modrm_reg(static_cast<Reg>(4), target);
+    }
+
+    void jump(Label& label)
+    {
+        emit8(0xe9);
+        emit_jump_slot(label);
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        emit_jump_slot(label);
+    }
+
+    void ret()
+    {
+        emit8(0xc3);
+    }
+
+    void trap()
+    {
+        // ud2
+        emit8(0x0f);
+        emit8(0x0b);
+    }
+
+    // Calls a C++ function through RAX, the caller is responsible for setting up the arguments.
+    void native_call(void* function)
+    {
+        mov(Reg::RAX, bit_cast<u64>(function));
+        call(Reg::RAX);
+    }
+
+private:
+    void emit8(u8 value) { m_output.append(value); }
+
+    void emit32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    void emit64(u64 value)
+    {
+        for (size_t i = 0; i < 8; ++i)
+            emit8(static_cast<u8>(value >> (i * 8)));
+    }
+
+    void emit_rex(bool is_64_bit, Reg reg, Reg rm)
+    {
+        u8 rex = 0x40;
+        if (is_64_bit)
+            rex |= 0x08;
+        if (to_underlying(reg) >= 8)
+            rex |= 0x04;
+        if (to_underlying(rm) >= 8)
+            rex |= 0x01;
+        if (rex != 0x40)
+            emit8(rex);
+    }
+
+    void emit_modrm_reg(Reg reg, Reg rm)
+    {
+        emit8(0xc0 | ((to_underlying(reg) & 7) << 3) | (to_underlying(rm) & 7));
+    }
+
+    void emit_modrm_mem(Reg reg, Mem mem)
+    {
+        // NOTE: We always use a 32-bit displacement, which sidesteps the special cases for RBP and R13 as base.
+        emit8(0x80 | ((to_underlying(reg) & 7) << 3) | (to_underlying(mem.base) & 7));
+        if ((to_underlying(mem.base) & 7) == to_underlying(Reg::RSP))
+            emit8(0x24);
+        emit32(static_cast<u32>(mem.displacement));
+    }
+
+    void emit_jump_slot(Label& label)
+    {
+        auto slot_offset = m_output.size();
+        emit32(0);
+        label.add_jump(*this, slot_offset);
+    }
+
+    void patch_jump_slot(size_t slot_offset, size_t target_offset)
+    {
+        auto relative_offset = static_cast<i32>(static_cast<i64>(target_offset) - static_cast<i64>(slot_offset + 4));
+        for (size_t i = 0; i < 4; ++i)
+            m_output[slot_offset + i] = static_cast<u8>(static_cast<u32>(relative_offset) >> (i * 8));
+    }
+
+    Vector<u8>& m_output;
+};
+
+}
@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::JIT {
+
+bool g_enabled = false;
+u32 g_compile_threshold = 100;
+
+using Reg = Assembler::Reg;
+using Mem = Assembler::Mem;
+using Condition = Assembler::Condition;
+
+// Registers that hold the same value for the whole lifetime of the native code. These are all callee-saved.
+static constexpr Reg REGISTERS_BASE = Reg::RBX;
+static constexpr Reg INTERPRETER = Reg::R12;
+static constexpr Reg PROGRAM_COUNTER = Reg::R13;
+
+// Argument registers, per the System V calling convention.
+static constexpr Reg ARG0 = Reg::RDI;
+static constexpr Reg ARG1 = Reg::RSI;
+static constexpr Reg ARG2 = Reg::RDX;
+
+static constexpr Reg RETURN_VALUE = Reg::RAX;
+
+static constexpr Reg GPR0 = Reg::RAX;
+static constexpr Reg GPR1 = Reg::RDX;
+static constexpr Reg SCRATCH = Reg::RCX;
+
+template<typename OpType>
+static bool cxx_execute(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+        return false;
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error()) [[unlikely]] {
+            interpreter.reg(Bytecode::Register::exception()) = result.error_value();
+            return true;
+        }
+        return false;
+    }
+}
+
+static bool cxx_to_boolean(Value const& value)
+{
+    return value.to_boolean();
+}
+
+static ThrowCompletionOr<bool> loosely_equals(VM& vm, Value lhs, Value rhs)
+{
+    return is_loosely_equal(vm, lhs, rhs);
+}
+
+static ThrowCompletionOr<bool> loosely_inequals(VM& vm, Value lhs, Value rhs)
+{
+    return !TRY(is_loosely_equal(vm, lhs, rhs));
+}
+
+static ThrowCompletionOr<bool> strict_equals(VM&, Value lhs, Value rhs)
+{
+    return is_strictly_equal(lhs, rhs);
+}
+
+static ThrowCompletionOr<bool> strict_inequals(VM&, Value lhs, Value rhs)
+{
+    return !is_strictly_equal(lhs, rhs);
+}
+
+// Returns 1 if the jump should be taken, 0 if not, and -1 if the comparison threw.
+#define JS_DEFINE_CXX_COMPARISON_JUMP(op_TitleCase, op_snake_case, numeric_operator)                        \
+    static int cxx_jump_##op_snake_case(Bytecode::Interpreter& interpreter, Value const& lhs, Value const& rhs) \
+    {                                                                                                         \
+        auto result = op_snake_case(interpreter.vm(), lhs, rhs);                                              \
+        if (result.is_error()) [[unlikely]] {                                                                 \
+            interpreter.reg(Bytecode::Register::exception()) = result.error_value();                          \
+            return -1;                                                                                        \
+        }                                                                                                     \
+        return result.value() ? 1 : 0;                                                                        \
+    }
+JS_ENUMERATE_COMPARISON_OPS(JS_DEFINE_CXX_COMPARISON_JUMP)
+#undef JS_DEFINE_CXX_COMPARISON_JUMP
+
+Mem Compiler::operand_address(Bytecode::Operand operand) const
+{
+    return Mem { REGISTERS_BASE, static_cast<i32>(operand.index() * sizeof(Value)) };
+}
+
+void Compiler::load_operand(Reg dst, Bytecode::Operand operand)
+{
+    m_assembler.mov(dst, operand_address(operand));
+}
+
+void Compiler::store_operand(Bytecode::Operand operand, Reg src)
+{
+    m_assembler.mov(operand_address(operand), src);
+}
+
+void Compiler::branch_if_not_int32(Reg value, Reg scratch, Assembler::Label& label)
+{
+    m_assembler.mov(scratch, value);
+    m_assembler.shr(scratch, GC::TAG_SHIFT);
+    m_assembler.cmp32(scratch, INT32_TAG);
+    m_assembler.jump_if(Condition::NotEqual, label);
+}
+
+// Anything that may throw or call into JavaScript needs an up-to-date program counter for source positions in
+// stack traces, and for the interpreter to know where to continue if we leave the native code.
+void Compiler::store_program_counter()
+{
+    m_assembler.mov(Mem { PROGRAM_COUNTER, 0 }, static_cast<i32>(m_program_counter));
+}
+
+void Compiler::exit(NativeExecutable::Result result)
+{
+    m_assembler.mov(RETURN_VALUE, to_underlying(result));
+    m_assembler.jump(m_exit);
+}
+
+Assembler::Label& Compiler::label_for(Bytecode::Label const& label)
+{
+    auto it = m_basic_block_labels.find(label.address());
+    if (it == m_basic_block_labels.end()) {
+        // Every jump target should be the start of a basic block, but if it's not we can't compile this executable.
+        dbgln_if(JS_JIT_DEBUG, "JIT: Jump target {} is not the start of a basic block", label.address());
+        m_failed = true;
+        return m_exit;
+    }
+    return *it->value;
+}
+
+template<typename OpType>
+void Compiler::compile_instruction(OpType const& instruction)
+{
+    store_program_counter();
+    m_assembler.mov(ARG0, INTERPRETER);
+    m_assembler.mov(ARG1, bit_cast<u64>(&instruction));
+    m_assembler.native_call(reinterpret_cast<void*>(&cxx_execute<OpType>));
+    if constexpr (!IsSame<decltype(instruction.execute_impl(declval<Bytecode::Interpreter&>())), void>) {
+        m_assembler.test8(RETURN_VALUE, RETURN_VALUE);
+        m_assembler.jump_if(Condition::NotEqual, m_exception_exit);
+    }
+}
+
+void Compiler::compile_instruction(Bytecode::Op::Mov const& instruction)
+{
+    load_operand(GPR0, instruction.src());
+    store_operand(instruction.dst(), GPR0);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::End const& instruction)
+{
+    load_operand(GPR0, instruction.value());
+    store_operand(Bytecode::Operand(Bytecode::Register::accumulator()), GPR0);
+    store_program_counter();
+    exit(NativeExecutable::Result::Finished);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::Jump const& instruction)
+{
+    m_assembler.jump(label_for(instruction.target()));
+}
+
+void Compiler::compile_truthiness_branch(Bytecode::Operand condition, Assembler::Label& if_true, Assembler::Label& if_false)
+{
+    load_operand(GPR0, condition);
+
+    // OPTIMIZATION: Conditions are usually the result of a comparison, so check for booleans first.
+    m_assembler.mov(SCRATCH, Value(true).encoded());
+    m_assembler.cmp(GPR0, SCRATCH);
+    m_assembler.jump_if(Condition::Equal, if_true);
+    m_assembler.mov(SCRATCH, Value(false).encoded());
+    m_assembler.cmp(GPR0, SCRATCH);
+    m_assembler.jump_if(Condition::Equal, if_false);
+
+    m_assembler.lea(ARG0, operand_address(condition));
+    m_assembler.native_call(reinterpret_cast<void*>(&cxx_to_boolean));
+    m_assembler.test8(RETURN_VALUE, RETURN_VALUE);
+    m_assembler.jump_if(Condition::NotEqual, if_true);
+    m_assembler.jump(if_false);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::JumpIf const& instruction)
+{
+    compile_truthiness_branch(instruction.condition(), label_for(instruction.true_target()), label_for(instruction.false_target()));
+}
+
+void Compiler::compile_instruction(Bytecode::Op::JumpTrue const& instruction)
+{
+    Assembler::Label fallthrough;
+    compile_truthiness_branch(instruction.condition(), label_for(instruction.target()), fallthrough);
+    fallthrough.link(m_assembler);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::JumpFalse const& instruction)
+{
+    Assembler::Label fallthrough;
+    compile_truthiness_branch(instruction.condition(), fallthrough, label_for(instruction.target()));
+    fallthrough.link(m_assembler);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::JumpNullish const& instruction)
+{
+    load_operand(GPR0, instruction.condition());
+    m_assembler.shr(GPR0, GC::TAG_SHIFT);
+    m_assembler.and32(GPR0, IS_NULLISH_EXTRACT_PATTERN);
+    m_assembler.cmp32(GPR0, IS_NULLISH_PATTERN);
+    m_assembler.jump_if(Condition::Equal, label_for(instruction.true_target()));
+    m_assembler.jump(label_for(instruction.false_target()));
+}
+
+void Compiler::compile_instruction(Bytecode::Op::JumpUndefined const& instruction)
+{
+    load_operand(GPR0, instruction.condition());
+    m_assembler.mov(SCRATCH, js_undefined().encoded());
+    m_assembler.cmp(GPR0, SCRATCH);
+    m_assembler.jump_if(Condition::Equal, label_for(instruction.true_target()));
+    m_assembler.jump(label_for(instruction.false_target()));
+}
+
+void Compiler::compile_instruction(Bytecode::Op::Add const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_operand(GPR0, instruction.lhs());
+    load_operand(GPR1, instruction.rhs());
+    branch_if_not_int32(GPR0, SCRATCH, slow_case);
+    branch_if_not_int32(GPR1, SCRATCH, slow_case);
+
+    // NOTE: The 32-bit add leaves the upper half of SCRATCH cleared, so it can be tagged directly.
+    m_assembler.mov32(SCRATCH, GPR0);
+    m_assembler.add32(SCRATCH, GPR1);
+    m_assembler.jump_if(Condition::Overflow, slow_case);
+    m_assembler.mov(GPR0, SHIFTED_INT32_TAG);
+    m_assembler.or_(GPR0, SCRATCH);
+    store_operand(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_instruction<Bytecode::Op::Add>(instruction);
+    done.link(m_assembler);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::Sub const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_operand(GPR0, instruction.lhs());
+    load_operand(GPR1, instruction.rhs());
+    branch_if_not_int32(GPR0, SCRATCH, slow_case);
+    branch_if_not_int32(GPR1, SCRATCH, slow_case);
+
+    m_assembler.mov32(SCRATCH, GPR0);
+    m_assembler.sub32(SCRATCH, GPR1);
+    m_assembler.jump_if(Condition::Overflow, slow_case);
+    m_assembler.mov(GPR0, SHIFTED_INT32_TAG);
+    m_assembler.or_(GPR0, SCRATCH);
+    store_operand(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_instruction<Bytecode::Op::Sub>(instruction);
+    done.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison(OpType const& instruction, Condition condition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_operand(GPR0, instruction.lhs());
+    load_operand(GPR1, instruction.rhs());
+    branch_if_not_int32(GPR0, SCRATCH, slow_case);
+    branch_if_not_int32(GPR1, SCRATCH, slow_case);
+
+    m_assembler.cmp32(GPR0, GPR1);
+    m_assembler.set_if(condition, SCRATCH);
+    m_assembler.mov(GPR0, SHIFTED_BOOLEAN_TAG);
+    m_assembler.or_(GPR0, SCRATCH);
+    store_operand(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_instruction<OpType>(instruction);
+    done.link(m_assembler);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::LessThan const& instruction)
+{
+    compile_int32_comparison(instruction, Condition::LessThan);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::LessThanEquals const& instruction)
+{
+    compile_int32_comparison(instruction, Condition::LessThanOrEqual);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::GreaterThan const& instruction)
+{
+    compile_int32_comparison(instruction, Condition::GreaterThan);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::GreaterThanEquals const& instruction)
+{
+    compile_int32_comparison(instruction, Condition::GreaterThanOrEqual);
+}
+
+template<typename OpType>
+void Compiler::compile_comparison_jump(OpType const& instruction, Condition condition, void* slow_path)
+{
+    auto& if_true = label_for(instruction.true_target());
+    auto& if_false = label_for(instruction.false_target());
+    Assembler::Label slow_case;
+
+    load_operand(GPR0, instruction.lhs());
+    load_operand(GPR1, instruction.rhs());
+    branch_if_not_int32(GPR0, SCRATCH, slow_case);
+    branch_if_not_int32(GPR1, SCRATCH, slow_case);
+
+    m_assembler.cmp32(GPR0, GPR1);
+    m_assembler.jump_if(condition, if_true);
+    m_assembler.jump(if_false);
+
+    slow_case.link(m_assembler);
+    store_program_counter();
+    m_assembler.mov(ARG0, INTERPRETER);
+    m_assembler.lea(ARG1, operand_address(instruction.lhs()));
+    m_assembler.lea(ARG2, operand_address(instruction.rhs()));
+    m_assembler.native_call(slow_path);
+    m_assembler.test32(RETURN_VALUE, RETURN_VALUE);
+    m_assembler.jump_if(Condition::Sign, m_exception_exit);
+    m_assembler.jump_if(Condition::NotEqual, if_true);
+    m_assembler.jump(if_false);
+}
+
+static constexpr Condition condition_for_comparison(StringView numeric_operator)
+{
+    if (numeric_operator == "<"sv)
+        return Condition::LessThan;
+    if (numeric_operator == "<="sv)
+        return Condition::LessThanOrEqual;
+    if (numeric_operator == ">"sv)
+        return Condition::GreaterThan;
+    if (numeric_operator == ">="sv)
+        return Condition::GreaterThanOrEqual;
+    if (numeric_operator == "=="sv)
+        return Condition::Equal;
+    VERIFY(numeric_operator == "!="sv);
+    return Condition::NotEqual;
+}
+
+#define JS_DEFINE_COMPILE_COMPARISON_JUMP(op_TitleCase, op_snake_case, numeric_operator)                                   \
+    void Compiler::compile_instruction(Bytecode::Op::Jump##op_TitleCase const& instruction)                                \
+    {                                                                                                                      \
+        compile_comparison_jump(instruction, condition_for_comparison(#numeric_operator ""sv), reinterpret_cast<void*>(&cxx_jump_##op_snake_case)); \
+    }
+JS_ENUMERATE_COMPARISON_OPS(JS_DEFINE_COMPILE_COMPARISON_JUMP)
+#undef JS_DEFINE_COMPILE_COMPARISON_JUMP
+
+void Compiler::compile_instruction(Bytecode::Op::Return const& instruction)
+{
+    compile_instruction<Bytecode::Op::Return>(instruction);
+    exit(NativeExecutable::Result::Finished);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::Yield const& instruction)
+{
+    compile_instruction<Bytecode::Op::Yield>(instruction);
+    exit(NativeExecutable::Result::Finished);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::Await const& instruction)
+{
+    compile_instruction<Bytecode::Op::Await>(instruction);
+    exit(NativeExecutable::Result::Finished);
+}
+
+// The unwind machinery for try/finally lives in the interpreter loop, so we hand control back to it.
+void Compiler::compile_instruction(Bytecode::Op::EnterUnwindContext const&)
+{
+    store_program_counter();
+    exit(NativeExecutable::Result::Bailout);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::ContinuePendingUnwind const&)
+{
+    store_program_counter();
+    exit(NativeExecutable::Result::Bailout);
+}
+
+void Compiler::compile_instruction(Bytecode::Op::ScheduleJump const&)
+{
+    store_program_counter();
+    exit(NativeExecutable::Result::Bailout);
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& executable)
+{
+#if JS_HAS_BASELINE_JIT
+    Compiler compiler { executable };
+    return compiler.compile_executable();
+#else
+    (void)executable;
+    return nullptr;
+#endif
+}
+
+OwnPtr<NativeExecutable> Compiler::compile_executable()
+{
+    // The program counter is stored as a sign-extended 32-bit immediate, and operands are addressed with 32-bit displacements.
+    if (m_executable.bytecode.size() > static_cast<size_t>(NumericLimits<i32>::max()))
+        return nullptr;
+    auto register_file_size = m_executable.number_of_registers + m_executable.constants.size() + m_executable.local_variable_names.size();
+    if (register_file_size * sizeof(Value) > static_cast<size_t>(NumericLimits<i32>::max()) / 2)
+        return nullptr;
+
+    for (auto offset : m_executable.basic_block_start_offsets)
+        m_basic_block_labels.set(offset, make<Assembler::Label>());
+
+    // Entry point: (Interpreter*, Value* registers_and_constants_and_locals_and_arguments, size_t* program_counter, void* entry)
+    m_assembler.push(Reg::RBP);
+    m_assembler.mov(Reg::RBP, Reg::RSP);
+    m_assembler.push(REGISTERS_BASE);
+    m_assembler.push(INTERPRETER);
+    m_assembler.push(PROGRAM_COUNTER);
+    // NOTE: This keeps the stack 16-byte aligned for calls.
+    m_assembler.push(Reg::R14);
+    m_assembler.mov(INTERPRETER, ARG0);
+    m_assembler.mov(REGISTERS_BASE, ARG1);
+    m_assembler.mov(PROGRAM_COUNTER, ARG2);
+    m_assembler.jump(Reg::RCX);
+
+    for (Bytecode::InstructionStreamIterator it(m_executable.bytecode); !it.at_end(); ++it) {
+        m_program_counter = it.offset();
+        if (auto label = m_basic_block_labels.find(m_program_counter); label != m_basic_block_labels.end()) {
+            label->value->link(m_assembler);
+            m_native_offsets_of_basic_blocks.set(m_program_counter, m_assembler.size());
+        }
+
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+#define CASE_BYTECODE_OP(name)                                                    \
+    case Bytecode::Instruction::Type::name:                                       \
+        compile_instruction(static_cast<Bytecode::Op::name const&>(instruction)); \
+        break;
+            ENUMERATE_BYTECODE_OPS(CASE_BYTECODE_OP)
+#undef CASE_BYTECODE_OP
+        default:
+            VERIFY_NOT_REACHED();
+        }
+
+        if (m_failed)
+            return nullptr;
+    }
+
+    // The last basic block always ends in a terminator, so this is never reached.
+    m_assembler.trap();
+
+    m_exception_exit.link(m_assembler);
+    m_assembler.mov(RETURN_VALUE, to_underlying(NativeExecutable::Result::Exception));
+
+    m_exit.link(m_assembler);
+    m_assembler.pop(Reg::R14);
+    m_assembler.pop(PROGRAM_COUNTER);
+    m_assembler.pop(INTERPRETER);
+    m_assembler.pop(REGISTERS_BASE);
+    m_assembler.pop(Reg::RBP);
+    m_assembler.ret();
+
+    dbgln_if(JS_JIT_DEBUG, "JIT: Compiled {} ({} bytes of bytecode) to {} bytes of machine code", m_executable.name, m_executable.bytecode.size(), m_output.size());
+
+    return NativeExecutable::create(m_output, move(m_native_offsets_of_basic_blocks));
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Export.h>
+#include <LibJS/JIT/Assembler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// Whether hot executables are compiled to machine code. Off by default.
+JS_API extern bool g_enabled;
+
+// How many times an executable has to be entered or jump backwards before it's compiled.
+JS_API extern u32 g_compile_threshold;
+
+// The baseline JIT translates bytecode to machine code one instruction at a time, keeping all values in the
+// ExecutionContext's register file exactly like the interpreter does. Int32 fast paths for arithmetic, comparisons
+// and conditional jumps are emitted inline, everything else calls into the same C++ code the interpreter runs.
+// Control returns to the interpreter whenever an instruction throws, or an instruction that manipulates the
+// unwind state (try/finally) is reached.
+class Compiler {
+public:
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+private:
+    explicit Compiler(Bytecode::Executable& executable)
+        : m_executable(executable)
+        , m_assembler(m_output)
+    {
+    }
+
+    OwnPtr<NativeExecutable> compile_executable();
+
+    template<typename OpType>
+    void compile_instruction(OpType const&);
+
+    void compile_instruction(Bytecode::Op::Mov const&);
+    void compile_instruction(Bytecode::Op::End const&);
+    void compile_instruction(Bytecode::Op::Jump const&);
+    void compile_instruction(Bytecode::Op::JumpIf const&);
+    void compile_instruction(Bytecode::Op::JumpTrue const&);
+    void compile_instruction(Bytecode::Op::JumpFalse const&);
+    void compile_instruction(Bytecode::Op::JumpNullish const&);
+    void compile_instruction(Bytecode::Op::JumpUndefined const&);
+    void compile_instruction(Bytecode::Op::Add const&);
+    void compile_instruction(Bytecode::Op::Sub const&);
+    void compile_instruction(Bytecode::Op::LessThan const&);
+    void compile_instruction(Bytecode::Op::LessThanEquals const&);
+    void compile_instruction(Bytecode::Op::GreaterThan const&);
+    void compile_instruction(Bytecode::Op::GreaterThanEquals const&);
+    void compile_instruction(Bytecode::Op::Return const&);
+    void compile_instruction(Bytecode::Op::Yield const&);
+    void compile_instruction(Bytecode::Op::Await const&);
+    void compile_instruction(Bytecode::Op::EnterUnwindContext const&);
+    void compile_instruction(Bytecode::Op::ContinuePendingUnwind const&);
+    void compile_instruction(Bytecode::Op::ScheduleJump const&);
+
+#define JS_DECLARE_COMPILE_COMPARISON_JUMP(op_TitleCase, op_snake_case, numeric_operator) \
+    void compile_instruction(Bytecode::Op::Jump##op_TitleCase const&);
+    JS_ENUMERATE_COMPARISON_OPS(JS_DECLARE_COMPILE_COMPARISON_JUMP)
+#undef JS_DECLARE_COMPILE_COMPARISON_JUMP
+
+    template<typename OpType>
+    void compile_int32_comparison(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_comparison_jump(OpType const&, Assembler::Condition, void* slow_path);
+    void compile_truthiness_branch(Bytecode::Operand, Assembler::Label& if_true, Assembler::Label& if_false);
+
+    void load_operand(Assembler::Reg, Bytecode::Operand);
+    void store_operand(Bytecode::Operand, Assembler::Reg);
+    Assembler::Mem operand_address(Bytecode::Operand) const;
+    void branch_if_not_int32(Assembler::Reg value, Assembler::Reg scratch, Assembler::Label&);
+    void store_program_counter();
+    void exit(NativeExecutable::Result);
+
+    Assembler::Label& label_for(Bytecode::Label const&);
+
+    Bytecode::Executable& m_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+
+    HashMap<size_t, NonnullOwnPtr<Assembler::Label>> m_basic_block_labels;
+    HashMap<size_t, size_t> m_native_offsets_of_basic_blocks;
+    Assembler::Label m_exit;
+    Assembler::Label m_exception_exit;
+
+    size_t m_program_counter { 0 };
+    bool m_failed { false };
+};
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+#if JS_HAS_BASELINE_JIT
+#    include <sys/mman.h>
+#endif
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::create([[maybe_unused]] ReadonlyBytes code, [[maybe_unused]] HashMap<size_t, size_t> native_offsets_of_basic_blocks)
+{
+#if JS_HAS_BASELINE_JIT
+    // The code is written while the mapping is writable, and only then made executable, so it's never both at once.
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("mmap");
+        return nullptr;
+    }
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        perror("mprotect");
+        munmap(memory, code.size());
+        return nullptr;
+    }
+    return adopt_own(*new NativeExecutable(memory, code.size(), move(native_offsets_of_basic_blocks)));
+#else
+    return nullptr;
+#endif
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t code_size, HashMap<size_t, size_t> native_offsets_of_basic_blocks)
+    : m_code(code)
+    , m_code_size(code_size)
+    , m_native_offsets_of_basic_blocks(move(native_offsets_of_basic_blocks))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+#if JS_HAS_BASELINE_JIT
+    if (munmap(m_code, m_code_size) < 0)
+        perror("munmap");
+#endif
+}
+
+NativeExecutable::Result NativeExecutable::run(Bytecode::Interpreter& interpreter, Value* registers_and_constants_and_locals_and_arguments, size_t& program_counter) const
+{
+    auto native_offset = m_native_offsets_of_basic_blocks.get(program_counter);
+    if (!native_offset.has_value())
+        return Result::Bailout;
+
+    using EntryFunction = Result (*)(Bytecode::Interpreter*, Value*, size_t*, void* entry);
+    auto entry_function = reinterpret_cast<EntryFunction>(m_code);
+    return entry_function(&interpreter, registers_and_constants_and_locals_and_arguments, &program_counter, static_cast<u8*>(m_code) + native_offset.value());
+}
+
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Platform.h>
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+// The baseline JIT emits x86-64 machine code for the System V calling convention.
+#if ARCH(X86_64) && !defined(AK_OS_WINDOWS)
+#    define JS_HAS_BASELINE_JIT 1
+#else
+#    define JS_HAS_BASELINE_JIT 0
+#endif
+
+namespace JS::JIT {
+
+// Machine code generated by the baseline JIT for a single Bytecode::Executable.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    enum class Result : u32 {
+        // The executable returned, yielded or awaited. This is the equivalent of the interpreter returning from run_bytecode().
+        Finished,
+        // An instruction threw, the exception has been stored in the exception register and the program counter points at
+        // the throwing instruction.
+        Exception,
+        // The native code reached an instruction it doesn't handle, the interpreter must continue at the program counter.
+        Bailout,
+    };
+
+    static OwnPtr<NativeExecutable> create(ReadonlyBytes code, HashMap<size_t, size_t> native_offsets_of_basic_blocks);
+    ~NativeExecutable();
+
+    // Runs the native code from the basic block at program_counter, which is updated to the current bytecode offset
+    // whenever control returns to C++.
+    Result run(Bytecode::Interpreter&, Value* registers_and_constants_and_locals_and_arguments, size_t& program_counter) const;
+
+    size_t code_size() const { return m_code_size; }
+
+private:
+    NativeExecutable(void* code, size_t code_size, HashMap<size_t, size_t> native_offsets_of_basic_blocks);
+
+    void* m_code { nullptr };
+    size_t m_code_size { 0 };
+    HashMap<size_t, size_t> m_native_offsets_of_basic_blocks;
+};
+
+}
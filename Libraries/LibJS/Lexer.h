@@ -17,13 +17,16 @@ namespace JS {
 
 class Lexer {
 public:
-    explicit Lexer(StringView source, StringView filename = "(unknown)"sv, size_t line_number = 1, size_t line_column = 0);
+    explicit Lexer(StringView source, StringView filename = "(unknown)"sv, size_t line_number = 1, size_t line_column = 0, size_t source_offset = 0);
 
     Token next();
 
     ByteString const& source() const { return m_source; }
     String const& filename() const { return m_filename; }
 
+    // When lexing a slice of a larger source, token offsets are relative to the start of the larger source.
+    size_t source_offset() const { return m_source_offset; }
+
     void disallow_html_comments() { m_allow_html_comments = false; }
 
     Token force_slash_as_regex();
@@ -59,6 +62,7 @@ private:
     TokenType consume_regex_literal();
 
     ByteString m_source;
+    size_t m_source_offset { 0 };
     size_t m_position { 0 };
     Token m_current_token;
     char m_current_char { 0 };
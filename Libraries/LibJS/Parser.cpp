@@ -21,6 +21,27 @@
 
 namespace JS {
 
+bool g_lazy_function_parsing = false;
+
+static LazyFunctionParsingStatistics s_lazy_function_parsing_statistics;
+
+LazyFunctionParsingStatistics const& lazy_function_parsing_statistics()
+{
+    return s_lazy_function_parsing_statistics;
+}
+
+void dump_lazy_function_parsing_statistics()
+{
+    auto const& statistics = s_lazy_function_parsing_statistics;
+    warnln("Lazy function parsing: {} functions ({} bytes) not kept, {} of which had to be parsed in full up front, {} ({} bytes) parsed again in {} us",
+        statistics.lazy_functions,
+        statistics.lazy_source_bytes,
+        statistics.fully_parsed_lazy_functions,
+        statistics.reparsed_functions,
+        statistics.reparsed_source_bytes,
+        statistics.reparse_time.to_microseconds());
+}
+
 class ScopePusher {
 
     // NOTE: We really only need ModuleTopLevel and NotModuleTopLevel as the only
@@ -403,6 +424,9 @@ public:
                     identifier_group.used_inside_scope_with_eval = true;
 
                 if (m_parent_scope) {
+                    if (m_free_identifiers)
+                        m_free_identifiers->append(identifier_group.identifiers.first());
+
                     if (auto maybe_parent_scope_identifier_group = m_parent_scope->m_identifier_groups.get(identifier_group_name); maybe_parent_scope_identifier_group.has_value()) {
                         maybe_parent_scope_identifier_group.value().identifiers.extend(identifier_group.identifiers);
                         if (identifier_group.captured_by_nested_function)
@@ -495,6 +519,28 @@ public:
         m_is_arrow_function = true;
     }
 
+    // Collects one identifier for every name that leaves this scope unresolved.
+    void collect_free_identifiers_into(Vector<NonnullRefPtr<Identifier const>>& free_identifiers)
+    {
+        m_free_identifiers = &free_identifiers;
+    }
+
+    // Gives the unresolved identifiers that reached this scope the same resolution as the given ones.
+    void resolve_free_identifiers_like(Vector<NonnullRefPtr<Identifier const>> const& free_identifiers)
+    {
+        for (auto const& free_identifier : free_identifiers) {
+            auto identifier_group = m_identifier_groups.get(free_identifier->string());
+            if (!identifier_group.has_value())
+                continue;
+            for (auto& identifier : identifier_group->identifiers) {
+                if (free_identifier->declaration_kind() != DeclarationKind::None)
+                    identifier->set_declaration_kind(free_identifier->declaration_kind());
+                if (free_identifier->is_global())
+                    identifier->set_is_global();
+            }
+        }
+    }
+
 private:
     void throw_identifier_declared(FlyString const& name, NonnullRefPtr<Declaration const> const& declaration)
     {
@@ -533,6 +579,8 @@ private:
 
     RefPtr<FunctionParameters const> m_function_parameters;
 
+    Vector<NonnullRefPtr<Identifier const>>* m_free_identifiers { nullptr };
+
     bool m_contains_access_to_arguments_object_in_non_strict_mode { false };
     bool m_contains_direct_call_to_eval { false };
     bool m_contains_await_expression { false };
@@ -694,6 +742,13 @@ Parser::Parser(Lexer lexer, Program::Type program_type, Optional<EvalInitialStat
     }
 }
 
+Parser::Parser(NonnullRefPtr<SourceCode const> source_code, Lexer lexer, Program::Type program_type)
+    : m_source_code(move(source_code))
+    , m_state(move(lexer), program_type)
+    , m_program_type(program_type)
+{
+}
+
 Associativity Parser::operator_associativity(TokenType type) const
 {
     switch (type) {
@@ -1159,7 +1214,7 @@ RefPtr<FunctionExpression const> Parser::try_parse_arrow_function_expression(boo
 
     auto function_start_offset = rule_start.position().offset;
     auto function_end_offset = position().offset - m_state.current_token.trivia().length();
-    auto source_text = ByteString { m_state.lexer.source().substring_view(function_start_offset, function_end_offset - function_start_offset) };
+    auto source_text = ByteString { source_view(function_start_offset, function_end_offset) };
     return create_ast_node<FunctionExpression>(
         { m_source_code, rule_start.position(), position() }, nullptr, move(source_text),
         move(body), move(parameters), function_length, function_kind, body->in_strict_mode(),
@@ -1690,7 +1745,7 @@ NonnullRefPtr<ClassExpression const> Parser::parse_class_expression(bool expect_
 
     auto function_start_offset = rule_start.position().offset;
     auto function_end_offset = position().offset - m_state.current_token.trivia().length();
-    auto source_text = ByteString { m_state.lexer.source().substring_view(function_start_offset, function_end_offset - function_start_offset) };
+    auto source_text = ByteString { source_view(function_start_offset, function_end_offset) };
 
     return create_ast_node<ClassExpression>({ m_source_code, rule_start.position(), position() }, move(class_name), move(source_text), move(constructor), move(super_class), move(elements));
 }
@@ -2584,7 +2639,7 @@ RefPtr<BindingPattern const> Parser::synthesize_binding_pattern(Expression const
     // This means that `source` will contain the subsequent token's trivia, if any (which is fine).
     auto source_start_offset = expression.source_range().start.offset;
     auto source_end_offset = expression.source_range().end.offset;
-    auto source = m_state.lexer.source().substring_view(source_start_offset, source_end_offset - source_start_offset);
+    auto source = source_view(source_start_offset, source_end_offset);
     Lexer lexer { source, m_state.lexer.filename(), expression.source_range().start.line, expression.source_range().start.column };
     Parser parser { lexer };
 
@@ -2850,56 +2905,224 @@ NonnullRefPtr<FunctionBody const> Parser::parse_function_body(NonnullRefPtr<Func
         expected(Token::name(TokenType::CurlyClose));
 
     // If the function contains 'use strict' we need to check the parameters (again).
-    if (function_body->in_strict_mode() || function_kind != FunctionKind::Normal) {
-        Vector<StringView> parameter_names;
-        for (auto& parameter : parameters->parameters()) {
-            parameter.binding.visit(
-                [&](Identifier const& identifier) {
-                    auto const& parameter_name = identifier.string();
+    check_function_parameters(*parameters, function_kind, function_body->in_strict_mode());
+
+    m_state.strict_mode = previous_strict_mode;
+    VERIFY(m_state.current_scope_pusher->type() == ScopePusher::ScopeType::Function);
+    parsing_insights.contains_direct_call_to_eval = m_state.current_scope_pusher->contains_direct_call_to_eval();
+    parsing_insights.uses_this_from_environment = m_state.current_scope_pusher->uses_this_from_environment();
+    parsing_insights.uses_this = m_state.current_scope_pusher->uses_this();
+    return function_body;
+}
+
+void Parser::check_function_parameters(FunctionParameters const& parameters, FunctionKind function_kind, bool in_strict_mode)
+{
+    if (!in_strict_mode && function_kind == FunctionKind::Normal)
+        return;
+
+    Vector<StringView> parameter_names;
+    for (auto& parameter : parameters.parameters()) {
+        parameter.binding.visit(
+            [&](Identifier const& identifier) {
+                auto const& parameter_name = identifier.string();
 
-                    check_identifier_name_for_assignment_validity(parameter_name, function_body->in_strict_mode());
-                    if (function_kind == FunctionKind::Generator && parameter_name == "yield"sv)
+                check_identifier_name_for_assignment_validity(parameter_name, in_strict_mode);
+                if (function_kind == FunctionKind::Generator && parameter_name == "yield"sv)
+                    syntax_error("Parameter name 'yield' not allowed in this context"_string);
+
+                if (function_kind == FunctionKind::Async && parameter_name == "await"sv)
+                    syntax_error("Parameter name 'await' not allowed in this context"_string);
+
+                for (auto& previous_name : parameter_names) {
+                    if (previous_name == parameter_name) {
+                        syntax_error(MUST(String::formatted("Duplicate parameter '{}' not allowed in strict mode", parameter_name)));
+                    }
+                }
+
+                parameter_names.append(parameter_name);
+            },
+            [&](NonnullRefPtr<BindingPattern const> const& binding) {
+                // NOTE: Nothing in the callback throws an exception.
+                MUST(binding->for_each_bound_identifier([&](auto& bound_identifier) {
+                    auto const& bound_name = bound_identifier.string();
+
+                    if (function_kind == FunctionKind::Generator && bound_name == "yield"sv)
                         syntax_error("Parameter name 'yield' not allowed in this context"_string);
 
-                    if (function_kind == FunctionKind::Async && parameter_name == "await"sv)
+                    if (function_kind == FunctionKind::Async && bound_name == "await"sv)
                         syntax_error("Parameter name 'await' not allowed in this context"_string);
 
                     for (auto& previous_name : parameter_names) {
-                        if (previous_name == parameter_name) {
-                            syntax_error(MUST(String::formatted("Duplicate parameter '{}' not allowed in strict mode", parameter_name)));
+                        if (previous_name == bound_name) {
+                            syntax_error(MUST(String::formatted("Duplicate parameter '{}' not allowed in strict mode", bound_name)));
+                            break;
                         }
                     }
+                    parameter_names.append(bound_name);
+                }));
+            });
+    }
+}
 
-                    parameter_names.append(parameter_name);
-                },
-                [&](NonnullRefPtr<BindingPattern const> const& binding) {
-                    // NOTE: Nothing in the callback throws an exception.
-                    MUST(binding->for_each_bound_identifier([&](auto& bound_identifier) {
-                        auto const& bound_name = bound_identifier.string();
+// Skips over a function body that g_lazy_function_parsing will parse again on the first call, without building its AST.
+// The enclosing scope analysis only needs to know which names the body refers to and whether it uses `this`, `eval` or
+// `arguments`, which can be read off the tokens. Every identifier in the body counts as a reference, which is a superset
+// of the names the body really leaves unresolved. Returns nothing, with the parser rewound to the start of the body, if
+// the tokens can't be trusted to match what a full parse would see. The caller then has to parse the body in full.
+RefPtr<FunctionBody const> Parser::preparse_function_body(NonnullRefPtr<FunctionParameters const> parameters, FunctionKind function_kind, FunctionParsingInsights& parsing_insights)
+{
+    // NOTE: A directive prologue can make the function strict, which changes which parameters are valid. Leave those
+    //       to the full parser rather than telling directives apart from expression statements here.
+    if (match(TokenType::StringLiteral))
+        return nullptr;
 
-                        if (function_kind == FunctionKind::Generator && bound_name == "yield"sv)
-                            syntax_error("Parameter name 'yield' not allowed in this context"_string);
+    auto rule_start = push_start();
+    save_state();
 
-                        if (function_kind == FunctionKind::Async && bound_name == "await"sv)
-                            syntax_error("Parameter name 'await' not allowed in this context"_string);
+    HashTable<FlyString> referenced_names;
+    Vector<TokenType, 32> open_brackets;
+    bool uses_this = false;
+    bool uses_new_target = false;
+    bool contains_arrow_function = false;
+    bool contains_direct_call_to_eval = false;
+    auto previous_type = TokenType::CurlyOpen;
+    bool previous_was_eval = false;
+
+    auto closes = [&](TokenType open) {
+        if (open_brackets.is_empty() || open_brackets.last() != open)
+            return false;
+        open_brackets.take_last();
+        return true;
+    };
 
-                        for (auto& previous_name : parameter_names) {
-                            if (previous_name == bound_name) {
-                                syntax_error(MUST(String::formatted("Duplicate parameter '{}' not allowed in strict mode", bound_name)));
-                                break;
-                            }
-                        }
-                        parameter_names.append(bound_name);
-                    }));
-                });
+    while (true) {
+        auto const& token = m_state.current_token;
+        auto type = token.type();
+
+        switch (type) {
+        case TokenType::Eof:
+        case TokenType::Invalid:
+        case TokenType::UnterminatedRegexLiteral:
+        case TokenType::UnterminatedStringLiteral:
+        case TokenType::UnterminatedTemplateLiteral:
+            load_state();
+            return nullptr;
+        case TokenType::CurlyOpen:
+        case TokenType::ParenOpen:
+        case TokenType::BracketOpen:
+        case TokenType::TemplateLiteralExprStart:
+            open_brackets.append(type);
+            if (type == TokenType::ParenOpen && previous_was_eval)
+                contains_direct_call_to_eval = true;
+            break;
+        case TokenType::CurlyClose:
+            if (open_brackets.is_empty())
+                break;
+            if (!closes(TokenType::CurlyOpen)) {
+                load_state();
+                return nullptr;
+            }
+            break;
+        case TokenType::ParenClose:
+        case TokenType::BracketClose:
+        case TokenType::TemplateLiteralExprEnd: {
+            auto open = type == TokenType::ParenClose ? TokenType::ParenOpen
+                : type == TokenType::BracketClose     ? TokenType::BracketOpen
+                                                      : TokenType::TemplateLiteralExprStart;
+            if (!closes(open)) {
+                load_state();
+                return nullptr;
+            }
+            break;
+        }
+        case TokenType::This:
+            uses_this = true;
+            break;
+        case TokenType::Super:
+            uses_new_target = true;
+            break;
+        case TokenType::Arrow:
+            contains_arrow_function = true;
+            break;
+        case TokenType::Period:
+            if (previous_type == TokenType::New)
+                uses_new_target = true;
+            break;
+        default:
+            break;
+        }
+
+        // This is the closing curly bracket of the function itself, which parse_function_node() consumes.
+        if (type == TokenType::CurlyClose && open_brackets.is_empty())
+            break;
+
+        auto is_property_name = previous_type == TokenType::Period || previous_type == TokenType::QuestionMarkPeriod;
+        previous_was_eval = false;
+
+        if (!token.is_identifier_name()) {
+            consume_and_allow_division();
+        } else if (is_property_name) {
+            consume_and_allow_division();
+        } else if (type == TokenType::Identifier || type == TokenType::EscapedKeyword) {
+            auto name = token.fly_string_value();
+            previous_was_eval = name == "eval"sv;
+            auto is_contextual_keyword = name.is_one_of("of"sv, "let"sv, "async"sv, "yield"sv, "await"sv);
+            referenced_names.set(move(name));
+            consume_and_allow_division();
+            // NOTE: `for (x of /a/)` makes the slash start a regular expression, `of / 2` doesn't.
+            if (is_contextual_keyword && (match(TokenType::Slash) || match(TokenType::SlashEquals))) {
+                load_state();
+                return nullptr;
+            }
+        } else if (type == TokenType::BoolLiteral || type == TokenType::NullLiteral || type == TokenType::This || type == TokenType::Super) {
+            consume_and_allow_division();
+        } else if (type == TokenType::Let || type == TokenType::Yield || type == TokenType::Await || type == TokenType::Async) {
+            // NOTE: These are identifiers in some contexts, so they may be references, and whether a slash after them
+            //       starts a regular expression depends on the context too.
+            referenced_names.set(token.fly_string_value());
+            consume_and_allow_division();
+            if (match(TokenType::Slash) || match(TokenType::SlashEquals)) {
+                load_state();
+                return nullptr;
+            }
+        } else {
+            // A keyword, after which a slash always starts a regular expression.
+            consume();
         }
+
+        previous_type = type;
     }
 
-    m_state.strict_mode = previous_strict_mode;
+    discard_saved_state();
+
+    auto function_body = create_ast_node<FunctionBody>({ m_source_code, rule_start.position(), position() });
+    if (m_state.strict_mode)
+        function_body->set_strict_mode();
+
     VERIFY(m_state.current_scope_pusher->type() == ScopePusher::ScopeType::Function);
-    parsing_insights.contains_direct_call_to_eval = m_state.current_scope_pusher->contains_direct_call_to_eval();
-    parsing_insights.uses_this_from_environment = m_state.current_scope_pusher->uses_this_from_environment();
-    parsing_insights.uses_this = m_state.current_scope_pusher->uses_this();
+    auto& function_scope = *m_state.current_scope_pusher;
+    function_scope.set_scope_node(function_body);
+    function_scope.set_function_parameters(parameters);
+
+    check_function_parameters(*parameters, function_kind, m_state.strict_mode);
+
+    for (auto const& name : referenced_names)
+        (void)create_identifier_and_register_in_current_scope({ m_source_code, rule_start.position(), position() }, name);
+
+    if (contains_direct_call_to_eval) {
+        function_scope.set_contains_direct_call_to_eval();
+        function_scope.set_uses_this();
+    }
+    // NOTE: We can't tell whether `this` is used inside a nested arrow function, in which case it comes from this
+    //       function's environment, so assume it is if there is one.
+    if (uses_new_target || (uses_this && contains_arrow_function))
+        function_scope.set_uses_new_target();
+    else if (uses_this)
+        function_scope.set_uses_this();
+
+    parsing_insights.contains_direct_call_to_eval = function_scope.contains_direct_call_to_eval();
+    parsing_insights.uses_this_from_environment = function_scope.uses_this_from_environment();
+    parsing_insights.uses_this = function_scope.uses_this();
     return function_body;
 }
 
@@ -2923,6 +3146,12 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
         : push_start();
     VERIFY(!(parse_options & FunctionNodeParseOptions::IsGetterFunction && parse_options & FunctionNodeParseOptions::IsSetterFunction));
 
+    // NOTE: The function that parse_lazy_function() is parsing again is the one whose body we need.
+    auto const drop_body = !exchange(m_is_parsing_lazy_function, false) && can_drop_function_body(parse_options, function_start);
+    auto const initial_parse_options = parse_options;
+    auto const initial_strict_mode = m_state.strict_mode;
+    Vector<NonnullRefPtr<Identifier const>> free_identifiers;
+
     TemporaryChange super_property_access_rollback(m_state.allow_super_property_lookup, !!(parse_options & FunctionNodeParseOptions::AllowSuperPropertyLookup));
     TemporaryChange super_constructor_call_rollback(m_state.allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
     TemporaryChange break_context_rollback(m_state.in_break_context, false);
@@ -2988,6 +3217,8 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     FunctionParsingInsights parsing_insights;
     auto body = [&] {
         ScopePusher function_scope = ScopePusher::function_scope(*this, name);
+        if (drop_body)
+            function_scope.collect_free_identifiers_into(free_identifiers);
 
         consume(TokenType::ParenOpen);
         parameters = parse_formal_parameters(function_length, parse_options);
@@ -3005,6 +3236,12 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
 
         consume(TokenType::CurlyOpen);
 
+        if (drop_body) {
+            if (auto function_body = preparse_function_body(*parameters, function_kind, parsing_insights))
+                return function_body.release_nonnull();
+            ++s_lazy_function_parsing_statistics.fully_parsed_lazy_functions;
+        }
+
         return parse_function_body(*parameters, function_kind, parsing_insights);
     }();
 
@@ -3018,17 +3255,34 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
 
     auto function_start_offset = rule_start.position().offset;
     auto function_end_offset = position().offset - m_state.current_token.trivia().length();
-    auto source_text = ByteString { m_state.lexer.source().substring_view(function_start_offset, function_end_offset - function_start_offset) };
+    auto source_text = ByteString { source_view(function_start_offset, function_end_offset) };
     parsing_insights.might_need_arguments_object = m_state.function_might_need_arguments_object;
     if (parse_options & FunctionNodeParseOptions::IsConstructor) {
         parsing_insights.uses_this = true;
         parsing_insights.uses_this_from_environment = true;
     }
-    return create_ast_node<FunctionNodeType>(
+    auto function_node = create_ast_node<FunctionNodeType>(
         { m_source_code, rule_start.position(), position() },
-        name, move(source_text), move(body), parameters.release_nonnull(), function_length,
+        name, source_text, move(body), parameters.release_nonnull(), function_length,
         function_kind, has_strict_directive, parsing_insights,
         move(local_variables_names));
+
+    if (drop_body) {
+        // NOTE: The body has either been pre-parsed, or parsed in full if pre-parsing gave up on it. Either way, its AST
+        //       is not kept until the function is called.
+        ++s_lazy_function_parsing_statistics.lazy_functions;
+        s_lazy_function_parsing_statistics.lazy_source_bytes += source_text.length();
+        auto lazy_body = adopt_ref(*new LazyFunctionBody(m_source_code));
+        lazy_body->start = rule_start.position();
+        lazy_body->end_offset = function_end_offset;
+        lazy_body->program_type = m_program_type;
+        lazy_body->parse_options = initial_parse_options;
+        lazy_body->strict_mode = initial_strict_mode;
+        lazy_body->free_identifiers = move(free_identifiers);
+        function_node->drop_body(move(lazy_body));
+    }
+
+    return function_node;
 }
 
 NonnullRefPtr<FunctionParameters const> Parser::parse_formal_parameters(int& function_length, u16 parse_options)
@@ -5217,6 +5471,68 @@ NonnullRefPtr<Identifier const> Parser::create_identifier_and_register_in_curren
     return id;
 }
 
+StringView Parser::source_view(size_t start_offset, size_t end_offset) const
+{
+    auto source_offset = m_state.lexer.source_offset();
+    return m_state.lexer.source().substring_view(start_offset - source_offset, end_offset - start_offset);
+}
+
+bool Parser::can_drop_function_body(u16 parse_options, Optional<Position> const& function_start) const
+{
+    if (!g_lazy_function_parsing)
+        return false;
+
+    // Only functions nested in a script or module, not the function being parsed by the Function constructor.
+    if (!m_state.current_scope_pusher)
+        return false;
+
+    // Methods, accessors and class constructors depend on the surrounding object literal or class (super, private
+    // names), and eval code is short-lived, so these are always parsed in full.
+    if (function_start.has_value())
+        return false;
+    constexpr u16 allowed_parse_options = FunctionNodeParseOptions::CheckForFunctionAndName
+        | FunctionNodeParseOptions::IsGeneratorFunction
+        | FunctionNodeParseOptions::IsAsyncFunction
+        | FunctionNodeParseOptions::HasDefaultExportName;
+    if ((parse_options & ~allowed_parse_options) != 0)
+        return false;
+    if (m_state.referenced_private_names || m_state.in_class_field_initializer || m_state.in_class_static_init_block)
+        return false;
+    if (m_state.initiated_by_eval)
+        return false;
+
+    return true;
+}
+
+Result<NonnullRefPtr<FunctionExpression const>, Vector<ParserError>> Parser::parse_lazy_function(LazyFunctionBody const& lazy_body)
+{
+    auto start_time = MonotonicTime::now();
+
+    auto const& start = lazy_body.start;
+    Lexer lexer { lazy_body.source_text(), lazy_body.source_code->filename(), start.line, start.column - 1, start.offset };
+    Parser parser { lazy_body.source_code, move(lexer), lazy_body.program_type };
+    parser.m_state.strict_mode = lazy_body.strict_mode;
+    parser.m_is_parsing_lazy_function = true;
+
+    RefPtr<FunctionExpression const> function;
+    {
+        // NOTE: This stands in for the enclosing code, which has already decided how the names that the function
+        //       doesn't declare itself are resolved.
+        auto enclosing_scope = ScopePusher::function_scope(parser);
+        // NOTE: Declarations are parsed as expressions here, as the binding for the name belongs to the enclosing code.
+        function = parser.parse_function_node<FunctionExpression>(lazy_body.parse_options);
+        enclosing_scope.resolve_free_identifiers_like(lazy_body.free_identifiers);
+    }
+
+    if (parser.has_errors())
+        return parser.errors();
+
+    ++s_lazy_function_parsing_statistics.reparsed_functions;
+    s_lazy_function_parsing_statistics.reparsed_source_bytes += lazy_body.source_text().length();
+    s_lazy_function_parsing_statistics.reparse_time += MonotonicTime::now() - start_time;
+    return function.release_nonnull();
+}
+
 Parser Parser::parse_function_body_from_string(ByteString const& body_string, u16 parse_options, NonnullRefPtr<FunctionParameters const> parameters, FunctionKind kind, FunctionParsingInsights& parsing_insights)
 {
     RefPtr<FunctionBody const> function_body;
@@ -11,8 +11,11 @@
 #include <AK/Assertions.h>
 #include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Result.h>
 #include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <LibJS/AST.h>
+#include <LibJS/Export.h>
 #include <LibJS/Lexer.h>
 #include <LibJS/ParserError.h>
 #include <LibJS/Runtime/FunctionConstructor.h>
@@ -28,6 +31,24 @@ enum class Associativity {
     Right
 };
 
+// Whether the bodies of function declarations and expressions nested in a script or module are only pre-parsed, and
+// parsed for real when the function is first called. Pre-parsing lexes the body without building an AST, to find the
+// names it refers to. Only lexer errors and unbalanced brackets are reported up front, other early errors in a
+// pre-parsed body are thrown as a SyntaxError on the first call. Off by default.
+JS_API extern bool g_lazy_function_parsing;
+
+struct LazyFunctionParsingStatistics {
+    u64 lazy_functions { 0 };
+    u64 lazy_source_bytes { 0 };
+    u64 fully_parsed_lazy_functions { 0 };
+    u64 reparsed_functions { 0 };
+    u64 reparsed_source_bytes { 0 };
+    AK::Duration reparse_time;
+};
+
+JS_API LazyFunctionParsingStatistics const& lazy_function_parsing_statistics();
+JS_API void dump_lazy_function_parsing_statistics();
+
 struct FunctionNodeParseOptions {
     enum : u16 {
         CheckForFunctionAndName = 1 << 0,
@@ -89,6 +110,7 @@ public:
     NonnullRefPtr<Statement const> parse_statement(AllowLabelledFunction allow_labelled_function = AllowLabelledFunction::No);
     NonnullRefPtr<BlockStatement const> parse_block_statement();
     NonnullRefPtr<FunctionBody const> parse_function_body(NonnullRefPtr<FunctionParameters const>, FunctionKind function_kind, FunctionParsingInsights&);
+    RefPtr<FunctionBody const> preparse_function_body(NonnullRefPtr<FunctionParameters const>, FunctionKind function_kind, FunctionParsingInsights&);
     NonnullRefPtr<ReturnStatement const> parse_return_statement();
 
     enum class IsForLoopVariableDeclaration {
@@ -214,9 +236,18 @@ public:
 
     static Parser parse_function_body_from_string(ByteString const& body_string, u16 parse_options, NonnullRefPtr<FunctionParameters const>, FunctionKind kind, FunctionParsingInsights&);
 
+    // Parses a function whose body was dropped by g_lazy_function_parsing again, this time keeping the body.
+    static Result<NonnullRefPtr<FunctionExpression const>, Vector<ParserError>> parse_lazy_function(LazyFunctionBody const&);
+
 private:
     friend class ScopePusher;
 
+    Parser(NonnullRefPtr<SourceCode const>, Lexer, Program::Type);
+
+    bool can_drop_function_body(u16 parse_options, Optional<Position> const& function_start) const;
+    void check_function_parameters(FunctionParameters const&, FunctionKind, bool in_strict_mode);
+    StringView source_view(size_t start_offset, size_t end_offset) const;
+
     void parse_script(Program& program, bool starts_in_strict_mode);
     void parse_module(Program& program);
 
@@ -341,6 +372,7 @@ private:
     Vector<ParserState> m_saved_state;
     HashMap<size_t, TokenMemoization> m_token_memoizations;
     Program::Type m_program_type;
+    bool m_is_parsing_lazy_function { false };
 };
 
 }
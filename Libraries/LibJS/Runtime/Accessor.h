@@ -16,6 +16,7 @@ namespace JS {
 class Accessor final : public Cell {
     GC_CELL(Accessor, Cell);
     GC_DECLARE_ALLOCATOR(Accessor);
+    GC_DECLARE_WRITE_BARRIER(Accessor);
 
 public:
     static GC::Ref<Accessor> create(VM& vm, FunctionObject* getter, FunctionObject* setter)
@@ -24,10 +25,18 @@ public:
     }
 
     FunctionObject* getter() const { return m_getter; }
-    void set_getter(FunctionObject* getter) { m_getter = getter; }
+    void set_getter(FunctionObject* getter)
+    {
+        m_getter = getter;
+        did_store_edge();
+    }
 
     FunctionObject* setter() const { return m_setter; }
-    void set_setter(FunctionObject* setter) { m_setter = setter; }
+    void set_setter(FunctionObject* setter)
+    {
+        m_setter = setter;
+        did_store_edge();
+    }
 
     void visit_edges(Cell::Visitor& visitor) override
     {
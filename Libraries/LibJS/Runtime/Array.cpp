@@ -167,12 +167,34 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+SimpleIndexedPropertyStorage const* packed_array_storage(Object const& object, size_t length)
+{
+    if (!is<Array>(object) || object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    if (!simple_storage.is_packed() || simple_storage.array_like_size() < length)
+        return nullptr;
+    return &simple_storage;
+}
+
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
 ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
 {
     // 1. Let items be a new empty List.
     auto items = GC::RootVector<Value> { vm.heap() };
 
+    // OPTIMIZATION: Every element of a packed array is present, so we can copy them without looking each of them up.
+    if (auto const* storage = packed_array_storage(object, length)) {
+        items.ensure_capacity(length);
+        for (size_t k = 0; k < length; ++k)
+            items.unchecked_append(storage->elements()[k]);
+        TRY(array_merge_sort(vm, sort_compare, items));
+        return items;
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
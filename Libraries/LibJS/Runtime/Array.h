@@ -80,6 +80,15 @@ enum class Holes {
     ReadThroughHoles,
 };
 
+// Returns the element storage of an ordinary array if it's packed up to at least `length`. All of those elements are own
+// data properties then, so reading them directly is indistinguishable from [[HasProperty]] and [[Get]], and overwriting
+// them directly is indistinguishable from [[Set]].
+SimpleIndexedPropertyStorage const* packed_array_storage(Object const&, size_t length);
+inline SimpleIndexedPropertyStorage* packed_array_storage(Object& object, size_t length)
+{
+    return const_cast<SimpleIndexedPropertyStorage*>(packed_array_storage(const_cast<Object const&>(object), length));
+}
+
 ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -379,6 +380,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    // OPTIMIZATION: Filling part of a packed array only overwrites existing elements, which we can do directly.
+    if (auto* storage = packed_array_storage(this_object, to)) {
+        for (u64 i = from; i < to; i++)
+            storage->put(i, vm.argument(0));
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -742,6 +750,29 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Search packed arrays directly, comparing raw numbers if all elements are known to be numbers.
+    if (auto const* storage = packed_array_storage(this_object, length)) {
+        auto const* elements = storage->elements().data();
+        if (storage->has_only_number_elements()) {
+            if (!value_to_find.is_number())
+                return Value(false);
+            auto number_to_find = value_to_find.as_double();
+            auto find_nan = value_to_find.is_nan();
+            for (u64 i = from_index; i < length; ++i) {
+                auto element = elements[i].as_double();
+                if (element == number_to_find || (find_nan && isnan(element)))
+                    return Value(true);
+            }
+            return Value(false);
+        }
+        for (u64 i = from_index; i < length; ++i) {
+            if (same_value_zero(elements[i], value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +826,34 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Search packed arrays directly, comparing raw integers or numbers if all elements are known to be such.
+    if (auto const* storage = packed_array_storage(object, length)) {
+        auto const* elements = storage->elements().data();
+        if (storage->has_only_number_elements()) {
+            if (!search_element.is_number())
+                return Value(-1);
+            if (search_element.is_int32() && storage->has_only_int32_elements()) {
+                auto integer_to_find = search_element.as_i32();
+                for (; k < length; ++k) {
+                    if (elements[k].as_i32() == integer_to_find)
+                        return Value(k);
+                }
+                return Value(-1);
+            }
+            auto number_to_find = search_element.as_double();
+            for (; k < length; ++k) {
+                if (elements[k].as_double() == number_to_find)
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+        for (; k < length; ++k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -958,6 +1017,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Elements of packed arrays are always present and can be read directly. This has to be checked
+        //               for every element, as the callback may have changed the array.
+        if (auto const* storage = packed_array_storage(object, k + 1)) {
+            auto k_value = storage->elements()[k];
+            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            TRY(array->create_data_property_or_throw(property_key, mapped_value));
+            continue;
+        }
+
         // b. Let kPresent be ? HasProperty(O, Pk).
         auto k_present = TRY(object->has_property(property_key));
 
@@ -1395,6 +1463,40 @@ ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<doub
     return {};
 }
 
+// Compares the decimal representations of two non-negative integers like strings, without creating them.
+static bool decimal_string_is_less_than(u64 a, u64 b)
+{
+    auto digit_count = [](u64 value) {
+        size_t count = 1;
+        for (; value >= 10; value /= 10)
+            ++count;
+        return count;
+    };
+
+    auto a_digits = digit_count(a);
+    auto b_digits = digit_count(b);
+
+    // Pad the shorter number with zeros, so that the first differing digit decides. If there is none, the shorter
+    // string is a prefix of the longer one.
+    for (auto i = a_digits; i < b_digits; ++i)
+        a *= 10;
+    for (auto i = b_digits; i < a_digits; ++i)
+        b *= 10;
+    if (a != b)
+        return a < b;
+    return a_digits < b_digits;
+}
+
+static bool int32_is_less_than_as_string(i32 a, i32 b)
+{
+    // NOTE: '-' comes before all digits.
+    if ((a < 0) != (b < 0))
+        return a < 0;
+    if (a < 0)
+        return decimal_string_is_less_than(-static_cast<i64>(a), -static_cast<i64>(b));
+    return decimal_string_is_less_than(a, b);
+}
+
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1409,6 +1511,22 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 3. Let len be ? LengthOfArrayLike(obj).
     auto length = TRY(length_of_array_like(vm, object));
 
+    // OPTIMIZATION: By default, elements are ordered by their string representation, which never considers two different
+    //               integers equal. An unstable sort of a packed array of integers is thus indistinguishable from a
+    //               stable one, and we can sort the raw integers without creating any strings.
+    if (comparefn.is_undefined()) {
+        if (auto* storage = packed_array_storage(object, length); storage && storage->has_only_int32_elements()) {
+            Vector<i32> integers;
+            integers.ensure_capacity(length);
+            for (size_t k = 0; k < length; ++k)
+                integers.unchecked_append(storage->elements()[k].as_i32());
+            quick_sort(integers, int32_is_less_than_as_string);
+            for (size_t k = 0; k < length; ++k)
+                storage->put(k, Value(integers[k]));
+            return object;
+        }
+    }
+
     // 4. Let SortCompare be a new Abstract Closure with parameters (x, y) that captures comparefn and performs the following steps when called:
     Function<ThrowCompletionOr<double>(Value, Value)> sort_compare = [&](auto x, auto y) -> ThrowCompletionOr<double> {
         // a. Return ? CompareArrayElements(x, y, comparefn).
@@ -18,6 +18,7 @@ namespace JS {
 class BigInt final : public Cell {
     GC_CELL(BigInt, Cell);
     GC_DECLARE_ALLOCATOR(BigInt);
+    GC_DECLARE_WRITE_BARRIER(BigInt);
 
 public:
     [[nodiscard]] static GC::Ref<BigInt> create(VM&, Crypto::SignedBigInteger);
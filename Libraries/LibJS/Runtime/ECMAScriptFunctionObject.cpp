@@ -13,6 +13,7 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
@@ -126,12 +127,13 @@ GC::Ref<ECMAScriptFunctionObject> ECMAScriptFunctionObject::create_from_function
             move(name),
             function_node.function_length(),
             function_node.parameters(),
-            *function_node.body_ptr(),
+            function_node.body_ptr(),
             function_node.source_text(),
             function_node.is_strict_mode(),
             function_node.is_arrow_function(),
             function_node.parsing_insights(),
-            function_node.local_variables_names()));
+            function_node.local_variables_names(),
+            function_node.lazy_body()));
         function_node.set_shared_data(shared_data);
     }
 
@@ -148,14 +150,16 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
     FlyString name,
     i32 function_length,
     NonnullRefPtr<FunctionParameters const> formal_parameters,
-    NonnullRefPtr<Statement const> ecmascript_code,
+    RefPtr<Statement const> ecmascript_code,
     ByteString source_text,
     bool strict,
     bool is_arrow_function,
     FunctionParsingInsights const& parsing_insights,
-    Vector<LocalVariable> local_variables_names)
+    Vector<LocalVariable> local_variables_names,
+    RefPtr<LazyFunctionBody const> lazy_body)
     : m_formal_parameters(move(formal_parameters))
     , m_ecmascript_code(move(ecmascript_code))
+    , m_lazy_body(move(lazy_body))
     , m_name(move(name))
     , m_source_text(move(source_text))
     , m_local_variables_names(move(local_variables_names))
@@ -165,8 +169,11 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
     , m_might_need_arguments_object(parsing_insights.might_need_arguments_object)
     , m_contains_direct_call_to_eval(parsing_insights.contains_direct_call_to_eval)
     , m_is_arrow_function(is_arrow_function)
+    , m_uses_this_from_environment(parsing_insights.uses_this_from_environment)
     , m_uses_this(parsing_insights.uses_this)
 {
+    VERIFY(m_ecmascript_code || m_lazy_body);
+
     if (m_is_arrow_function)
         m_this_mode = ThisMode::Lexical;
     else if (m_strict)
@@ -185,6 +192,40 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
         return true;
     });
 
+    // NOTE: For a function without a body yet, this happens in parse_lazy_body() when it's first called.
+    if (m_ecmascript_code)
+        prepare_function_declaration_instantiation(vm);
+}
+
+ThrowCompletionOr<void> SharedFunctionInstanceData::parse_lazy_body(VM& vm)
+{
+    VERIFY(!m_ecmascript_code);
+    VERIFY(m_lazy_body);
+
+    auto function_or_errors = Parser::parse_lazy_function(*m_lazy_body);
+    if (function_or_errors.is_error())
+        return vm.throw_completion<SyntaxError>(function_or_errors.error().first().to_string());
+
+    // NOTE: The parameters are taken from the new parse as well, so that the function's identifiers all come from the same scope analysis.
+    auto function = function_or_errors.release_value();
+    m_formal_parameters = function->parameters();
+    m_ecmascript_code = function->body_ptr();
+    m_local_variables_names = function->local_variables_names();
+    m_lazy_body = nullptr;
+
+    // NOTE: Pre-parsing can only tell that the body might use these, the real parse knows.
+    auto const& parsing_insights = function->parsing_insights();
+    m_might_need_arguments_object = parsing_insights.might_need_arguments_object;
+    m_contains_direct_call_to_eval = parsing_insights.contains_direct_call_to_eval;
+    m_uses_this_from_environment = parsing_insights.uses_this_from_environment;
+    m_uses_this = parsing_insights.uses_this;
+
+    prepare_function_declaration_instantiation(vm);
+    return {};
+}
+
+void SharedFunctionInstanceData::prepare_function_declaration_instantiation(VM& vm)
+{
     // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
     //       and then reused in all subsequent function instantiations.
 
@@ -277,7 +318,7 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
 
     size_t parameter_environment_bindings_count = 0;
     // 19. If strict is true or hasParameterExpressions is false, then
-    if (strict || !m_has_parameter_expressions) {
+    if (m_strict || !m_has_parameter_expressions) {
         // a. NOTE: Only a single Environment Record is needed for the parameters, since calls to eval in strict mode code cannot create new bindings which are visible outside of the eval.
         // b. Let env be the LexicalEnvironment of calleeContext
         // NOTE: Here we are only interested in the size of the environment.
@@ -414,7 +455,7 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
         }));
     }
 
-    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || parsing_insights.uses_this_from_environment || m_contains_direct_call_to_eval;
+    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || m_uses_this_from_environment || m_contains_direct_call_to_eval;
 }
 
 ECMAScriptFunctionObject::ECMAScriptFunctionObject(
@@ -481,18 +522,28 @@ void ECMAScriptFunctionObject::initialize(Realm& realm)
     }
 }
 
-ThrowCompletionOr<void> ECMAScriptFunctionObject::get_stack_frame_size(size_t& registers_and_constants_and_locals_count, size_t& argument_count)
+ThrowCompletionOr<void> ECMAScriptFunctionObject::ensure_bytecode_executable()
 {
-    if (!m_bytecode_executable) {
-        if (!ecmascript_code().bytecode_executable()) {
-            if (is_module_wrapper()) {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm(), ecmascript_code(), kind(), name())));
-            } else {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm(), *this)));
-            }
+    if (m_bytecode_executable)
+        return {};
+
+    if (!shared_data().m_ecmascript_code)
+        TRY(m_shared_data->parse_lazy_body(vm()));
+
+    if (!ecmascript_code().bytecode_executable()) {
+        if (is_module_wrapper()) {
+            const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm(), ecmascript_code(), kind(), name())));
+        } else {
+            const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm(), *this)));
         }
-        m_bytecode_executable = ecmascript_code().bytecode_executable();
     }
+    m_bytecode_executable = ecmascript_code().bytecode_executable();
+    return {};
+}
+
+ThrowCompletionOr<void> ECMAScriptFunctionObject::get_stack_frame_size(size_t& registers_and_constants_and_locals_count, size_t& argument_count)
+{
+    TRY(ensure_bytecode_executable());
     registers_and_constants_and_locals_count = m_bytecode_executable->number_of_registers + m_bytecode_executable->constants.size() + m_bytecode_executable->local_variable_names.size();
     argument_count = max(argument_count, formal_parameters().size());
     return {};
@@ -548,16 +599,7 @@ ThrowCompletionOr<GC::Ref<Object>> ECMAScriptFunctionObject::internal_construct(
 {
     auto& vm = this->vm();
 
-    if (!m_bytecode_executable) {
-        if (!ecmascript_code().bytecode_executable()) {
-            if (is_module_wrapper()) {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, ecmascript_code(), kind(), name())));
-            } else {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, *this)));
-            }
-        }
-        m_bytecode_executable = ecmascript_code().bytecode_executable();
-    }
+    TRY(ensure_bytecode_executable());
 
     u32 arguments_count = max(arguments_list.size(), formal_parameters().size());
     auto registers_and_constants_and_locals_count = m_bytecode_executable->number_of_registers + m_bytecode_executable->constants.size() + m_bytecode_executable->local_variable_names.size();
@@ -41,15 +41,20 @@ public:
         FlyString name,
         i32 function_length,
         NonnullRefPtr<FunctionParameters const>,
-        NonnullRefPtr<Statement const> ecmascript_code,
+        RefPtr<Statement const> ecmascript_code,
         ByteString source_text,
         bool strict,
         bool is_arrow_function,
         FunctionParsingInsights const&,
-        Vector<LocalVariable> local_variables_names);
+        Vector<LocalVariable> local_variables_names,
+        RefPtr<LazyFunctionBody const> lazy_body = {});
+
+    // Parses the body of a function that was created without one, see g_lazy_function_parsing.
+    ThrowCompletionOr<void> parse_lazy_body(VM&);
 
     RefPtr<FunctionParameters const> m_formal_parameters; // [[FormalParameters]]
     RefPtr<Statement const> m_ecmascript_code;            // [[ECMAScriptCode]]
+    RefPtr<LazyFunctionBody const> m_lazy_body;
 
     FlyString m_name;
     ByteString m_source_text; // [[SourceText]]
@@ -67,6 +72,7 @@ public:
     bool m_is_arrow_function { false };
     bool m_has_simple_parameter_list { false };
     bool m_is_module_wrapper { false };
+    bool m_uses_this_from_environment { false };
 
     struct VariableNameToInitialize {
         Identifier const& identifier;
@@ -95,6 +101,9 @@ public:
     Variant<PropertyKey, PrivateName, Empty> m_class_field_initializer_name; // [[ClassFieldInitializerName]]
     ConstructorKind m_constructor_kind : 1 { ConstructorKind::Base };        // [[ConstructorKind]]
     bool m_is_class_constructor : 1 { false };                               // [[IsClassConstructor]]
+
+private:
+    void prepare_function_declaration_instantiation(VM&);
 };
 
 // 10.2 ECMAScript Function Objects, https://tc39.es/ecma262/#sec-ecmascript-function-objects
@@ -191,6 +200,7 @@ private:
     virtual bool is_strict_mode() const override { return shared_data().m_strict; }
 
     ThrowCompletionOr<Value> ordinary_call_evaluate_body(VM&);
+    ThrowCompletionOr<void> ensure_bytecode_executable();
 
     [[nodiscard]] bool function_environment_needed() const { return shared_data().m_function_environment_needed; }
     SharedFunctionInstanceData const& shared_data() const { return m_shared_data; }
@@ -56,6 +56,18 @@ private:
     bool m_is_simple_storage { false };
 };
 
+// What is known about the elements of a SimpleIndexedPropertyStorage. Kinds only ever transition towards the more
+// general ones (Int32 -> Number -> any value, packed -> holey), so a packed kind guarantees that every index below
+// array_like_size() holds a value, and a numeric kind guarantees the type of all of them.
+enum class ElementKind : u8 {
+    PackedInt32 = 0,
+    PackedNumber = 1,
+    Packed = 2,
+    HoleyInt32 = 4,
+    HoleyNumber = 5,
+    Holey = 6,
+};
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     SimpleIndexedPropertyStorage()
@@ -78,6 +90,11 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return !(to_underlying(m_element_kind) & holey_element_kind_bit); }
+    bool has_only_int32_elements() const { return (to_underlying(m_element_kind) & element_value_kind_mask) == to_underlying(ElementKind::PackedInt32); }
+    bool has_only_number_elements() const { return (to_underlying(m_element_kind) & element_value_kind_mask) <= to_underlying(ElementKind::PackedNumber); }
+
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
         return index < m_array_size && !m_packed_elements.data()[index].is_special_empty_value();
@@ -93,10 +110,29 @@ public:
 private:
     friend GenericIndexedPropertyStorage;
 
+    static constexpr u8 element_value_kind_mask = 0x3;
+    static constexpr u8 holey_element_kind_bit = 0x4;
+
     void grow_storage_if_needed();
 
+    void transition_element_kind_for(Value value)
+    {
+        if (value.is_int32())
+            return;
+        auto kind = to_underlying(m_element_kind);
+        if (value.is_special_empty_value()) {
+            kind |= holey_element_kind_bit;
+        } else {
+            auto value_kind = value.is_number() ? to_underlying(ElementKind::PackedNumber) : to_underlying(ElementKind::Packed);
+            kind = max<u8>(kind & element_value_kind_mask, value_kind) | (kind & holey_element_kind_bit);
+        }
+        m_element_kind = static_cast<ElementKind>(kind);
+    }
+    void transition_to_holey_element_kind() { m_element_kind = static_cast<ElementKind>(to_underlying(m_element_kind) | holey_element_kind_bit); }
+
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -4,14 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/Function.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
-#include <AK/JsonParser.h>
 #include <AK/StringBuilder.h>
 #include <AK/TypeCasts.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
+#include <LibGC/RootVector.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigIntObject.h>
@@ -23,6 +25,7 @@
 #include <LibJS/Runtime/NumberObject.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/RawJSONObject.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/StringObject.h>
 #include <LibJS/Runtime/ValueInlines.h>
 
@@ -447,21 +450,457 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
     return unfiltered;
 }
 
+// Builds JS values straight from JSON text in a single pass, instead of first building an AK::JsonValue tree and then
+// converting that.
+class JSONTextParser {
+public:
+    JSONTextParser(VM& vm, StringView text)
+        : m_vm(vm)
+        , m_realm(*vm.current_realm())
+        , m_text(text)
+        , m_value_stack(vm.heap())
+    {
+    }
+
+    ThrowCompletionOr<Value> parse()
+    {
+        auto value = TRY(parse_value());
+        skip_whitespace();
+        if (!at_end())
+            return syntax_error();
+        return value;
+    }
+
+private:
+    // Objects with the same keys in the same order (e.g. the records in an array) all end up with the same shape, so
+    // we remember the shapes we've built and give them straight to any further objects with those keys.
+    struct ShapeTemplate {
+        Vector<PropertyKey> keys;
+        GC::Root<Shape> shape;
+    };
+    static constexpr size_t number_of_shape_templates = 32;
+
+    ThrowCompletionOr<Value> parse_value()
+    {
+        skip_whitespace();
+        if (at_end())
+            return syntax_error();
+
+        switch (peek()) {
+        case '{':
+            return parse_object();
+        case '[':
+            return parse_array();
+        case '"': {
+            auto string = TRY(parse_string());
+            return string.visit([&](auto& string) -> Value { return PrimitiveString::create(m_vm, move(string)); });
+        }
+        case 't':
+            TRY(consume_literal("true"sv));
+            return Value(true);
+        case 'f':
+            TRY(consume_literal("false"sv));
+            return Value(false);
+        case 'n':
+            TRY(consume_literal("null"sv));
+            return js_null();
+        default:
+            return parse_number();
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_object()
+    {
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+        VERIFY(consume_specific('{'));
+
+        auto key_base = m_key_stack.size();
+        auto value_base = m_value_stack.size();
+
+        skip_whitespace();
+        if (!consume_specific('}')) {
+            for (;;) {
+                skip_whitespace();
+                if (at_end() || peek() != '"')
+                    return syntax_error();
+                auto key = TRY(parse_string());
+                m_key_stack.append(key.visit(
+                    [](String& string) { return PropertyKey { FlyString { string } }; },
+                    [](Utf16String& string) { return PropertyKey { FlyString { string.to_utf8() } }; }));
+
+                skip_whitespace();
+                if (!consume_specific(':'))
+                    return syntax_error();
+
+                m_value_stack.append(TRY(parse_value()));
+
+                skip_whitespace();
+                if (consume_specific(','))
+                    continue;
+                if (consume_specific('}'))
+                    break;
+                return syntax_error();
+            }
+        }
+
+        auto keys = m_key_stack.span().slice(key_base);
+        auto values = m_value_stack.span().slice(value_base);
+        auto object = create_object(keys, values);
+
+        m_key_stack.shrink(key_base, true);
+        m_value_stack.shrink(value_base, true);
+        return object;
+    }
+
+    GC::Ref<Object> create_object(ReadonlySpan<PropertyKey> keys, ReadonlySpan<Value> values)
+    {
+        if (keys.is_empty())
+            return Object::create(m_realm, m_realm.intrinsics().object_prototype());
+
+        auto& shape_template = m_shape_templates[shape_template_index(keys)];
+        if (shape_template.shape && shape_template.keys.span() == keys) {
+            auto object = Object::create_with_premade_shape(*shape_template.shape);
+            for (size_t i = 0; i < values.size(); ++i)
+                object->put_direct(i, values[i]);
+            return object;
+        }
+
+        auto object = Object::create(m_realm, m_realm.intrinsics().object_prototype());
+        for (size_t i = 0; i < keys.size(); ++i)
+            object->define_direct_property(keys[i], values[i], default_attributes);
+
+        // NOTE: Only objects whose properties all live in the shape, in the order of the keys, can share it that way.
+        //       Duplicate keys and integer keys break that, and so do dictionary shapes, which aren't shareable.
+        auto& shape = object->shape();
+        if (!shape.is_dictionary() && shape.property_count() == keys.size() && object->indexed_properties().is_empty()) {
+            shape_template.keys = Vector<PropertyKey> { keys };
+            shape_template.shape = shape;
+        }
+        return object;
+    }
+
+    static size_t shape_template_index(ReadonlySpan<PropertyKey> keys)
+    {
+        u32 hash = keys.size();
+        for (auto const& key : keys)
+            hash = pair_int_hash(hash, Traits<PropertyKey>::hash(key));
+        return hash % number_of_shape_templates;
+    }
+
+    ThrowCompletionOr<Value> parse_array()
+    {
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+        VERIFY(consume_specific('['));
+
+        auto value_base = m_value_stack.size();
+
+        skip_whitespace();
+        if (!consume_specific(']')) {
+            for (;;) {
+                m_value_stack.append(TRY(parse_value()));
+
+                skip_whitespace();
+                if (consume_specific(','))
+                    continue;
+                if (consume_specific(']'))
+                    break;
+                return syntax_error();
+            }
+        }
+
+        // OPTIMIZATION: We know all the elements up front, so we can hand the array its storage in one go instead of
+        //               growing it one element at a time.
+        auto array = MUST(Array::create(m_realm, 0));
+        auto elements = m_value_stack.span().slice(value_base);
+        if (!elements.is_empty())
+            array->indexed_properties() = IndexedProperties { Vector<Value> { elements } };
+
+        m_value_stack.shrink(value_base, true);
+        return array;
+    }
+
+    ThrowCompletionOr<Variant<String, Utf16String>> parse_string()
+    {
+        VERIFY(consume_specific('"'));
+
+        auto start = m_offset;
+        auto has_escapes = false;
+
+        for (;;) {
+            skip_plain_string_characters();
+            if (at_end())
+                return syntax_error();
+
+            auto ch = peek();
+            if (ch == '"')
+                break;
+            if (ch != '\\')
+                return syntax_error();
+
+            // Skip over the escape here, it is decoded below once we know where the string ends.
+            has_escapes = true;
+            ++m_offset;
+            if (at_end())
+                return syntax_error();
+            if (consume_specific('u')) {
+                for (size_t i = 0; i < 4; ++i) {
+                    if (at_end() || !is_ascii_hex_digit(peek()))
+                        return syntax_error();
+                    ++m_offset;
+                }
+                continue;
+            }
+            if (!"\"\\/bfnrt"sv.contains(peek()))
+                return syntax_error();
+            ++m_offset;
+        }
+
+        auto raw_string = m_text.substring_view(start, m_offset - start);
+        ++m_offset;
+
+        // NOTE: The text is a String, so it has already been validated as UTF-8 as a whole. Any run of it between two
+        //       ASCII characters is valid UTF-8 as well, and doesn't need to be validated again.
+        if (!has_escapes)
+            return String::from_utf8_without_validation(raw_string.bytes());
+
+        if (auto string = decode_escapes(raw_string); string.has_value())
+            return string.release_value();
+        return decode_escapes_to_utf16(raw_string);
+    }
+
+    // Returns an empty Optional if the string contains an escaped lone surrogate, which UTF-8 can't represent.
+    static Optional<String> decode_escapes(StringView raw_string)
+    {
+        StringBuilder builder(raw_string.length());
+
+        for (size_t i = 0; i < raw_string.length();) {
+            auto run_end = raw_string.find('\\', i).value_or(raw_string.length());
+            builder.append(raw_string.substring_view(i, run_end - i));
+            i = run_end;
+            if (i == raw_string.length())
+                break;
+
+            auto escape = raw_string[i + 1];
+            i += 2;
+            if (escape != 'u') {
+                builder.append(decode_simple_escape(escape));
+                continue;
+            }
+
+            u16 code_unit = parse_hex_code_unit(raw_string, i);
+            i += 4;
+            if (Utf16View::is_low_surrogate(code_unit))
+                return {};
+            if (!Utf16View::is_high_surrogate(code_unit)) {
+                builder.append_code_point(code_unit);
+                continue;
+            }
+            if (!raw_string.substring_view(i).starts_with("\\u"sv))
+                return {};
+            u16 low_surrogate = parse_hex_code_unit(raw_string, i + 2);
+            if (!Utf16View::is_low_surrogate(low_surrogate))
+                return {};
+            builder.append_code_point(Utf16View::decode_surrogate_pair(code_unit, low_surrogate));
+            i += 6;
+        }
+
+        return builder.to_string_without_validation();
+    }
+
+    static Utf16String decode_escapes_to_utf16(StringView raw_string)
+    {
+        Utf16Data code_units;
+        code_units.ensure_capacity(raw_string.length());
+
+        for (size_t i = 0; i < raw_string.length();) {
+            auto run_end = raw_string.find('\\', i).value_or(raw_string.length());
+            for (auto code_point : Utf8View { raw_string.substring_view(i, run_end - i) })
+                MUST(code_point_to_utf16(code_units, code_point));
+            i = run_end;
+            if (i == raw_string.length())
+                break;
+
+            auto escape = raw_string[i + 1];
+            i += 2;
+            if (escape != 'u') {
+                code_units.append(decode_simple_escape(escape));
+                continue;
+            }
+
+            code_units.append(parse_hex_code_unit(raw_string, i));
+            i += 4;
+        }
+
+        return Utf16String::create(move(code_units));
+    }
+
+    static char decode_simple_escape(char escape)
+    {
+        switch (escape) {
+        case 'b':
+            return '\b';
+        case 'f':
+            return '\f';
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 't':
+            return '\t';
+        default:
+            return escape;
+        }
+    }
+
+    static u16 parse_hex_code_unit(StringView raw_string, size_t offset)
+    {
+        u16 code_unit = 0;
+        for (size_t i = 0; i < 4; ++i)
+            code_unit = (code_unit << 4) | parse_ascii_hex_digit(raw_string[offset + i]);
+        return code_unit;
+    }
+
+    // Skips ahead to the next character in a string that needs a closer look, i.e. a quote, a backslash or a control
+    // character (which must be escaped in JSON).
+    void skip_plain_string_characters()
+    {
+        // OPTIMIZATION: Look at eight bytes at a time, as most strings are made up almost entirely of plain characters.
+        static constexpr u64 ones = 0x0101010101010101ull;
+        static constexpr u64 high_bits = 0x8080808080808080ull;
+        auto has_byte_less_than = [](u64 word, u8 byte) { return ((word - ones * byte) & ~word & high_bits) != 0; };
+        auto has_byte = [&](u64 word, u8 byte) { return has_byte_less_than(word ^ (ones * byte), 1); };
+
+        auto const* characters = m_text.characters_without_null_termination();
+        while (m_offset + sizeof(u64) <= m_text.length()) {
+            u64 word;
+            __builtin_memcpy(&word, characters + m_offset, sizeof(word));
+            if (has_byte(word, '"') || has_byte(word, '\\') || has_byte_less_than(word, 0x20))
+                break;
+            m_offset += sizeof(u64);
+        }
+
+        while (!at_end()) {
+            auto ch = static_cast<u8>(peek());
+            if (ch == '"' || ch == '\\' || ch < 0x20)
+                break;
+            ++m_offset;
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_number()
+    {
+        auto start = m_offset;
+        auto is_negative = consume_specific('-');
+
+        // OPTIMIZATION: Integers with up to 15 digits are exactly representable as doubles, so we can skip the general
+        //               floating point conversion for them.
+        u64 integer = 0;
+        size_t integer_digits = 0;
+
+        if (consume_specific('0')) {
+            integer_digits = 1;
+        } else {
+            if (at_end() || !is_ascii_digit(peek()))
+                return syntax_error();
+            for (; !at_end() && is_ascii_digit(peek()); ++m_offset, ++integer_digits)
+                integer = integer * 10 + parse_ascii_digit(peek());
+        }
+
+        auto is_integer = true;
+        if (consume_specific('.')) {
+            is_integer = false;
+            TRY(consume_digits());
+        }
+        if (consume_specific('e') || consume_specific('E')) {
+            is_integer = false;
+            if (!consume_specific('+'))
+                consume_specific('-');
+            TRY(consume_digits());
+        }
+
+        if (is_integer && integer_digits <= 15) {
+            auto value = static_cast<double>(integer);
+            return Value(is_negative ? -value : value);
+        }
+
+        auto number = m_text.substring_view(start, m_offset - start);
+        auto value = parse_floating_point_completely<double>(number.characters_without_null_termination(), number.characters_without_null_termination() + number.length());
+        if (!value.has_value())
+            return syntax_error();
+        return Value(value.value());
+    }
+
+    ThrowCompletionOr<void> consume_digits()
+    {
+        if (at_end() || !is_ascii_digit(peek()))
+            return syntax_error();
+        while (!at_end() && is_ascii_digit(peek()))
+            ++m_offset;
+        return {};
+    }
+
+    ThrowCompletionOr<void> consume_literal(StringView literal)
+    {
+        if (!m_text.substring_view(m_offset).starts_with(literal))
+            return syntax_error();
+        m_offset += literal.length();
+        return {};
+    }
+
+    void skip_whitespace()
+    {
+        while (!at_end()) {
+            auto ch = peek();
+            if (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r')
+                break;
+            ++m_offset;
+        }
+    }
+
+    bool consume_specific(char ch)
+    {
+        if (at_end() || peek() != ch)
+            return false;
+        ++m_offset;
+        return true;
+    }
+
+    bool at_end() const { return m_offset >= m_text.length(); }
+    char peek() const { return m_text[m_offset]; }
+
+    Completion syntax_error() const
+    {
+        return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+    }
+
+    VM& m_vm;
+    Realm& m_realm;
+    StringView m_text;
+    size_t m_offset { 0 };
+
+    // Values (and keys) of the arrays and objects currently being parsed. These are kept on shared stacks rather than
+    // in a vector per array or object, to avoid rooting a new vector for every one of them.
+    GC::RootVector<Value> m_value_stack;
+    Vector<PropertyKey> m_key_stack;
+
+    AK::Array<ShapeTemplate, number_of_shape_templates> m_shape_templates;
+};
+
 // 25.5.1.1 ParseJSON ( text ), https://tc39.es/ecma262/#sec-ParseJSON
 ThrowCompletionOr<Value> JSONObject::parse_json(VM& vm, StringView text)
 {
-    auto json = JsonValue::from_string(text);
-
     // 1. If StringToCodePoints(text) is not a valid JSON text as specified in ECMA-404, throw a SyntaxError exception.
-    if (json.is_error())
-        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-
     // 2. Let scriptString be the string-concatenation of "(", text, and ");".
     // 3. Let script be ParseText(scriptString, Script).
     // 4. NOTE: The early error rules defined in 13.2.5.1 have special handling for the above invocation of ParseText.
     // 5. Assert: script is a Parse Node.
     // 6. Let result be ! Evaluation of script.
-    auto result = JSONObject::parse_json_value(vm, json.value());
+    // NOTE: We validate and evaluate the text in a single pass, which throws the SyntaxError for step 1 as it goes.
+    auto result = TRY(JSONTextParser(vm, text).parse());
 
     // 7. NOTE: The PropertyDefinitionEvaluation semantics defined in 13.2.5.5 have special handling for the above evaluation.
     // 8. Assert: result is either a String, a Number, a Boolean, an Object that is defined by either an ArrayLiteral or an ObjectLiteral, or null.
@@ -564,11 +1003,8 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::raw_json)
     // 3. Parse StringToCodePoints(jsonString) as a JSON text as specified in ECMA-404. Throw a SyntaxError exception
     //    if it is not a valid JSON text as defined in that specification, or if its outermost value is an object or
     //    array as defined in that specification.
-    auto json = JsonValue::from_string(json_string);
-    if (json.is_error())
-        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-
-    if (json.value().is_object() || json.value().is_array())
+    auto json = TRY(JSONTextParser(vm, json_string).parse());
+    if (json.is_object())
         return vm.throw_completion<SyntaxError>(ErrorType::JsonRawJSONNonPrimitive);
 
     // 4. Let internalSlotsList be « [[IsRawJSON]] ».
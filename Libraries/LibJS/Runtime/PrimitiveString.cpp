@@ -10,6 +10,7 @@
 #include <AK/StringBuilder.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
+#include <LibGC/RootVector.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
@@ -22,10 +23,25 @@ namespace JS {
 GC_DEFINE_ALLOCATOR(PrimitiveString);
 GC_DEFINE_ALLOCATOR(RopeString);
 
+// Ropes deeper than this are rebalanced before being accessed without flattening them.
+static constexpr u32 max_rope_depth_for_access = 64;
+
+// A rope that has been accessed this many times without flattening it is flattened after all, since that makes any
+// further accesses cheaper. Ropes that are appended to between accesses are new ropes every time, and never get here.
+static constexpr u8 rope_accesses_before_flattening = 16;
+
+// When rebalancing, runs of leaves shorter than short_rope_leaf_length are coalesced into flat strings of up to
+// coalesced_rope_leaf_length code units, so that a rope built from many small pieces doesn't stay expensive to rebalance.
+static constexpr size_t short_rope_leaf_length = 128;
+static constexpr size_t coalesced_rope_leaf_length = 1024;
+
+static u32 rope_depth(PrimitiveString const& string);
+
 RopeString::RopeString(GC::Ref<PrimitiveString> lhs, GC::Ref<PrimitiveString> rhs)
     : PrimitiveString(RopeTag::Rope)
     , m_lhs(lhs)
     , m_rhs(rhs)
+    , m_depth(max(rope_depth(lhs), rope_depth(rhs)) + 1)
 {
 }
 
@@ -108,9 +124,56 @@ Utf16View PrimitiveString::utf16_string_view() const
 
 size_t PrimitiveString::length_in_utf16_code_units() const
 {
+    if (m_is_rope)
+        return static_cast<RopeString const&>(*this).rope_length_in_utf16_code_units();
     return utf16_string_view().length_in_code_units();
 }
 
+u16 PrimitiveString::code_unit_at(size_t index) const
+{
+    if (m_is_rope) {
+        auto const& rope = static_cast<RopeString const&>(*this);
+        if (rope.should_access_without_flattening())
+            return rope.rope_code_unit_at(index);
+    }
+    return utf16_string_view().code_unit_at(index);
+}
+
+Utf16String PrimitiveString::utf16_substring(size_t start, size_t length) const
+{
+    if (m_is_rope) {
+        auto const& rope = static_cast<RopeString const&>(*this);
+        if (rope.should_access_without_flattening()) {
+            Utf16Data code_units;
+            code_units.ensure_capacity(length);
+            rope.for_each_utf16_view_in_range(start, length, [&](Utf16View const& view) {
+                code_units.append(view.data(), view.length_in_code_units());
+                return IterationDecision::Continue;
+            });
+            return Utf16String::create(move(code_units));
+        }
+    }
+    return Utf16String::create(utf16_string_view().substring_view(start, length));
+}
+
+bool PrimitiveString::has_utf16_substring_at(size_t start, Utf16View const& substring) const
+{
+    if (m_is_rope) {
+        auto const& rope = static_cast<RopeString const&>(*this);
+        if (rope.should_access_without_flattening()) {
+            bool equal = true;
+            size_t offset = 0;
+            rope.for_each_utf16_view_in_range(start, substring.length_in_code_units(), [&](Utf16View const& view) {
+                equal = view == substring.substring_view(offset, view.length_in_code_units());
+                offset += view.length_in_code_units();
+                return equal ? IterationDecision::Continue : IterationDecision::Break;
+            });
+            return equal;
+        }
+    }
+    return utf16_string_view().substring_view(start, substring.length_in_code_units()) == substring;
+}
+
 bool PrimitiveString::operator==(PrimitiveString const& other) const
 {
     if (this == &other)
@@ -134,11 +197,10 @@ ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey cons
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
         return Optional<Value> {};
-    auto str = utf16_string_view();
-    auto length = str.length_in_code_units();
-    if (length <= index.as_index())
+    if (length_in_utf16_code_units() <= index.as_index())
         return Optional<Value> {};
-    return create(vm, Utf16String::create(str.substring_view(index.as_index(), 1)));
+    auto code_unit = code_unit_at(index.as_index());
+    return create(vm, Utf16String::create(Utf16View { ReadonlySpan<u16> { &code_unit, 1 } }));
 }
 
 GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, Utf16String string)
@@ -252,8 +314,11 @@ void RopeString::resolve(EncodingPreference preference) const
         // into a UTF-16 code unit buffer and create a Utf16String from it.
 
         Utf16Data code_units;
-        for (auto const* current : pieces)
-            code_units.extend(current->utf16_string().string());
+        code_units.ensure_capacity(rope_length_in_utf16_code_units());
+        for (auto const* current : pieces) {
+            auto view = current->utf16_string_view();
+            code_units.unchecked_append(view.data(), view.length_in_code_units());
+        }
 
         m_utf16_string = Utf16String::create(move(code_units));
         m_is_rope = false;
@@ -330,4 +395,171 @@ void RopeString::resolve(EncodingPreference preference) const
     m_rhs = nullptr;
 }
 
+static u32 rope_depth(PrimitiveString const& string)
+{
+    if (!string.is_rope())
+        return 0;
+    return static_cast<RopeString const&>(string).depth();
+}
+
+// Returns the length of a flat string, without converting it to UTF-16 just for that.
+static size_t flat_length_in_utf16_code_units(PrimitiveString const& string)
+{
+    if (string.has_utf16_string())
+        return string.utf16_string_view().length_in_code_units();
+    return AK::utf16_code_unit_length_from_utf8(string.utf8_string_view());
+}
+
+size_t RopeString::rope_length_in_utf16_code_units() const
+{
+    if (m_length_in_utf16_code_units.has_value())
+        return *m_length_in_utf16_code_units;
+
+    auto length_if_known = [](PrimitiveString const& string) -> Optional<size_t> {
+        if (!string.is_rope())
+            return flat_length_in_utf16_code_units(string);
+        return static_cast<RopeString const&>(string).m_length_in_utf16_code_units;
+    };
+
+    // NOTE: We traverse the rope tree without using recursion, for the same reason as in resolve(). Every rope on
+    //       the way caches its own length, so this only ever visits the part of the tree that's new.
+    Vector<RopeString const*> stack;
+    stack.append(this);
+    while (!stack.is_empty()) {
+        auto const& current = *stack.last();
+        auto lhs_length = length_if_known(*current.m_lhs);
+        auto rhs_length = length_if_known(*current.m_rhs);
+        if (!lhs_length.has_value())
+            stack.append(static_cast<RopeString const*>(current.m_lhs.ptr()));
+        if (!rhs_length.has_value())
+            stack.append(static_cast<RopeString const*>(current.m_rhs.ptr()));
+        if (lhs_length.has_value() && rhs_length.has_value()) {
+            current.m_length_in_utf16_code_units = *lhs_length + *rhs_length;
+            stack.take_last();
+        }
+    }
+    return *m_length_in_utf16_code_units;
+}
+
+bool RopeString::should_access_without_flattening() const
+{
+    if (m_access_count >= rope_accesses_before_flattening)
+        return false;
+    ++m_access_count;
+
+    if (m_depth > max_rope_depth_for_access)
+        rebalance();
+    return m_is_rope && m_depth <= max_rope_depth_for_access;
+}
+
+void RopeString::rebalance() const
+{
+    auto& heap = this->heap();
+
+    // Collect the leaves of the rope in order, coalescing runs of short leaves into new flat strings.
+    GC::RootVector<GC::Ref<PrimitiveString>> leaves(heap);
+    Utf16Data pending_code_units;
+    auto flush_pending_code_units = [&] {
+        if (pending_code_units.is_empty())
+            return;
+        leaves.append(heap.allocate<PrimitiveString>(Utf16String::create(move(pending_code_units))));
+        pending_code_units.clear();
+    };
+
+    Vector<PrimitiveString*> stack;
+    stack.append(m_rhs);
+    stack.append(m_lhs);
+    while (!stack.is_empty()) {
+        auto* current = stack.take_last();
+        if (current->m_is_rope) {
+            auto& current_rope_string = static_cast<RopeString&>(*current);
+            stack.append(current_rope_string.m_rhs);
+            stack.append(current_rope_string.m_lhs);
+            continue;
+        }
+
+        if (flat_length_in_utf16_code_units(*current) >= short_rope_leaf_length) {
+            flush_pending_code_units();
+            leaves.append(*current);
+            continue;
+        }
+
+        auto view = current->utf16_string_view();
+        pending_code_units.append(view.data(), view.length_in_code_units());
+        if (pending_code_units.size() >= coalesced_rope_leaf_length)
+            flush_pending_code_units();
+    }
+    flush_pending_code_units();
+
+    // If everything ended up in a single leaf, the rope was short enough to simply be flattened.
+    if (leaves.size() < 2) {
+        resolve(EncodingPreference::UTF16);
+        return;
+    }
+
+    auto build_balanced_rope = [&](auto& self, size_t begin, size_t end) -> GC::Ref<PrimitiveString> {
+        if (end - begin == 1)
+            return leaves[begin];
+        auto middle = begin + (end - begin) / 2;
+        auto lhs = self(self, begin, middle);
+        auto rhs = self(self, middle, end);
+        return heap.allocate<RopeString>(lhs, rhs);
+    };
+
+    auto middle = leaves.size() / 2;
+    auto lhs = build_balanced_rope(build_balanced_rope, 0, middle);
+    auto rhs = build_balanced_rope(build_balanced_rope, middle, leaves.size());
+    m_lhs = lhs;
+    m_rhs = rhs;
+    did_store_edge();
+    m_depth = max(rope_depth(lhs), rope_depth(rhs)) + 1;
+}
+
+u16 RopeString::rope_code_unit_at(size_t index) const
+{
+    PrimitiveString const* current = this;
+    while (current->m_is_rope) {
+        auto const& current_rope_string = static_cast<RopeString const&>(*current);
+        auto lhs_length = current_rope_string.m_lhs->length_in_utf16_code_units();
+        if (index < lhs_length) {
+            current = current_rope_string.m_lhs;
+        } else {
+            index -= lhs_length;
+            current = current_rope_string.m_rhs;
+        }
+    }
+    return current->utf16_string_view().code_unit_at(index);
+}
+
+template<typename Callback>
+void RopeString::for_each_utf16_view_in_range(size_t start, size_t length, Callback callback) const
+{
+    struct Piece {
+        PrimitiveString const* string;
+        size_t offset;
+    };
+
+    auto end = start + length;
+    Vector<Piece, 32> stack;
+    stack.append({ this, 0 });
+    while (!stack.is_empty()) {
+        auto [current, offset] = stack.take_last();
+        if (current->m_is_rope) {
+            auto const& current_rope_string = static_cast<RopeString const&>(*current);
+            auto rhs_offset = offset + current_rope_string.m_lhs->length_in_utf16_code_units();
+            if (rhs_offset < end)
+                stack.append({ current_rope_string.m_rhs, rhs_offset });
+            if (start < rhs_offset)
+                stack.append({ current_rope_string.m_lhs, offset });
+            continue;
+        }
+
+        auto view = current->utf16_string_view();
+        auto view_start = max(start, offset) - offset;
+        auto view_end = min(end, offset + view.length_in_code_units()) - offset;
+        if (callback(view.substring_view(view_start, view_end - view_start)) == IterationDecision::Break)
+            return;
+    }
+}
+
 }
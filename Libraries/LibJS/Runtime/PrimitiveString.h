@@ -22,6 +22,7 @@ namespace JS {
 class PrimitiveString : public Cell {
     GC_CELL(PrimitiveString, Cell);
     GC_DECLARE_ALLOCATOR(PrimitiveString);
+    GC_DECLARE_WRITE_BARRIER(PrimitiveString);
 
 public:
     [[nodiscard]] static GC::Ref<PrimitiveString> create(VM&, Utf16String);
@@ -36,6 +37,7 @@ public:
     PrimitiveString& operator=(PrimitiveString const&) = delete;
 
     bool is_empty() const;
+    bool is_rope() const { return m_is_rope; }
 
     [[nodiscard]] String utf8_string() const;
     [[nodiscard]] StringView utf8_string_view() const;
@@ -47,6 +49,12 @@ public:
 
     size_t length_in_utf16_code_units() const;
 
+    // These don't flatten rope strings, so that code which builds a string piece by piece can look at it in between
+    // without flattening it again and again.
+    [[nodiscard]] u16 code_unit_at(size_t index) const;
+    [[nodiscard]] Utf16String utf16_substring(size_t start, size_t length) const;
+    [[nodiscard]] bool has_utf16_substring_at(size_t start, Utf16View const&) const;
+
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
     [[nodiscard]] bool operator==(PrimitiveString const&) const;
@@ -80,10 +88,13 @@ private:
 class RopeString final : public PrimitiveString {
     GC_CELL(RopeString, PrimitiveString);
     GC_DECLARE_ALLOCATOR(RopeString);
+    GC_DECLARE_WRITE_BARRIER(RopeString);
 
 public:
     virtual ~RopeString() override;
 
+    u32 depth() const { return m_depth; }
+
 private:
     friend class PrimitiveString;
 
@@ -93,8 +104,22 @@ private:
 
     void resolve(EncodingPreference) const;
 
+    size_t rope_length_in_utf16_code_units() const;
+
+    // Returns false if the rope should rather be flattened, either because it has been accessed often enough that
+    // flattening pays off, or because it's too deep even after rebalancing.
+    bool should_access_without_flattening() const;
+    void rebalance() const;
+
+    u16 rope_code_unit_at(size_t index) const;
+    template<typename Callback>
+    void for_each_utf16_view_in_range(size_t start, size_t length, Callback) const;
+
     mutable GC::Ptr<PrimitiveString> m_lhs;
     mutable GC::Ptr<PrimitiveString> m_rhs;
+    mutable Optional<size_t> m_length_in_utf16_code_units;
+    mutable u32 m_depth { 0 };
+    mutable u8 m_access_count { 0 };
 };
 
 }
@@ -258,7 +258,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::at)
         return js_undefined();
 
     // 7. Return ? Get(O, ! ToString(𝔽(k))).
-    return PrimitiveString::create(vm, Utf16String::create(string->utf16_string_view().substring_view(index.value(), 1)));
+    return PrimitiveString::create(vm, string->utf16_substring(index.value(), 1));
 }
 
 // 22.1.3.2 String.prototype.charAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charat
@@ -277,7 +277,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_at)
         return PrimitiveString::create(vm, String {});
 
     // 6. Return the substring of S from position to position + 1.
-    return PrimitiveString::create(vm, Utf16String::create(string->utf16_string_view().substring_view(position, 1)));
+    return PrimitiveString::create(vm, string->utf16_substring(position, 1));
 }
 
 // 22.1.3.3 String.prototype.charCodeAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charcodeat
@@ -296,7 +296,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_code_at)
         return js_nan();
 
     // 6. Return the Number value for the numeric value of the code unit at index position within the String S.
-    return Value(string->utf16_string_view().code_unit_at(position));
+    return Value(string->code_unit_at(position));
 }
 
 // 22.1.3.4 String.prototype.codePointAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.codepointat
@@ -310,12 +310,16 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::code_point_at)
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
 
     // 4. Let size be the length of S.
+    auto size = string->length_in_utf16_code_units();
+
     // 5. If position < 0 or position ≥ size, return undefined.
-    if (position < 0 || position >= string->length_in_utf16_code_units())
+    if (position < 0 || position >= size)
         return js_undefined();
 
     // 6. Let cp be CodePointAt(S, position).
-    auto code_point = JS::code_point_at(string->utf16_string_view(), position);
+    // NOTE: A code point consists of at most two code units, so that's all we look at.
+    auto code_units = string->utf16_substring(position, min<size_t>(2, size - position));
+    auto code_point = JS::code_point_at(code_units.view(), 0);
 
     // 7. Return 𝔽(cp.[[CodePoint]]).
     return Value(code_point.code_point);
@@ -393,11 +397,9 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::ends_with)
     size_t start = end - search_length;
 
     // 13. Let substring be the substring of S from start to end.
-    auto substring_view = string->utf16_string_view().substring_view(start, end - start);
-
     // 14. If substring is searchStr, return true.
     // 15. Return false.
-    return Value(substring_view == search_string->utf16_string_view());
+    return Value(string->has_utf16_substring_at(start, search_string->utf16_string_view()));
 }
 
 // 22.1.3.8 String.prototype.includes ( searchString [ , position ] ), https://tc39.es/ecma262/#sec-string.prototype.includes
@@ -1045,7 +1047,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::slice)
         return PrimitiveString::create(vm, String {});
 
     // 13. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string->utf16_string_view().substring_view(int_start, int_end - int_start)));
+    return PrimitiveString::create(vm, string->utf16_substring(int_start, int_end - int_start));
 }
 
 // 22.1.3.23 String.prototype.split ( separator, limit ), https://tc39.es/ecma262/#sec-string.prototype.split
@@ -1198,11 +1200,9 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::starts_with)
         return Value(false);
 
     // 13. Let substring be the substring of S from start to end.
-    auto substring_view = string->utf16_string_view().substring_view(start, end - start);
-
     // 14. If substring is searchStr, return true.
     // 15. Return false.
-    return Value(substring_view == search_string->utf16_string_view());
+    return Value(string->has_utf16_substring_at(start, search_string->utf16_string_view()));
 }
 
 // 22.1.3.25 String.prototype.substring ( start, end ), https://tc39.es/ecma262/#sec-string.prototype.substring
@@ -1236,7 +1236,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
     size_t to = max(final_start, final_end);
 
     // 10. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string->utf16_string_view().substring_view(from, to - from)));
+    return PrimitiveString::create(vm, string->utf16_substring(from, to - from));
 }
 
 enum class TargetCase {
@@ -1506,7 +1506,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substr)
         return PrimitiveString::create(vm, String {});
 
     // 11. Return the substring of S from intStart to intEnd.
-    return PrimitiveString::create(vm, Utf16String::create(string->utf16_string_view().substring_view(int_start, int_end - int_start)));
+    return PrimitiveString::create(vm, string->utf16_substring(int_start, int_end - int_start));
 }
 
 // B.2.2.2.1 CreateHTML ( string, tag, attribute, value ), https://tc39.es/ecma262/#sec-createhtml
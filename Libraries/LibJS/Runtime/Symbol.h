@@ -16,6 +16,7 @@ namespace JS {
 class Symbol final : public Cell {
     GC_CELL(Symbol, Cell);
     GC_DECLARE_ALLOCATOR(Symbol);
+    GC_DECLARE_WRITE_BARRIER(Symbol);
 
 public:
     [[nodiscard]] static GC::Ref<Symbol> create(VM&, Optional<String> description, bool is_global);
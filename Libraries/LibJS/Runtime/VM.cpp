@@ -71,6 +71,10 @@ VM::VM(ErrorMessages error_messages)
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
 
+    m_heap.set_gather_precisely_scanned_stack_ranges([this](Vector<GC::Heap::StackRange>& ranges) {
+        gather_precisely_scanned_stack_ranges(ranges);
+    });
+
     m_empty_string = m_heap.allocate<PrimitiveString>(String {});
 
     cached_strings = {
@@ -214,7 +218,7 @@ String const& VM::error_message(ErrorMessage type) const
     return message;
 }
 
-struct ExecutionContextRootsCollector : public Cell::Visitor {
+struct VMRootsCollector : public Cell::Visitor {
     virtual void visit_impl(GC::Cell& cell) override
     {
         roots.set(&cell);
@@ -257,7 +261,7 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
 
     auto gather_roots_from_execution_context_stack = [&roots](Vector<ExecutionContext*> const& stack) {
         for (auto const& execution_context : stack) {
-            ExecutionContextRootsCollector visitor;
+            VMRootsCollector visitor;
             execution_context->visit_edges(visitor);
             for (auto cell : visitor.roots)
                 roots.set(cell, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
@@ -269,6 +273,29 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
 
     for (auto& job : m_promise_jobs)
         roots.set(job, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+
+    VMRootsCollector interpreter_visitor;
+    m_bytecode_interpreter->visit_edges(interpreter_visitor);
+    for (auto cell : interpreter_visitor.roots)
+        roots.set(cell, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+}
+
+void VM::gather_precisely_scanned_stack_ranges(Vector<GC::Heap::StackRange>& ranges)
+{
+    // Every ExecutionContext on an execution context stack is visited by gather_roots(), including its registers,
+    // constants, locals and arguments. Most of them live on the native stack, so there's no need to scan them again.
+    auto gather_ranges_from_execution_context_stack = [&ranges](Vector<ExecutionContext*> const& stack) {
+        for (auto* execution_context : stack) {
+            auto values = execution_context->registers_and_constants_and_locals_and_arguments_span();
+            ranges.append({
+                .start = bit_cast<FlatPtr>(execution_context),
+                .end = bit_cast<FlatPtr>(values.data() + values.size()),
+            });
+        }
+    };
+    gather_ranges_from_execution_context_stack(m_execution_context_stack);
+    for (auto& saved_stack : m_saved_execution_context_stacks)
+        gather_ranges_from_execution_context_stack(saved_stack);
 }
 
 // 9.1.2.1 GetIdentifierReference ( env, name, strict ), https://tc39.es/ecma262/#sec-getidentifierreference
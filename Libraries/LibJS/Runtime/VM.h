@@ -58,6 +58,7 @@ public:
     void dump_backtrace() const;
 
     void gather_roots(HashMap<GC::Cell*, GC::HeapRoot>&);
+    void gather_precisely_scanned_stack_ranges(Vector<GC::Heap::StackRange>&);
 
 #define __JS_ENUMERATE(SymbolName, snake_name)             \
     GC::Ref<Symbol> well_known_symbol_##snake_name() const \
@@ -0,0 +1,68 @@
+describe("packed arrays", () => {
+    test("default sort of integers orders them as strings", () => {
+        const a = [10, 9, 1, -1, -10, 0, 100, -2147483648, 2147483647, 2, 20];
+        expect(a.sort()).toBe(a);
+        expect(a).toEqual([-1, -10, -2147483648, 0, 1, 10, 100, 2, 20, 2147483647, 9]);
+    });
+
+    test("indexOf and includes with numbers", () => {
+        const integers = [1, 2, 3, 2];
+        expect(integers.indexOf(2)).toBe(1);
+        expect(integers.indexOf(2, 2)).toBe(3);
+        expect(integers.indexOf(2.0)).toBe(1);
+        expect(integers.indexOf("2")).toBe(-1);
+        expect(integers.includes(3)).toBeTrue();
+        expect(integers.includes("3")).toBeFalse();
+
+        const numbers = [1.5, NaN, -0];
+        expect(numbers.indexOf(1.5)).toBe(0);
+        expect(numbers.indexOf(NaN)).toBe(-1);
+        expect(numbers.indexOf(0)).toBe(2);
+        expect(numbers.includes(NaN)).toBeTrue();
+        expect(numbers.includes(0)).toBeTrue();
+    });
+
+    test("fill only overwrites existing elements", () => {
+        const a = [1, 2, 3, 4];
+        expect(a.fill("x", 1, 3)).toEqual([1, "x", "x", 4]);
+        expect(a.indexOf("x")).toBe(1);
+        expect(a.includes(2)).toBeFalse();
+    });
+
+    test("map sees changes made by the callback", () => {
+        const a = [1, 2, 3, 4];
+        const result = a.map((value, index) => {
+            if (index === 0) a.pop();
+            return value * 2;
+        });
+        expect(result).toHaveLength(4);
+        expect(result[2]).toBe(6);
+        expect(3 in result).toBeFalse();
+    });
+});
+
+describe("holey arrays", () => {
+    test("holes are looked up on the prototype chain", () => {
+        const a = [1, 2, 3];
+        delete a[1];
+        Array.prototype[1] = 5;
+        try {
+            expect(a.indexOf(5)).toBe(1);
+            expect(a.includes(5)).toBeTrue();
+            expect(a.map(x => x)).toEqual([1, 5, 3]);
+        } finally {
+            delete Array.prototype[1];
+        }
+    });
+
+    test("growing an array with length makes it holey", () => {
+        const a = [3, 1, 2];
+        a.length = 5;
+        a.sort();
+        expect(a).toHaveLength(5);
+        expect(a.slice(0, 3)).toEqual([1, 2, 3]);
+        expect(3 in a).toBeFalse();
+        expect(a.indexOf(undefined)).toBe(-1);
+        expect(a.includes(undefined)).toBeTrue();
+    });
+});
@@ -74,3 +74,60 @@ test("does not truncate large integers", () => {
     expect(JSON.parse("18446744073709551616")).toEqual(18446744073709551616);
     expect(JSON.parse("18446744073709551617")).toEqual(18446744073709551617);
 });
+
+test("strings", () => {
+    expect(JSON.parse('"\\"\\\\\\/\\b\\f\\n\\r\\t"')).toBe('"\\/\b\f\n\r\t');
+    expect(JSON.parse('"\\u0041\\u00e9\\u4e2d"')).toBe("Aé中");
+    expect(JSON.parse('"a long string without any escapes in it, ü"')).toBe("a long string without any escapes in it, ü");
+    expect(JSON.parse('"\\ud83d\\ude00"')).toBe("😀");
+    expect(JSON.parse('"\\ud83d"')).toBe("\ud83d");
+    expect(JSON.parse('"x\\ude00y"')).toHaveLength(3);
+    expect(JSON.parse('"x\\ude00y"').charCodeAt(1)).toBe(0xde00);
+
+    ['"\\x41"', '"\\u12"', '"unterminated', '"tab\tin string"', '"new\nline"'].forEach(text => {
+        expect(() => JSON.parse(text)).toThrow(SyntaxError);
+    });
+});
+
+test("numbers", () => {
+    expect(JSON.parse("[0, -1, 1.5, -1.5e3, 2E-2, 1e+2, 123456789012345]")).toEqual([
+        0, -1, 1.5, -1500, 0.02, 100, 123456789012345,
+    ]);
+
+    ["01", "-", "1.", ".5", "1e", "+1", "- 1", "0x10"].forEach(text => {
+        expect(() => JSON.parse(text)).toThrow(SyntaxError);
+    });
+});
+
+test("objects", () => {
+    const object = JSON.parse('{"b": 1, "a": 2, "b": 3, "0": 4, "__proto__": 5}');
+    expect(Object.keys(object)).toEqual(["0", "b", "a", "__proto__"]);
+    expect(object.b).toBe(3);
+    expect(object[0]).toBe(4);
+    expect(Object.getPrototypeOf(object)).toBe(Object.prototype);
+    expect(Object.getOwnPropertyDescriptor(object, "__proto__").value).toBe(5);
+});
+
+test("objects with the same keys", () => {
+    const records = JSON.parse('[{"x": 1, "y": 2}, {"x": 3, "y": 4}, {"y": 5, "x": 6}, {"x": 7, "y": 8, "x": 9}]');
+    expect(records).toEqual([{ x: 1, y: 2 }, { x: 3, y: 4 }, { y: 5, x: 6 }, { x: 9, y: 8 }]);
+    expect(Object.keys(records[2])).toEqual(["y", "x"]);
+
+    records[0].z = 1;
+    delete records[1].x;
+    expect(Object.keys(records[0])).toEqual(["x", "y", "z"]);
+    expect(Object.keys(records[1])).toEqual(["y"]);
+    expect(Object.keys(JSON.parse('{"x": 1, "y": 2}'))).toEqual(["x", "y"]);
+});
+
+test("arrays", () => {
+    const array = JSON.parse("[1, [2, [3]], {}, []]");
+    expect(array).toHaveLength(4);
+    expect(array).toEqual([1, [2, [3]], {}, []]);
+    array.push(5);
+    expect(array[4]).toBe(5);
+});
+
+test("deeply nested arrays", () => {
+    expect(() => JSON.parse("[".repeat(1000000) + "]".repeat(1000000))).toThrow(InternalError);
+});
@@ -0,0 +1,56 @@
+// NOTE: These build strings piece by piece and look at them after every append. Before ropes could be accessed
+//       without flattening them, this took quadratic time, so these double as a benchmark for that.
+
+const iterations = 20000;
+
+test("charCodeAt, charAt and at between appends", () => {
+    let s = "";
+    let sum = 0;
+    for (let i = 0; i < iterations; ++i) {
+        s += String.fromCharCode(97 + (i % 26)) + "-";
+        sum += s.charCodeAt(s.length - 2) + s.charCodeAt(i);
+        expect(s.charAt(0)).toBe("a");
+        expect(s.at(-1)).toBe("-");
+        expect(s[2 * i]).toBe(String.fromCharCode(97 + (i % 26)));
+    }
+    expect(s).toHaveLength(2 * iterations);
+    expect(sum).toBeGreaterThan(0);
+});
+
+test("slice, substring and startsWith between appends", () => {
+    let s = "start:";
+    for (let i = 0; i < iterations; ++i) {
+        s += i + ",";
+        expect(s.startsWith("start:0,")).toBeTrue();
+        expect(s.endsWith(i + ",")).toBeTrue();
+        expect(s.slice(-(String(i).length + 1))).toBe(i + ",");
+        expect(s.substring(0, 6)).toBe("start:");
+    }
+    expect(s.slice(6, 10)).toBe("0,1,");
+    expect(s.substr(s.length - 6)).toBe("19999,");
+});
+
+test("code units split across rope pieces", () => {
+    const smile = "😀";
+    let s = "";
+    for (let i = 0; i < 1000; ++i) {
+        s += smile[0];
+        s += smile[1];
+    }
+    expect(s.codePointAt(0)).toBe(0x1f600);
+    expect(s.codePointAt(1)).toBe(0xde00);
+    expect(s.slice(1, 3)).toBe(smile[1] + smile[0]);
+    expect(s.startsWith(smile + smile)).toBeTrue();
+    expect(s).toBe(smile.repeat(1000));
+});
+
+test("deep ropes from many small pieces", () => {
+    let s = "";
+    for (let i = 0; i < iterations; ++i) s += "x";
+    s += "y";
+    for (let i = 0; i < iterations; ++i) s = "z" + s;
+    expect(s.charAt(iterations)).toBe("x");
+    expect(s.charAt(2 * iterations)).toBe("y");
+    expect(s.slice(iterations - 1, iterations + 1)).toBe("zx");
+    expect(s.indexOf("y")).toBe(2 * iterations);
+});
@@ -0,0 +1,118 @@
+test("copies are not propagated past a write to their source", () => {
+    let a = 1;
+    let b = a;
+    a = 2;
+    expect(b).toBe(1);
+    expect(a).toBe(2);
+
+    let c = a;
+    a++;
+    expect(c).toBe(2);
+    expect(a).toBe(3);
+
+    let s = "x";
+    let t = s;
+    s += "y";
+    expect(t).toBe("x");
+    expect(s).toBe("xy");
+});
+
+test("swapping through temporaries", () => {
+    let a = 1;
+    let b = 2;
+    [a, b] = [b, a];
+    expect(a).toBe(2);
+    expect(b).toBe(1);
+
+    let tmp = a;
+    a = b;
+    b = tmp;
+    expect(a).toBe(1);
+    expect(b).toBe(2);
+});
+
+test("constant folding matches runtime semantics", () => {
+    expect(1 + 2).toBe(3);
+    expect(0x7fffffff + 1).toBe(2147483648);
+    expect(-0x80000000 - 1).toBe(-2147483649);
+    expect(1 / 0).toBe(Infinity);
+    expect(0 / 0).toBeNaN();
+    expect(-(0)).toBe(-0);
+    expect(+true).toBe(1);
+    expect(~5).toBe(-6);
+    expect(2 ** 10).toBe(1024);
+    expect(-7 % 3).toBe(-1);
+    expect(1 << 31).toBe(-2147483648);
+    expect(-1 >>> 0).toBe(4294967295);
+    expect(-16 >> 2).toBe(-4);
+    expect(null + 1).toBe(1);
+    expect(undefined + 1).toBeNaN();
+    expect(null == undefined).toBeTrue();
+    expect(null === undefined).toBeFalse();
+    expect(NaN === NaN).toBeFalse();
+    expect(1 < 2).toBeTrue();
+    expect(2 <= 1).toBeFalse();
+    expect(!0).toBeTrue();
+    expect(!null).toBeTrue();
+    expect("1" + 2).toBe("12");
+});
+
+test("constant conditions", () => {
+    let taken = [];
+    if (true) taken.push("if");
+    else taken.push("else");
+    if (0) taken.push("zero");
+    if (1 < 2) taken.push("less");
+    if (null ?? true) taken.push("nullish");
+    while (false) taken.push("while");
+    expect(taken).toEqual(["if", "less", "nullish"]);
+
+    function f(x = undefined) {
+        return x ?? "default";
+    }
+    expect(f()).toBe("default");
+    expect(f(1)).toBe(1);
+});
+
+test("loops and labelled jumps", () => {
+    let count = 0;
+    outer: for (let i = 0; i < 5; ++i) {
+        for (let j = 0; j < 5; ++j) {
+            if (j === 3) continue outer;
+            if (i === 4) break outer;
+            ++count;
+        }
+    }
+    expect(count).toBe(12);
+
+    let i = 0;
+    do {} while (++i < 10);
+    expect(i).toBe(10);
+});
+
+test("empty try and finally blocks", () => {
+    let log = [];
+    try {
+    } finally {
+        log.push("finally");
+    }
+    for (let i = 0; i < 2; ++i) {
+        try {
+            continue;
+        } finally {
+            log.push(i);
+        }
+    }
+    expect(log).toEqual(["finally", 0, 1]);
+});
+
+test("generators keep their values across yields", () => {
+    function* gen() {
+        let a = 1;
+        let b = a;
+        yield b;
+        a = 2;
+        yield b + a;
+    }
+    expect([...gen()]).toEqual([1, 3]);
+});
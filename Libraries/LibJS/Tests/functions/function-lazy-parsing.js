@@ -0,0 +1,100 @@
+// NOTE: These are most useful when run with `test-js --lazy-functions`, where nested function bodies are parsed
+//       again from the original source on their first call.
+
+const prefix = "äöü — 🎉";
+
+test("nested functions after non-ASCII source text", () => {
+    function outer(value) {
+        const label = "ß✓";
+        function inner(x) {
+            return `${label}:${x * 2}`;
+        }
+        return inner(value);
+    }
+    expect(outer(21)).toBe("ß✓:42");
+    expect(prefix.length).toBe(8);
+});
+
+test("source text of nested functions", () => {
+    function outer() {
+        return function inner(a, b) {
+            return "ü" + (a + b);
+        };
+    }
+    const inner = outer();
+    expect(inner.toString()).toBe('function inner(a, b) {\n            return "ü" + (a + b);\n        }');
+    expect(inner(1, 2)).toBe("ü3");
+    expect(outer.toString().startsWith("function outer() {")).toBeTrue();
+    expect(outer.toString().endsWith("}")).toBeTrue();
+});
+
+test("closures over enclosing bindings", () => {
+    let counter = 0;
+    function make() {
+        return () => ++counter;
+    }
+    const increment = make();
+    increment();
+    increment();
+    expect(counter).toBe(2);
+});
+
+test("arrow functions and methods", () => {
+    const object = {
+        twice(x) {
+            return [1, 2].map(n => n * x);
+        },
+    };
+    expect(object.twice(5)).toEqual([5, 10]);
+});
+
+test("names only referenced from a pre-parsed body", () => {
+    function outer() {
+        let hidden = 1;
+        const shadowed = 10;
+        function read() {
+            return hidden;
+        }
+        function write(value) {
+            hidden = value;
+        }
+        function shadow() {
+            const shadowed = 20;
+            return shadowed;
+        }
+        write(5);
+        return [read(), shadow(), shadowed];
+    }
+    expect(outer()).toEqual([5, 20, 10]);
+});
+
+test("regular expressions and divisions in a pre-parsed body", () => {
+    function outer() {
+        function inner(a, b) {
+            const parts = [];
+            for (const part of /[}]/.exec("a}b")) parts.push(part);
+            const half = a / b / 2;
+            const template = `${a / b}}${"{"}`;
+            return [parts, half, template, typeof /\)/];
+        }
+        return inner(8, 2);
+    }
+    expect(outer()).toEqual([["}"], 2, "4}{", "object"]);
+});
+
+test("this, new.target and eval in a pre-parsed body", () => {
+    function outer() {
+        const value = 42;
+        function viaArrow() {
+            return (() => this.value)();
+        }
+        function viaNewTarget() {
+            return new.target === viaNewTarget;
+        }
+        function viaEval() {
+            return eval("value");
+        }
+        return [viaArrow.call({ value: 1 }), viaNewTarget(), viaEval()];
+    }
+    expect(outer()).toEqual([1, false, 42]);
+});
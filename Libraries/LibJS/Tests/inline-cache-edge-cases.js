@@ -16,3 +16,40 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Megamorphic property access sites", () => {
+    const objects = [];
+    for (let i = 0; i < 16; ++i) {
+        const o = {};
+        o["unique" + i] = i;
+        o.value = i;
+        objects.push(o);
+    }
+
+    function get(o) {
+        return o.value;
+    }
+    function put(o, value) {
+        o.value = value;
+    }
+
+    for (let round = 0; round < 3; ++round) {
+        for (let i = 0; i < objects.length; ++i) {
+            expect(get(objects[i])).toBe(i + round);
+            put(objects[i], i + round + 1);
+        }
+    }
+
+    // A getter in the prototype chain of an already cached shape has to be seen by the megamorphic site.
+    const prototype = {};
+    const withPrototype = Object.create(prototype);
+    withPrototype.unique0 = 0;
+    expect(get(withPrototype)).toBeUndefined();
+    Object.defineProperty(prototype, "value", { get: () => "getter" });
+    expect(get(withPrototype)).toBe("getter");
+
+    // Frozen objects share no cache entries with writable ones.
+    const frozen = Object.freeze({ unique0: 0, value: 1 });
+    put(frozen, 2);
+    expect(frozen.value).toBe(1);
+});
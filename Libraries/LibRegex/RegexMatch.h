@@ -291,6 +291,12 @@ public:
             [](auto&) -> bool { TODO(); });
     }
 
+    template<typename... Visitors>
+    decltype(auto) visit(Visitors&&... visitors) const
+    {
+        return m_view.visit(forward<Visitors>(visitors)...);
+    }
+
     bool starts_with(StringView str) const
     {
         return m_view.visit(
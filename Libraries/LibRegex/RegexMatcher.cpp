@@ -8,6 +8,8 @@
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
@@ -140,6 +142,107 @@ ByteString Regex<Parser>::error_string(Optional<ByteString> message) const
     return eb.to_byte_string();
 }
 
+template<typename CodeUnit>
+static Optional<size_t> find_first_code_unit_in_ranges(ReadonlySpan<CodeUnit> code_units, size_t start, ReadonlySpan<CharRange> ranges)
+{
+    // OPTIMIZATION: For a handful of ranges, look at a whole vector of code units at a time.
+    using VectorType = Conditional<sizeof(CodeUnit) == 1, AK::SIMD::u8x16, AK::SIMD::u16x8>;
+    static constexpr size_t lanes = AK::SIMD::vector_length<VectorType>;
+    static constexpr size_t max_ranges_to_vectorize = 4;
+
+    auto splat = [](CodeUnit code_unit) {
+        VectorType vector;
+        for (size_t i = 0; i < lanes; ++i)
+            vector[i] = code_unit;
+        return vector;
+    };
+
+    auto index = start;
+    if (ranges.size() <= max_ranges_to_vectorize) {
+        Array<VectorType, max_ranges_to_vectorize> range_starts;
+        Array<VectorType, max_ranges_to_vectorize> range_ends;
+        size_t range_count = 0;
+        for (auto const& range : ranges) {
+            if (range.from > NumericLimits<CodeUnit>::max())
+                continue;
+            range_starts[range_count] = splat(range.from);
+            range_ends[range_count] = splat(min(range.to, NumericLimits<CodeUnit>::max()));
+            ++range_count;
+        }
+
+        for (; index + lanes <= code_units.size(); index += lanes) {
+            auto chunk = AK::SIMD::load_unaligned<VectorType>(code_units.data() + index);
+            decltype(chunk == chunk) in_ranges {};
+            for (size_t i = 0; i < range_count; ++i)
+                in_ranges |= (chunk >= range_starts[i]) & (chunk <= range_ends[i]);
+
+            u64 lane_bits[2];
+            __builtin_memcpy(lane_bits, &in_ranges, sizeof(lane_bits));
+            if (lane_bits[0] | lane_bits[1])
+                break;
+        }
+    }
+
+    // NOTE: The ranges are sorted and don't overlap.
+    auto compare_range = [](u32 code_unit, CharRange range) {
+        if (code_unit < range.from)
+            return -1;
+        if (code_unit > range.to)
+            return 1;
+        return 0;
+    };
+    for (; index < code_units.size(); ++index) {
+        if (binary_search(ranges, static_cast<u32>(code_units[index]), nullptr, compare_range))
+            return index;
+    }
+    return {};
+}
+
+static Optional<size_t> find_literal_prefix(ReadonlySpan<u16> code_units, size_t start, StringView prefix, size_t rarest_character_index)
+{
+    // Rather than the first character of the prefix, scan for the one we're least likely to run into elsewhere, and
+    // only then check for the rest of the prefix around it.
+    CharRange rarest_character { static_cast<u8>(prefix[rarest_character_index]), static_cast<u8>(prefix[rarest_character_index]) };
+
+    for (auto index = start + rarest_character_index;;) {
+        auto candidate = find_first_code_unit_in_ranges(code_units, index, { &rarest_character, 1 });
+        if (!candidate.has_value())
+            return {};
+
+        auto prefix_start = *candidate - rarest_character_index;
+        if (prefix_start + prefix.length() > code_units.size())
+            return {};
+
+        auto matches_prefix = true;
+        for (size_t i = 0; i < prefix.length() && matches_prefix; ++i)
+            matches_prefix = code_units[prefix_start + i] == static_cast<u8>(prefix[i]);
+        if (matches_prefix)
+            return prefix_start;
+
+        index = *candidate + 1;
+    }
+}
+
+// Returns the first position at or after `start` where a match could begin, or nothing if a match can't begin anywhere.
+static Optional<size_t> find_possible_match_start(RegexStringView const& view, size_t start, Parser::Result const& parser_result)
+{
+    auto const& optimization_data = parser_result.optimization_data;
+
+    if (auto const& prefix = optimization_data.literal_prefix; prefix.has_value()) {
+        return view.visit(
+            [&](StringView view) { return view.find(*prefix, start); },
+            [&](Utf16View const& view) { return find_literal_prefix(view.span(), start, *prefix, optimization_data.literal_prefix_rarest_character_index); });
+    }
+
+    if (auto const& ranges = optimization_data.starting_ranges; !ranges.is_empty()) {
+        return view.visit(
+            [&](StringView view) { return find_first_code_unit_in_ranges(view.bytes(), start, ranges); },
+            [&](Utf16View const& view) { return find_first_code_unit_in_ranges(view.span(), start, ranges); });
+    }
+
+    return start;
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -209,6 +312,16 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
 
+    // NOTE: In unicode mode, positions count code points rather than code units, so we can't scan the code units.
+    auto can_skip_to_possible_match_starts = continue_search && !only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Insensitive) && !unicode;
+
+    // OPTIMIZATION: The Pike VM can try all the remaining start positions in a single pass over the input, instead of
+    //               one pass for each of them.
+    auto search_in_single_pass = m_pattern->parser_result.optimization_data.execution_engine == ExecutionEngine::PikeVM
+        && continue_search && !only_start_of_line
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine)
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine);
+
     auto compare_range = [insensitive = input.regex_options & AllFlags::Insensitive](auto needle, CharRange range) {
         auto upper_case_needle = needle;
         auto lower_case_needle = needle;
@@ -276,6 +389,15 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                     break;
             }
 
+            // OPTIMIZATION: If we're going to try every position anyway, jump straight to the next one a match could
+            //               start at.
+            if (can_skip_to_possible_match_starts) {
+                auto possible_match_start = find_possible_match_start(view, view_index, m_pattern->parser_result);
+                if (!possible_match_start.has_value())
+                    break;
+                view_index = *possible_match_start;
+            }
+
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
             //        the vm. Add new OpCode for MinMatchLengthFromSp with the value of
@@ -299,7 +421,17 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            if (execute(input, state, operations)) {
+            if (search_in_single_pass) {
+                auto last_start_position = view_length - match_length_minimum;
+                if (input.regex_options.has_flag_set(AllFlags::Multiline))
+                    last_start_position = min(last_start_position, view_length - 1);
+                auto match_start_position = execute_pike_vm(input, state, operations, last_start_position, can_skip_to_possible_match_starts);
+                if (!match_start_position.has_value())
+                    break;
+                view_index = *match_start_position;
+            }
+
+            if (search_in_single_pass || execute(input, state, operations)) {
                 succeeded = true;
 
                 if (input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine) && state.string_position == input.view.length()) {
@@ -477,6 +609,9 @@ struct SufficientlyUniformValueTraits : DefaultTraits<u64> {
 template<class Parser>
 bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t& operations) const
 {
+    if (m_pattern->parser_result.optimization_data.execution_engine == ExecutionEngine::PikeVM)
+        return execute_pike_vm(input, state, operations, state.string_position, false).has_value();
+
     BumpAllocatedLinkedList<MatchState> states_to_try_next;
     HashTable<u64, SufficientlyUniformValueTraits> seen_state_hashes;
 #if REGEX_DEBUG
@@ -595,6 +730,151 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
     VERIFY_NOT_REACHED();
 }
 
+// Two threads at the same instruction and string position that agree on everything that can affect where they go from
+// there (i.e. everything except their captures) will do exactly the same thing, so only the first of them needs to run.
+static u64 pike_vm_thread_hash(MatchState const& state)
+{
+    u64 hash = pair_int_hash(state.instruction_position, state.string_position);
+    for (auto mark : state.repetition_marks)
+        hash = pair_int_hash(hash, u64_hash(mark));
+
+    // NOTE: JumpNonEmpty only cares whether a checkpoint was set at the current position, not where exactly it was set.
+    for (auto checkpoint : state.checkpoints) {
+        auto checkpoint_state = checkpoint == 0 ? 0u : (checkpoint == state.string_position + 1 ? 1u : 2u);
+        hash = pair_int_hash(hash, checkpoint_state);
+    }
+    return hash;
+}
+
+// A Pike VM over the same bytecode as the backtracking engine: instead of exploring one alternative at a time, we keep
+// a list of threads (one per alternative still alive) in priority order, and advance all of them over the input one
+// character at a time. Threads that end up in the same state are merged, so every step costs at most time proportional
+// to the size of the bytecode, no matter how many ways there are to get there.
+//
+// Besides the position `state` is at, a match may start at any later position up to `last_start_position`. Rather than
+// running again for each of those, a new thread with the lowest priority joins the list at each position, so the whole
+// search takes a single pass over the input. Returns the position the match starts at.
+template<class Parser>
+Optional<size_t> Matcher<Parser>::execute_pike_vm(MatchInput const& input, MatchState& state, size_t& operations, size_t last_start_position, bool can_skip_to_possible_match_starts) const
+{
+    auto& bytecode = m_pattern->parser_result.bytecode;
+
+    struct Thread {
+        MatchState state;
+        size_t start_position { 0 };
+    };
+
+    // Threads that have consumed the input up to the current position, highest priority first. A thread that has
+    // matched several characters at once (e.g. a string) is further ahead, and waits in the list until we catch up.
+    Vector<Thread> threads;
+    Vector<Thread> next_threads;
+    HashTable<u64, SufficientlyUniformValueTraits> seen_states;
+    HashTable<u64, SufficientlyUniformValueTraits> seen_next_states;
+    Vector<Thread> lower_priority_forks;
+    Optional<Thread> best_match;
+
+    auto add_next_thread = [&](Thread&& thread) {
+        if (seen_next_states.set(pike_vm_thread_hash(thread.state)) == HashSetResult::InsertedNewEntry)
+            next_threads.append(move(thread));
+    };
+
+    auto initial_state = state;
+    auto position = state.string_position;
+
+    while (!threads.is_empty() || (!best_match.has_value() && position <= last_start_position)) {
+        seen_states.clear_with_capacity();
+        seen_next_states.clear_with_capacity();
+
+        // A match starting here is less preferable than one starting anywhere before, and once we've found a match,
+        // we're not interested in later ones at all.
+        if (!best_match.has_value() && position <= last_start_position) {
+            if (threads.is_empty() && can_skip_to_possible_match_starts) {
+                auto possible_match_start = find_possible_match_start(input.view, position, m_pattern->parser_result);
+                if (!possible_match_start.has_value() || *possible_match_start > last_start_position)
+                    break;
+                position = *possible_match_start;
+            }
+            Thread thread { initial_state, position };
+            if (position != initial_state.string_position) {
+                thread.state.string_position = position;
+                thread.state.string_position_in_code_units = position;
+            }
+            threads.append(move(thread));
+        }
+
+        for (auto& thread : threads) {
+            if (thread.state.string_position > position) {
+                add_next_thread(move(thread));
+                continue;
+            }
+
+            // Run the thread (and everything it forks) until each branch either consumes some input, fails or matches.
+            // Forks are explored depth-first, so that branches reach the next list in the same order as they would be
+            // tried by the backtracking engine.
+            auto matched = false;
+            lower_priority_forks.append(move(thread));
+            while (!matched && !lower_priority_forks.is_empty()) {
+                auto current = lower_priority_forks.take_last();
+                auto& current_state = current.state;
+                for (;;) {
+                    if (seen_states.set(pike_vm_thread_hash(current_state)) != HashSetResult::InsertedNewEntry)
+                        break;
+
+                    auto& opcode = bytecode.get_opcode(current_state);
+                    ++operations;
+
+                    auto result = opcode.execute(input, current_state);
+                    current_state.instruction_position += opcode.size();
+
+                    // NOTE: Atomic groups only prune the backtracking engine's list of forks, which we don't have.
+                    input.fork_to_replace.clear();
+
+                    if (result == ExecutionResult::Continue) {
+                        if (current_state.string_position == position)
+                            continue;
+                        add_next_thread(move(current));
+                        break;
+                    }
+                    if (result == ExecutionResult::Fork_PrioHigh) {
+                        auto fork = current;
+                        current_state.instruction_position = current_state.fork_at_position;
+                        lower_priority_forks.append(move(fork));
+                        continue;
+                    }
+                    if (result == ExecutionResult::Fork_PrioLow) {
+                        auto fork = current;
+                        fork.state.instruction_position = fork.state.fork_at_position;
+                        lower_priority_forks.append(move(fork));
+                        continue;
+                    }
+                    if (result == ExecutionResult::Succeeded) {
+                        best_match = move(current);
+                        matched = true;
+                    }
+                    break;
+                }
+            }
+
+            // A match cuts off every thread with a lower priority, but the ones we've already moved on may still
+            // find a preferable (e.g. longer, for a greedy loop) match.
+            if (matched) {
+                lower_priority_forks.clear_with_capacity();
+                break;
+            }
+        }
+
+        swap(threads, next_threads);
+        next_threads.clear_with_capacity();
+        ++position;
+    }
+
+    if (!best_match.has_value())
+        return {};
+
+    state = move(best_match->state);
+    return best_match->start_position;
+}
+
 template class Matcher<PosixBasicParser>;
 template class Regex<PosixBasicParser>;
 
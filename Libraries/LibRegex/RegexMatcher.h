@@ -72,6 +72,7 @@ public:
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    Optional<size_t> execute_pike_vm(MatchInput const& input, MatchState& state, size_t& operations, size_t last_start_position, bool can_skip_to_possible_match_starts) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
@@ -232,6 +233,8 @@ private:
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
     void fill_optimization_data(BasicBlockList const&);
+    void fill_literal_prefix(BasicBlockList const&);
+    void select_execution_engine();
 };
 
 // free standing functions for match, search and has_match
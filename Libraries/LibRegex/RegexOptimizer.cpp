@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
 #include <AK/Queue.h>
@@ -33,16 +34,22 @@ void Regex<Parser>::run_optimization_passes()
     rewrite_with_useless_jumps_removed();
 
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        fill_literal_prefix(blocks);
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
-    fill_optimization_data(split_basic_blocks(parser_result.bytecode));
+    blocks = split_basic_blocks(parser_result.bytecode);
+    fill_optimization_data(blocks);
+    fill_literal_prefix(blocks);
 
     parser_result.bytecode.flatten();
+
+    select_execution_engine();
 }
 
 struct StaticallyInterpretedCompares {
@@ -245,6 +252,177 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
     }
 }
 
+// A rough guess at how rare each ASCII character is in typical text, where higher means rarer.
+static unsigned ascii_character_rarity(char ch)
+{
+    static constexpr auto lowercase_letters_by_frequency = "etaoinsrhldcumfpgwybvkxjqz"sv;
+
+    if (ch == ' ')
+        return 0;
+    if (is_ascii_lower_alpha(ch))
+        return 1 + lowercase_letters_by_frequency.find(ch).value();
+    if (is_ascii_upper_alpha(ch))
+        return 20 + lowercase_letters_by_frequency.find(to_ascii_lowercase(ch)).value();
+    if (is_ascii_digit(ch))
+        return 20;
+    if ("/.,:;-_='\"()\n\t"sv.contains(ch))
+        return 25;
+    return 50;
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_literal_prefix(BasicBlockList const& blocks)
+{
+    if (blocks.is_empty())
+        return;
+
+    // FIXME: Case-insensitive prefixes could be scanned for too, with a bit more work.
+    if (parser_result.options.has_flag_set(AllFlags::Insensitive))
+        return;
+
+    auto& bytecode = parser_result.bytecode;
+    StringBuilder prefix;
+
+    auto state = MatchState::only_for_enumeration();
+    auto block = blocks.first();
+    for (state.instruction_position = block.start; state.instruction_position < block.end;) {
+        auto& opcode = bytecode.get_opcode(state);
+        if (opcode.opcode_id() == OpCodeId::Checkpoint
+            || opcode.opcode_id() == OpCodeId::ClearCaptureGroup
+            || opcode.opcode_id() == OpCodeId::SaveLeftCaptureGroup) {
+            // These do not 'match' anything, so look through them.
+            state.instruction_position += opcode.size();
+            continue;
+        }
+        if (opcode.opcode_id() != OpCodeId::Compare)
+            break;
+
+        // NOTE: With more than one argument, the compare matches any one of them, so only single characters and
+        //       strings are literals.
+        auto& compare = static_cast<OpCode_Compare const&>(opcode);
+        if (compare.arguments_count() != 1)
+            break;
+
+        auto type = static_cast<CharacterCompareType>(compare.argument(2));
+        if (type != CharacterCompareType::Char && type != CharacterCompareType::String)
+            break;
+
+        auto all_ascii = true;
+        for (auto& flat_compare : compare.flat_compares()) {
+            if (flat_compare.value > 0x7f) {
+                all_ascii = false;
+                break;
+            }
+            prefix.append(static_cast<char>(flat_compare.value));
+        }
+        if (!all_ascii)
+            break;
+
+        state.instruction_position += opcode.size();
+    }
+
+    if (prefix.is_empty())
+        return;
+
+    auto literal_prefix = prefix.to_byte_string();
+    size_t rarest_character_index = 0;
+    for (size_t i = 1; i < literal_prefix.length(); ++i) {
+        if (ascii_character_rarity(literal_prefix[i]) > ascii_character_rarity(literal_prefix[rarest_character_index]))
+            rarest_character_index = i;
+    }
+
+    parser_result.optimization_data.literal_prefix = move(literal_prefix);
+    parser_result.optimization_data.literal_prefix_rarest_character_index = rarest_character_index;
+}
+
+template<typename Parser>
+void Regex<Parser>::select_execution_engine()
+{
+    auto& bytecode = parser_result.bytecode;
+
+    // Instructions between the target of a backwards jump and the jump itself.
+    struct LoopBody {
+        size_t start;
+        size_t end;
+    };
+    Vector<LoopBody> loop_bodies;
+    Vector<size_t> backtracking_forks;
+
+    auto is_fork = [](OpCodeId id) {
+        return id == OpCodeId::ForkJump || id == OpCodeId::ForkStay || id == OpCodeId::ForkReplaceJump || id == OpCodeId::ForkReplaceStay;
+    };
+
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto position = state.instruction_position;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::PopSaved:
+            // Lookarounds need to run a sub-match to completion at a single position, which a Pike VM can't do.
+            return;
+        case OpCodeId::Compare:
+            for (auto const& compare : static_cast<OpCode_Compare const&>(opcode).flat_compares()) {
+                // Backreferences make the rest of the match depend on what was captured, so threads can't be merged.
+                if (compare.type == CharacterCompareType::Reference)
+                    return;
+            }
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay: {
+            backtracking_forks.append(position);
+            auto offset = opcode.opcode_id() == OpCodeId::ForkJump ? static_cast<OpCode_ForkJump const&>(opcode).offset() : static_cast<OpCode_ForkStay const&>(opcode).offset();
+            if (offset < 0)
+                loop_bodies.append({ position + opcode.size() + offset, position });
+            break;
+        }
+        case OpCodeId::Jump:
+            if (auto offset = static_cast<OpCode_Jump const&>(opcode).offset(); offset < 0)
+                loop_bodies.append({ position + opcode.size() + offset, position });
+            break;
+        case OpCodeId::Repeat:
+            loop_bodies.append({ position - static_cast<OpCode_Repeat const&>(opcode).offset(), position });
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            auto const& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            if (jump.form() == OpCodeId::ForkJump || jump.form() == OpCodeId::ForkStay)
+                backtracking_forks.append(position);
+            if (jump.offset() >= 0)
+                break;
+
+            LoopBody body { position + opcode.size() + jump.offset(), position };
+            // NOTE: A * loop starts with the fork that leaves it, which is not part of what's being repeated.
+            if (jump.form() == OpCodeId::Jump) {
+                auto header_state = MatchState::only_for_enumeration();
+                header_state.instruction_position = body.start;
+                auto& header = bytecode.get_opcode(header_state);
+                if (is_fork(header.opcode_id()))
+                    body.start += header.size();
+            }
+            loop_bodies.append(body);
+            break;
+        }
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    // NOTE: Backtracking only takes more than polynomial time if a loop can match the same input in more than one way,
+    //       i.e. if its body has an alternative or a nested loop that hasn't been made atomic, like (a|aa)* or (a+)+.
+    //       Everything else is faster with the backtracking engine, which has less overhead for each character.
+    auto might_backtrack_exponentially = any_of(loop_bodies, [&](auto const& body) {
+        return any_of(backtracking_forks, [&](auto fork) { return fork >= body.start && fork < body.end; });
+    });
+    if (might_backtrack_exponentially)
+        parser_result.optimization_data.execution_engine = ExecutionEngine::PikeVM;
+
+    dbgln_if(REGEX_DEBUG, "Selected execution engine: {}", might_backtrack_exponentially ? "Pike VM"sv : "backtracking"sv);
+}
+
 template<typename Parser>
 typename Regex<Parser>::BasicBlockList Regex<Parser>::split_basic_blocks(ByteCode const& bytecode)
 {
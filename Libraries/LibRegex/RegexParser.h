@@ -45,6 +45,14 @@ template<>
 struct ParserTraits<ECMA262Parser> : public GenericParserTraits<ECMAScriptOptions> {
 };
 
+enum class ExecutionEngine : u8 {
+    // Explores alternatives depth-first, one at a time. Supports everything, but can take exponential time.
+    Backtracking,
+    // Runs all alternatives in lockstep over the input, in time linear in its length. Does not support backreferences
+    // or lookarounds.
+    PikeVM,
+};
+
 struct NamedCaptureGroup {
     size_t group_index;
     size_t alternative_id;
@@ -66,7 +74,12 @@ public:
             Optional<ByteString> pure_substring_search;
             // If populated, the pattern only accepts strings that start with a character in these ranges.
             Vector<CharRange> starting_ranges;
+            // If populated, the pattern only accepts strings that start with this (ASCII) string.
+            Optional<ByteString> literal_prefix;
+            // The character of the literal prefix that's least likely to show up elsewhere, i.e. the best one to scan for.
+            size_t literal_prefix_rarest_character_index { 0 };
             bool only_start_of_line = false;
+            ExecutionEngine execution_engine { ExecutionEngine::Backtracking };
         } optimization_data {};
     };
 
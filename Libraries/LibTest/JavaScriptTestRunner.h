@@ -112,6 +112,7 @@ static consteval size_t __testjs_last()
 static constexpr auto TOP_LEVEL_TEST_NAME = "__$$TOP_LEVEL$$__";
 extern RefPtr<JS::VM> g_vm;
 extern bool g_collect_on_every_allocation;
+extern bool g_use_generational_gc;
 extern ByteString g_currently_running_test;
 struct FunctionWithLength {
     JS::ThrowCompletionOr<JS::Value> (*function)(JS::VM&);
@@ -292,6 +293,7 @@ inline JSFileResult TestRunner::run_file_test(ByteString const& test_path)
     g_vm->pop_execution_context();
 
     g_vm->heap().set_should_collect_on_every_allocation(g_collect_on_every_allocation);
+    g_vm->heap().set_generational_collection_enabled(g_use_generational_gc);
 
     if (g_run_file) {
         auto result = g_run_file(test_path, *realm, global_execution_context);
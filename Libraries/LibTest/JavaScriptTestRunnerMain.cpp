@@ -8,6 +8,9 @@
 
 #include <LibCore/ArgsParser.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Parser.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <signal.h>
 #include <stdio.h>
@@ -20,6 +23,7 @@ namespace JS {
 
 RefPtr<::JS::VM> g_vm;
 bool g_collect_on_every_allocation = false;
+bool g_use_generational_gc = false;
 ByteString g_currently_running_test;
 HashMap<String, FunctionWithLength> s_exposed_global_functions;
 Function<void()> g_main_hook;
@@ -52,6 +56,20 @@ static void handle_sigabrt(int)
     abort();
 }
 
+static void print_gc_statistics(GC::Heap const& heap)
+{
+    auto const& statistics = heap.collection_statistics();
+
+    auto print_pauses = [](StringView kind, size_t count, AK::Duration total, AK::Duration longest) {
+        auto average_ms = count ? static_cast<double>(total.to_microseconds()) / 1000.0 / count : 0.0;
+        outln("{} collections: {} (total {}ms, average {:.3}ms, longest {:.3}ms)", kind, count, total.to_milliseconds(), average_ms, static_cast<double>(longest.to_microseconds()) / 1000.0);
+    };
+
+    outln("Garbage collection pauses:");
+    print_pauses("Minor"sv, statistics.minor_collections, statistics.total_minor_pause_time, statistics.longest_minor_pause_time);
+    print_pauses("Major"sv, statistics.major_collections, statistics.total_major_pause_time, statistics.longest_major_pause_time);
+}
+
 int main(int argc, char** argv)
 {
     Vector<StringView> arguments;
@@ -86,7 +104,9 @@ int main(int argc, char** argv)
     bool print_times = false;
     bool print_progress = false;
     bool print_json = false;
+    bool use_jit = false;
     bool per_file = false;
+    bool print_gc_pauses = false;
     StringView specified_test_root;
     ByteString common_path;
     Vector<ByteString> test_globs;
@@ -112,7 +132,12 @@ int main(int argc, char** argv)
     args_parser.add_option(print_json, "Show results as JSON", "json", 'j');
     args_parser.add_option(per_file, "Show detailed per-file results as JSON (implies -j)", "per-file");
     args_parser.add_option(g_collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
+    args_parser.add_option(g_use_generational_gc, "Only collect the young generation until a full collection is due", "generational-gc");
+    args_parser.add_option(print_gc_pauses, "Show minor and major garbage collection pause times", "show-gc-pauses");
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_optimize_bytecode, "Run the bytecode optimization passes", "optimize-bytecode");
+    args_parser.add_option(use_jit, "Compile every executable with the baseline JIT", "jit");
+    args_parser.add_option(JS::g_lazy_function_parsing, "Only pre-parse nested function bodies and parse them on their first call", "lazy-functions");
     args_parser.add_option(test_globs, "Only run tests matching the given glob", "filter", 'f', "glob");
     for (auto& entry : g_extra_args)
         args_parser.add_option(*entry.key, entry.value.get<0>().characters(), entry.value.get<1>().characters(), entry.value.get<2>());
@@ -120,6 +145,12 @@ int main(int argc, char** argv)
     args_parser.add_positional_argument(common_path, "Path to tests-common.js", "common-path", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    if (use_jit) {
+        // Most test code only runs once, so compile eagerly to exercise the JIT as much as possible.
+        JS::JIT::g_enabled = true;
+        JS::JIT::g_compile_threshold = 1;
+    }
+
     if (per_file)
         print_json = true;
 
@@ -190,6 +221,9 @@ int main(int argc, char** argv)
     Test::JS::TestRunner test_runner(test_root, common_path, print_times, print_progress, print_json, per_file);
     test_runner.run(test_globs);
 
+    if (print_gc_pauses)
+        print_gc_statistics(g_vm->heap());
+
     g_vm = nullptr;
 
     return test_runner.counts().tests_failed > 0 ? 1 : 0;
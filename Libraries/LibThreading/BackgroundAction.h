@@ -31,7 +31,6 @@ private:
     BackgroundActionBase() = default;
 
     static void enqueue_work(ESCAPING Function<void()>);
-    static Thread& background_thread();
 };
 
 template<typename Result>
@@ -77,7 +76,8 @@ private:
             m_on_error = on_error.release_value();
 
         enqueue_work([self = NonnullRefPtr(*this), promise = move(promise), origin_event_loop = &Core::EventLoop::current()]() mutable {
-            auto result = self->m_action(*self);
+            // There's no point in running an action that was canceled while it was waiting for a worker.
+            auto result = self->m_canceled ? ErrorOr<Result> { Error::from_errno(ECANCELED) } : self->m_action(*self);
 
             // The event loop cancels the promise when it exits.
             self->m_canceled |= promise->is_rejected();
@@ -123,6 +123,7 @@ private:
     bool m_canceled { false };
 };
 
+// Drops all background actions that haven't started yet, and waits for the running ones to finish.
 void quit_background_thread();
 
 }
@@ -9,6 +9,8 @@
 
 namespace Threading {
 
+class ThreadPool;
+
 template<typename ErrorType>
 class WorkerThread;
 
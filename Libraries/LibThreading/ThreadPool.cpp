@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+// Lets submit() tell whether it's being called from one of a pool's own workers.
+static thread_local ThreadPool* s_current_pool = nullptr;
+static thread_local size_t s_current_worker_index = 0;
+
+ThreadPool& ThreadPool::the()
+{
+    // NOTE: This is never destroyed, since tasks may still be submitted while static destructors run.
+    static ThreadPool* pool = new ThreadPool(max(Core::System::hardware_concurrency(), 2u) - 1);
+    return *pool;
+}
+
+ThreadPool::ThreadPool(size_t worker_count, StringView name)
+    : m_name(name)
+{
+    VERIFY(worker_count > 0);
+    for (size_t i = 0; i < worker_count; ++i)
+        m_workers.append(make<Worker>());
+}
+
+ThreadPool::~ThreadPool()
+{
+    shutdown();
+}
+
+// NOTE: The caller must hold m_start_mutex.
+void ThreadPool::start_workers_if_needed()
+{
+    if (m_workers_started)
+        return;
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers[i]->thread = Thread::construct([this, i] { return run_worker(i); }, m_name);
+        m_workers[i]->thread->start();
+    }
+    m_workers_started = true;
+}
+
+NonnullRefPtr<ThreadPool::Task> ThreadPool::submit(Function<void()> work, Priority priority)
+{
+    auto task = adopt_ref(*new Task(move(work)));
+
+    // NOTE: A worker that is about to sleep bumps the sleeping worker count before it checks the queued task count one
+    //       last time, so either it sees this task, or we see it and wake it up. The count goes up before the task is
+    //       queued so that it never drops below zero when a worker takes the task right away.
+    auto priority_index = to_underlying(priority);
+    if (s_current_pool == this) {
+        // NOTE: shutdown() joins this worker before it drops the queued tasks, so this task either runs or is canceled.
+        ++m_queued_task_count;
+        auto& worker = *m_workers[s_current_worker_index];
+        MutexLocker locker(worker.mutex);
+        worker.tasks[priority_index].append(task);
+    } else {
+        // NOTE: The start mutex is held until the task is queued, so that a concurrent shutdown() can't stop the
+        //       workers in between and leave the task behind in a queue nobody takes from.
+        MutexLocker start_locker(m_start_mutex);
+        start_workers_if_needed();
+        ++m_queued_task_count;
+        MutexLocker locker(m_shared_tasks_mutex);
+        m_shared_tasks[priority_index].append(task);
+    }
+
+    if (m_sleeping_worker_count.load() > 0) {
+        MutexLocker locker(m_sleep_mutex);
+        m_wake_condition.signal();
+    }
+
+    return task;
+}
+
+NonnullRefPtr<ThreadPool::Task> ThreadPool::TaskDeque::take_first()
+{
+    VERIFY(!is_empty());
+    auto task = m_tasks[m_head++].release_nonnull();
+    if (is_empty()) {
+        m_tasks.clear_with_capacity();
+        m_head = 0;
+    } else if (m_head >= 64 && m_head * 2 >= m_tasks.size()) {
+        m_tasks.remove(0, m_head);
+        m_head = 0;
+    }
+    return task;
+}
+
+NonnullRefPtr<ThreadPool::Task> ThreadPool::TaskDeque::take_last()
+{
+    VERIFY(!is_empty());
+    auto task = m_tasks.take_last().release_nonnull();
+    if (is_empty()) {
+        m_tasks.clear_with_capacity();
+        m_head = 0;
+    }
+    return task;
+}
+
+void ThreadPool::TaskDeque::clear()
+{
+    for (size_t i = m_head; i < m_tasks.size(); ++i)
+        m_tasks[i]->cancel();
+    m_tasks.clear();
+    m_head = 0;
+}
+
+RefPtr<ThreadPool::Task> ThreadPool::take_task(size_t worker_index)
+{
+    auto take = [&](Mutex& mutex, TaskDeque& tasks, bool newest_first) -> RefPtr<Task> {
+        MutexLocker locker(mutex);
+        if (tasks.is_empty())
+            return nullptr;
+        --m_queued_task_count;
+        return newest_first ? tasks.take_last() : tasks.take_first();
+    };
+
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        auto& worker = *m_workers[worker_index];
+        if (auto task = take(worker.mutex, worker.tasks[priority], true))
+            return task;
+
+        if (auto task = take(m_shared_tasks_mutex, m_shared_tasks[priority], false))
+            return task;
+
+        for (size_t i = 1; i < m_workers.size(); ++i) {
+            auto& victim = *m_workers[(worker_index + i) % m_workers.size()];
+            if (auto task = take(victim.mutex, victim.tasks[priority], false))
+                return task;
+        }
+    }
+    return nullptr;
+}
+
+intptr_t ThreadPool::run_worker(size_t index)
+{
+    s_current_pool = this;
+    s_current_worker_index = index;
+
+    while (!m_should_exit.load()) {
+        if (auto task = take_task(index)) {
+            // NOTE: A canceled task has already been marked as started.
+            if (!task->m_started.exchange(true, AK::MemoryOrder::memory_order_acq_rel))
+                task->m_work();
+            // Destroy whatever the task captured here rather than wherever its last reference happens to go away.
+            task->m_work = nullptr;
+            continue;
+        }
+
+        MutexLocker locker(m_sleep_mutex);
+        ++m_sleeping_worker_count;
+        while (m_queued_task_count.load() == 0 && !m_should_exit.load())
+            m_wake_condition.wait();
+        --m_sleeping_worker_count;
+    }
+
+    s_current_pool = nullptr;
+    return 0;
+}
+
+void ThreadPool::shutdown()
+{
+    MutexLocker start_locker(m_start_mutex);
+    if (!m_workers_started)
+        return;
+
+    {
+        MutexLocker locker(m_sleep_mutex);
+        m_should_exit.store(true);
+        m_wake_condition.broadcast();
+    }
+
+    for (auto& worker : m_workers) {
+        MUST(worker->thread->join());
+        worker->thread = nullptr;
+    }
+
+    auto drop_tasks = [](TaskQueue& queue) {
+        for (auto& tasks : queue)
+            tasks.clear();
+    };
+    drop_tasks(m_shared_tasks);
+    for (auto& worker : m_workers)
+        drop_tasks(worker->tasks);
+
+    m_queued_task_count.store(0);
+    m_should_exit.store(false);
+    m_workers_started = false;
+}
+
+}
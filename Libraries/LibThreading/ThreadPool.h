@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A pool of worker threads that run tasks in parallel.
+//
+// Every worker has its own queue of tasks. Tasks submitted from a worker (i.e. by another task) go to that worker's
+// queue and are run newest first, while tasks submitted from any other thread go to a shared queue and are run in
+// submission order. A worker that runs out of tasks takes the oldest task from another worker's queue.
+//
+// Tasks of a higher priority are always picked before tasks of a lower priority, but a running task is never
+// interrupted.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    enum class Priority : u8 {
+        High,
+        Normal,
+        Low,
+    };
+    static constexpr size_t priority_count = 3;
+
+    class Task : public AtomicRefCounted<Task> {
+    public:
+        // Keeps the task from running if it hasn't started yet, and returns whether that worked. A task that is already
+        // running has to check is_canceled() itself if it wants to stop early.
+        bool cancel()
+        {
+            m_canceled.store(true, AK::MemoryOrder::memory_order_release);
+            return !m_started.exchange(true, AK::MemoryOrder::memory_order_acq_rel);
+        }
+        bool is_canceled() const { return m_canceled.load(AK::MemoryOrder::memory_order_acquire); }
+
+    private:
+        friend class ThreadPool;
+
+        explicit Task(Function<void()> work)
+            : m_work(move(work))
+        {
+        }
+
+        Function<void()> m_work;
+        Atomic<bool> m_started { false };
+        Atomic<bool> m_canceled { false };
+    };
+
+    // The pool shared by the whole process. It has one worker for every core but the one running the main thread.
+    static ThreadPool& the();
+
+    explicit ThreadPool(size_t worker_count, StringView name = "Thread Pool"sv);
+    ~ThreadPool();
+
+    size_t worker_count() const { return m_workers.size(); }
+
+    NonnullRefPtr<Task> submit(Function<void()> work, Priority = Priority::Normal);
+
+    // Runs the work on the pool, then passes its result to on_complete on the event loop of the thread that submitted
+    // it. That event loop has to outlive the task.
+    template<typename Work, typename OnComplete>
+    NonnullRefPtr<Task> submit_and_post_result(Work&& work, OnComplete&& on_complete, Priority priority = Priority::Normal)
+    {
+        return submit([work = forward<Work>(work), on_complete = forward<OnComplete>(on_complete), &origin_event_loop = Core::EventLoop::current()]() mutable {
+            origin_event_loop.deferred_invoke([result = work(), on_complete = move(on_complete)]() mutable {
+                on_complete(move(result));
+            });
+            origin_event_loop.wake();
+        },
+            priority);
+    }
+
+    // Drops all tasks that haven't started yet, and waits for the running ones to finish. The workers are started again
+    // by the next call to submit().
+    void shutdown();
+
+private:
+    // Tasks can be taken from both ends in constant time.
+    class TaskDeque {
+    public:
+        bool is_empty() const { return m_head == m_tasks.size(); }
+        void append(NonnullRefPtr<Task> task) { m_tasks.append(move(task)); }
+        NonnullRefPtr<Task> take_first();
+        NonnullRefPtr<Task> take_last();
+        void clear();
+
+    private:
+        Vector<RefPtr<Task>> m_tasks;
+        size_t m_head { 0 };
+    };
+    using TaskQueue = Array<TaskDeque, priority_count>;
+
+    struct Worker {
+        RefPtr<Thread> thread;
+        Mutex mutex;
+        TaskQueue tasks;
+    };
+
+    void start_workers_if_needed();
+    intptr_t run_worker(size_t index);
+    RefPtr<Task> take_task(size_t worker_index);
+
+    ByteString m_name;
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    Mutex m_start_mutex;
+    bool m_workers_started { false }; // Guarded by m_start_mutex.
+
+    Mutex m_shared_tasks_mutex;
+    TaskQueue m_shared_tasks;
+
+    // Idle workers sleep on this until there are tasks again.
+    Mutex m_sleep_mutex;
+    ConditionVariable m_wake_condition { m_sleep_mutex };
+    Atomic<size_t> m_queued_task_count { 0 };
+    Atomic<size_t> m_sleeping_worker_count { 0 };
+    Atomic<bool> m_should_exit { false };
+};
+
+}
@@ -14,6 +14,15 @@
 
 namespace Wasm {
 
+CompiledFunction const* WasmFunction::compiled_function(Store& store)
+{
+    if (!m_did_try_to_compile) {
+        m_did_try_to_compile = true;
+        m_compiled_function = CompiledFunction::try_compile(store, m_module_instance, m_type, m_code);
+    }
+    return m_compiled_function.ptr();
+}
+
 Optional<FunctionAddress> Store::allocate(ModuleInstance& instance, Module const& module, CodeSection::Code const& code, TypeIndex type_index)
 {
     FunctionAddress address { m_functions.size() };
@@ -239,6 +248,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
     }
 
     BytecodeInterpreter interpreter(m_stack_info);
+    interpreter.set_compiled_functions_enabled(m_compiled_functions_enabled);
     auto handle = register_scoped(interpreter);
 
     for (auto& entry : module.global_section().entries()) {
@@ -492,6 +502,7 @@ Optional<InstantiationError> AbstractMachine::allocate_all_final_phase(Module co
 Result AbstractMachine::invoke(FunctionAddress address, Vector<Value> arguments)
 {
     BytecodeInterpreter interpreter(m_stack_info);
+    interpreter.set_compiled_functions_enabled(m_compiled_functions_enabled);
     auto handle = register_scoped(interpreter);
     return invoke(interpreter, address, move(arguments));
 }
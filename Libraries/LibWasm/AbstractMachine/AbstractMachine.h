@@ -13,6 +13,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/AbstractMachine/CompiledFunction.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -345,11 +346,16 @@ public:
     auto& code() const { return m_code; }
     RefPtr<Module const> module_ref() const { return m_module.strong_ref(); }
 
+    // Compiles the function the first time it's asked for; null if it can't be compiled.
+    CompiledFunction const* compiled_function(Store&);
+
 private:
     FunctionType m_type;
     WeakPtr<Module const> m_module;
     ModuleInstance const& m_module_instance;
     CodeSection::Code const& m_code;
+    RefPtr<CompiledFunction const> m_compiled_function;
+    bool m_did_try_to_compile { false };
 };
 
 class HostFunction {
@@ -419,6 +425,18 @@ public:
     {
         MemoryInstance instance { type };
 
+#ifdef AK_ARCH_64_BIT
+        // Reserve room for what this memory may grow to up front, so that growing it within that range never has to
+        // move (and copy) the memory.
+        // NOTE: An allocation this large is served straight from the OS, which only commits the pages once they're
+        //       touched. It still takes up address space (and commit charge on hosts that don't overcommit), so the
+        //       reservation is capped; memories that grow past it, or whose reservation can't be made, fall back to
+        //       allocating on grow.
+        auto maximum_pages = min<u64>(type.limits().max().value_or(maximum_page_count), maximum_page_count);
+        auto reserved_size = min<u64>(maximum_pages * Constants::page_size, maximum_reserved_size);
+        (void)instance.m_data.try_ensure_capacity(reserved_size);
+#endif
+
         if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
             return Error::from_string_literal("Failed to grow to requested size");
 
@@ -446,7 +464,7 @@ public:
             return true;
         u64 new_size = m_data.size() + size_to_grow;
         // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
+        if (new_size >= Constants::page_size * maximum_page_count)
             return false;
         if (auto max = m_type.limits().max(); max.has_value()) {
             if (max.value() * Constants::page_size < new_size)
@@ -478,6 +496,9 @@ public:
     Function<void()> successful_grow_hook;
 
 private:
+    static constexpr u64 maximum_page_count = 65536;
+    static constexpr u64 maximum_reserved_size = 256 * MiB;
+
     explicit MemoryInstance(MemoryType const& type)
         : m_type(type)
     {
@@ -609,6 +630,8 @@ public:
     auto arity() const { return m_arity; }
     auto label_index() const { return m_label_index; }
     auto& label_index() { return m_label_index; }
+    auto compiled_function() const { return m_compiled_function; }
+    void set_compiled_function(CompiledFunction const* compiled_function) { m_compiled_function = compiled_function; }
 
 private:
     ModuleInstance const& m_module;
@@ -616,6 +639,7 @@ private:
     Expression const& m_expression;
     size_t m_arity { 0 };
     size_t m_label_index { 0 };
+    CompiledFunction const* m_compiled_function { nullptr };
 };
 
 using InstantiationResult = AK::ErrorOr<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -629,7 +653,8 @@ public:
     explicit AbstractMachine() = default;
 
     // Validate a module; permanently sets the module's validity status.
-    ErrorOr<void, ValidationError> validate(Module&);
+    // NOTE: This doesn't touch any machine state, so it's safe to call from any thread.
+    static ErrorOr<void, ValidationError> validate(Module&);
     // Load and instantiate a module, and link it into this interpreter.
     InstantiationResult instantiate(Module const&, Vector<ExternValue>);
     Result invoke(FunctionAddress, Vector<Value>);
@@ -639,6 +664,8 @@ public:
     auto& store() { return m_store; }
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
+    // Makes the interpreters this creates run functions from their compiled form, see CompiledFunction.
+    void enable_compiled_functions() { m_compiled_functions_enabled = true; }
 
     void visit_external_resources(HostVisitOps const&);
 
@@ -673,6 +700,7 @@ private:
     StackInfo m_stack_info;
     HashTable<Interpreter*> m_active_interpreters;
     bool m_should_limit_instruction_count { false };
+    bool m_compiled_functions_enabled { false };
 };
 
 class Linker {
@@ -11,6 +11,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
 #include <AK/SIMDExtras.h>
+#include <AK/ScopeGuard.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
@@ -37,15 +38,23 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
     auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+
+    if (auto const* compiled_function = configuration.frame().compiled_function(); compiled_function && m_compiled_functions_enabled && !should_limit_instruction_count) {
+        interpret_compiled_function(configuration, *compiled_function);
+        return;
+    }
+
     u64 executed_instructions = 0;
+    ScopeGuard count_executed_instructions = [&] { m_executed_instruction_count += executed_instructions; };
 
     while (current_ip_value < max_ip_value) {
         if (should_limit_instruction_count) {
-            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
+            if (executed_instructions >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
                 m_trap = Trap::from_string("Exceeded maximum allowed number of instructions");
                 return;
             }
         }
+        ++executed_instructions;
         auto& instruction = instructions[current_ip_value.value()];
         auto old_ip = current_ip_value;
         interpret_instruction(configuration, current_ip_value, instruction);
@@ -1662,6 +1671,263 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     }
 }
 
+template<typename T>
+ALWAYS_INLINE static T from_slot(u64 slot)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<float>(static_cast<u32>(slot));
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<double>(slot);
+    else
+        return static_cast<T>(slot);
+}
+
+// Slots hold scalars the same way Value does, so they can be turned into Values and back without knowing their type.
+template<typename T>
+ALWAYS_INLINE static u64 to_slot(T value)
+{
+    static_assert(sizeof(T) == sizeof(u32) || sizeof(T) == sizeof(u64));
+    if constexpr (sizeof(T) == sizeof(u64))
+        return bit_cast<u64>(value);
+    else
+        return static_cast<u64>(static_cast<i64>(bit_cast<i32>(value)));
+}
+
+template<typename PushType, typename ResultType>
+ALWAYS_INLINE static Optional<StringView> store_operation_result(u64& slot, ResultType result)
+{
+    if constexpr (IsSpecializationOf<ResultType, AK::ErrorOr>) {
+        if (result.is_error())
+            return result.error();
+        slot = to_slot<PushType>(result.release_value());
+    } else {
+        slot = to_slot<PushType>(static_cast<PushType>(result));
+    }
+    return {};
+}
+
+template<typename T>
+ALWAYS_INLINE static T read_from_memory(u8 const* data)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        return bit_cast<T>(read_from_memory<Conditional<sizeof(T) == sizeof(u32), u32, u64>>(data));
+    } else {
+        T value;
+        __builtin_memcpy(&value, data, sizeof(T));
+        return AK::convert_between_host_and_little_endian(value);
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE static void write_to_memory(u8* data, T value)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        write_to_memory(data, bit_cast<Conditional<sizeof(T) == sizeof(u32), u32, u64>>(value));
+    } else {
+        value = AK::convert_between_host_and_little_endian(value);
+        __builtin_memcpy(data, &value, sizeof(T));
+    }
+}
+
+NEVER_INLINE void BytecodeInterpreter::interpret_bridged_instruction(Configuration& configuration, Instruction const& instruction)
+{
+    interpret_instruction(configuration, configuration.ip(), instruction);
+}
+
+void BytecodeInterpreter::interpret_compiled_function(Configuration& configuration, CompiledFunction const& function)
+{
+    Vector<u64, 64> slot_storage;
+    slot_storage.resize(function.slot_count());
+    auto* slots = slot_storage.data();
+
+    auto& locals = configuration.frame().locals();
+    for (size_t i = 0; i < locals.size(); ++i)
+        slots[i] = locals[i].value().low();
+    for (size_t i = 0; i < function.constants().size(); ++i)
+        slots[function.local_count() + i] = function.constants()[i];
+
+    auto const* instructions = function.instructions().data();
+    size_t ip = 0;
+
+    // NOTE: A bridged instruction may run arbitrary code, which could move the memory instance around.
+    MemoryInstance* memory = nullptr;
+    auto look_up_memory = [&] {
+        if (function.memory_address().has_value())
+            memory = configuration.store().get(MemoryAddress { *function.memory_address() });
+    };
+    look_up_memory();
+
+    // Like the bytecode interpreter in LibJS, dispatch with computed gotos rather than a switch statement.
+    // This is a GCC extension, but it's also supported by Clang.
+    static void* const dispatch_table[] = {
+#define SET_UP_LABEL(name, ...) &&handle_##name,
+        ENUMERATE_WASM_COMPILED_OPCODES(SET_UP_LABEL)
+        ENUMERATE_WASM_COMPILED_UNARY_OPERATIONS(SET_UP_LABEL)
+        ENUMERATE_WASM_COMPILED_BINARY_OPERATIONS(SET_UP_LABEL)
+        ENUMERATE_WASM_COMPILED_LOADS(SET_UP_LABEL)
+        ENUMERATE_WASM_COMPILED_STORES(SET_UP_LABEL)
+#undef SET_UP_LABEL
+    };
+
+#define DISPATCH() goto* dispatch_table[to_underlying(instructions[ip].opcode)]
+#define DISPATCH_NEXT() \
+    do {                \
+        ++ip;           \
+        DISPATCH();     \
+    } while (0)
+
+    DISPATCH();
+
+handle_Copy: {
+    auto& instruction = instructions[ip];
+    slots[instruction.destination] = slots[instruction.sources[0]];
+    DISPATCH_NEXT();
+}
+
+handle_Jump: {
+    ip = instructions[ip].immediate;
+    DISPATCH();
+}
+
+handle_JumpIfZero: {
+    auto& instruction = instructions[ip];
+    if (from_slot<i32>(slots[instruction.sources[0]]) == 0) {
+        ip = instruction.immediate;
+        DISPATCH();
+    }
+    DISPATCH_NEXT();
+}
+
+handle_JumpIfNotZero: {
+    auto& instruction = instructions[ip];
+    if (from_slot<i32>(slots[instruction.sources[0]]) != 0) {
+        ip = instruction.immediate;
+        DISPATCH();
+    }
+    DISPATCH_NEXT();
+}
+
+handle_JumpTable: {
+    auto& instruction = instructions[ip];
+    auto& table = function.jump_tables()[instruction.immediate];
+    auto index = from_slot<u32>(slots[instruction.sources[0]]);
+    ip = table[min<size_t>(index, table.size() - 1)];
+    DISPATCH();
+}
+
+handle_Select: {
+    auto& instruction = instructions[ip];
+    auto condition = from_slot<i32>(slots[instruction.sources[2]]);
+    slots[instruction.destination] = condition != 0 ? slots[instruction.sources[0]] : slots[instruction.sources[1]];
+    DISPATCH_NEXT();
+}
+
+handle_GlobalGet: {
+    auto& instruction = instructions[ip];
+    slots[instruction.destination] = configuration.store().get(GlobalAddress { instruction.immediate })->value().value().low();
+    DISPATCH_NEXT();
+}
+
+handle_GlobalSet: {
+    auto& instruction = instructions[ip];
+    configuration.store().get(GlobalAddress { instruction.immediate })->set_value(Value { u128 { slots[instruction.sources[0]], 0 } });
+    DISPATCH_NEXT();
+}
+
+handle_Bridge: {
+    auto& instruction = instructions[ip];
+    auto& bridged = function.bridged_instructions()[instruction.immediate];
+    auto& value_stack = configuration.value_stack();
+    for (size_t i = 0; i < bridged.argument_count; ++i)
+        value_stack.append(Value { u128 { slots[instruction.sources[0] + i], 0 } });
+
+    interpret_bridged_instruction(configuration, *bridged.instruction);
+    if (did_trap())
+        return;
+
+    for (size_t i = bridged.result_count; i > 0; --i)
+        slots[instruction.destination + i - 1] = value_stack.take_last().value().low();
+    look_up_memory();
+    DISPATCH_NEXT();
+}
+
+handle_Unreachable: {
+    m_trap = Trap::from_string("Unreachable");
+    return;
+}
+
+handle_Return: {
+    auto first_result_slot = function.first_result_slot();
+    for (size_t i = 0; i < function.result_count(); ++i)
+        configuration.value_stack().append(Value { u128 { slots[first_result_slot + i], 0 } });
+    return;
+}
+
+#define HANDLE_UNARY_OPERATION(name, PopType, PushType, Operator)                                                   \
+    handle_##name:                                                                                                  \
+    {                                                                                                               \
+        auto& instruction = instructions[ip];                                                                       \
+        auto value = from_slot<PopType>(slots[instruction.sources[0]]);                                             \
+        if (auto error = store_operation_result<PushType>(slots[instruction.destination], Operator {}(value)); error.has_value()) { \
+            trap_if_not(false, *error);                                                                             \
+            return;                                                                                                 \
+        }                                                                                                           \
+        DISPATCH_NEXT();                                                                                            \
+    }
+    ENUMERATE_WASM_COMPILED_UNARY_OPERATIONS(HANDLE_UNARY_OPERATION)
+#undef HANDLE_UNARY_OPERATION
+
+#define HANDLE_BINARY_OPERATION(name, PopType, PushType, Operator)                                                       \
+    handle_##name:                                                                                                       \
+    {                                                                                                                    \
+        auto& instruction = instructions[ip];                                                                            \
+        auto lhs = from_slot<PopType>(slots[instruction.sources[0]]);                                                    \
+        auto rhs = from_slot<PopType>(slots[instruction.sources[1]]);                                                    \
+        if (auto error = store_operation_result<PushType>(slots[instruction.destination], Operator {}(lhs, rhs)); error.has_value()) { \
+            trap_if_not(false, *error);                                                                                  \
+            return;                                                                                                      \
+        }                                                                                                                \
+        DISPATCH_NEXT();                                                                                                 \
+    }
+    ENUMERATE_WASM_COMPILED_BINARY_OPERATIONS(HANDLE_BINARY_OPERATION)
+#undef HANDLE_BINARY_OPERATION
+
+#define HANDLE_LOAD(name, ReadType, PushType)                                                                             \
+    handle_##name:                                                                                                        \
+    {                                                                                                                     \
+        auto& instruction = instructions[ip];                                                                             \
+        u64 address = static_cast<u64>(from_slot<u32>(slots[instruction.sources[0]])) + instruction.immediate;            \
+        if (address + sizeof(ReadType) > memory->size()) [[unlikely]] {                                                   \
+            m_trap = Trap::from_string("Memory access out of bounds");                                                    \
+            return;                                                                                                       \
+        }                                                                                                                 \
+        auto value = static_cast<PushType>(read_from_memory<ReadType>(memory->data().data() + address));                  \
+        slots[instruction.destination] = to_slot<PushType>(value);                                                        \
+        DISPATCH_NEXT();                                                                                                  \
+    }
+    ENUMERATE_WASM_COMPILED_LOADS(HANDLE_LOAD)
+#undef HANDLE_LOAD
+
+#define HANDLE_STORE(name, PopType, StoreType)                                                                 \
+    handle_##name:                                                                                             \
+    {                                                                                                          \
+        auto& instruction = instructions[ip];                                                                  \
+        u64 address = static_cast<u64>(from_slot<u32>(slots[instruction.sources[0]])) + instruction.immediate; \
+        if (address + sizeof(StoreType) > memory->size()) [[unlikely]] {                                       \
+            m_trap = Trap::from_string("Memory access out of bounds");                                         \
+            return;                                                                                            \
+        }                                                                                                      \
+        auto value = static_cast<StoreType>(from_slot<PopType>(slots[instruction.sources[1]]));                \
+        write_to_memory(memory->data().data() + address, value);                                               \
+        DISPATCH_NEXT();                                                                                       \
+    }
+    ENUMERATE_WASM_COMPILED_STORES(HANDLE_STORE)
+#undef HANDLE_STORE
+
+#undef DISPATCH_NEXT
+#undef DISPATCH
+}
+
 void DebuggerBytecodeInterpreter::interpret_instruction(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     if (pre_interpret_hook) {
@@ -27,6 +27,13 @@ struct BytecodeInterpreter : public Interpreter {
         return m_trap.get<Trap>();
     }
     virtual void clear_trap() final { m_trap = Empty {}; }
+
+    // Functions that could be compiled are run from their compiled form if this is enabled. Off by default.
+    void set_compiled_functions_enabled(bool enabled) { m_compiled_functions_enabled = enabled; }
+
+    // The number of instructions run one at a time, i.e. not counting those run by compiled functions.
+    u64 executed_instruction_count() const { return m_executed_instruction_count; }
+    void reset_executed_instruction_count() { m_executed_instruction_count = 0; }
     virtual void visit_external_resources(HostVisitOps const& host) override
     {
         if (auto ptr = m_trap.get_pointer<Trap>())
@@ -54,6 +61,8 @@ struct BytecodeInterpreter : public Interpreter {
 
 protected:
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
+    void interpret_compiled_function(Configuration&, CompiledFunction const&);
+    void interpret_bridged_instruction(Configuration&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
@@ -104,6 +113,8 @@ protected:
 
     Variant<Trap, Empty> m_trap;
     StackInfo const& m_stack_info;
+    bool m_compiled_functions_enabled { false };
+    u64 m_executed_instruction_count { 0 };
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
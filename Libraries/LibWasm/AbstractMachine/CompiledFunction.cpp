@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/CompiledFunction.h>
+#include <LibWasm/Opcode.h>
+
+namespace Wasm {
+
+class FunctionCompiler {
+public:
+    FunctionCompiler(Store& store, ModuleInstance const& module, FunctionType const& type, CodeSection::Code const& code)
+        : m_store(store)
+        , m_module(module)
+        , m_type(type)
+        , m_code(code)
+        , m_function(adopt_ref(*new CompiledFunction))
+    {
+    }
+
+    RefPtr<CompiledFunction> compile();
+
+private:
+    // Operand stack slots come after the constants, so we only know where they are once the whole function has been
+    // compiled. Until then, they're tagged with their height and fixed up at the end.
+    static constexpr u32 stack_slot_tag = 1u << 31;
+
+    struct ControlFrame {
+        enum class Kind {
+            Block,
+            Loop,
+            If,
+            Else,
+        };
+
+        Kind kind { Kind::Block };
+        size_t height { 0 };
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+        size_t loop_start { 0 };
+        Vector<size_t> jumps_to_end {};
+        Optional<size_t> jump_to_else {};
+        bool unreachable { false };
+
+        size_t branch_arity() const { return kind == Kind::Loop ? parameter_count : result_count; }
+    };
+
+    struct BlockArity {
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+    };
+
+    static u32 stack_slot(size_t height) { return stack_slot_tag | height; }
+    bool is_local_slot(u32 slot) const { return slot < m_function->m_local_count; }
+
+    static bool is_numeric(Vector<ValueType> const& types)
+    {
+        return all_of(types, [](auto& type) { return type.is_numeric(); });
+    }
+
+    Optional<BlockArity> block_arity(BlockType const&) const;
+
+    size_t emit(CompiledInstruction instruction)
+    {
+        m_last_value_producer.clear();
+        m_function->m_instructions.append(instruction);
+        return m_function->m_instructions.size() - 1;
+    }
+
+    // Like emit(), but for instructions that only write their result into `destination`. Those can write straight into
+    // a local instead if the next instruction stores the value there.
+    void emit_value_producer(CompiledInstruction instruction)
+    {
+        m_last_value_producer = emit(instruction);
+    }
+
+    // Returns the index of the next instruction, which something is about to jump to.
+    size_t bind_label()
+    {
+        m_last_value_producer.clear();
+        return m_function->m_instructions.size();
+    }
+
+    u32 pop() { return m_operands.take_last(); }
+
+    u32 push_stack_value()
+    {
+        auto slot = stack_slot(m_operands.size());
+        m_operands.append(slot);
+        m_function->m_max_stack_height = max(m_function->m_max_stack_height, m_operands.size());
+        return slot;
+    }
+
+    void push_constant(u64 bits)
+    {
+        auto index = m_constant_indices.ensure(bits, [&] {
+            m_function->m_constants.append(bits);
+            return m_function->m_constants.size() - 1;
+        });
+        m_operands.append(m_function->m_local_count + index);
+    }
+
+    // Makes sure the value at the given height lives in its own stack slot, rather than in a local or constant slot.
+    void materialize(size_t height)
+    {
+        auto slot = stack_slot(height);
+        if (m_operands[height] == slot)
+            return;
+        emit({ .opcode = CompiledOpcode::Copy, .destination = slot, .sources = { m_operands[height], 0, 0 } });
+        m_operands[height] = slot;
+    }
+
+    void materialize_top(size_t count)
+    {
+        for (auto height = m_operands.size() - count; height < m_operands.size(); ++height)
+            materialize(height);
+    }
+
+    void materialize_local(u32 local_slot)
+    {
+        for (size_t height = 0; height < m_operands.size(); ++height) {
+            if (m_operands[height] == local_slot)
+                materialize(height);
+        }
+    }
+
+    // Values that refer to a local must be copied out before entering a block, since the different paths through it
+    // could otherwise disagree on where those values live once they meet again.
+    void materialize_locals()
+    {
+        for (size_t height = 0; height < m_operands.size(); ++height) {
+            if (is_local_slot(m_operands[height]))
+                materialize(height);
+        }
+    }
+
+    ControlFrame& frame_at_depth(LabelIndex depth) { return m_frames[m_frames.size() - 1 - depth.value()]; }
+
+    Vector<CompiledInstruction> branch_copies(ControlFrame const& target) const
+    {
+        Vector<CompiledInstruction> copies;
+        auto arity = target.branch_arity();
+        for (size_t i = 0; i < arity; ++i) {
+            auto source = m_operands[m_operands.size() - arity + i];
+            auto destination = stack_slot(target.height + i);
+            if (source != destination)
+                copies.append({ .opcode = CompiledOpcode::Copy, .destination = destination, .sources = { source, 0, 0 } });
+        }
+        return copies;
+    }
+
+    void emit_jump_to(ControlFrame& target, CompiledOpcode opcode, u32 condition = 0)
+    {
+        auto index = emit({ .opcode = opcode, .sources = { condition, 0, 0 } });
+        if (target.kind == ControlFrame::Kind::Loop)
+            m_function->m_instructions[index].immediate = target.loop_start;
+        else
+            target.jumps_to_end.append(index);
+    }
+
+    void emit_branch(LabelIndex depth)
+    {
+        auto& target = frame_at_depth(depth);
+        for (auto& copy : branch_copies(target))
+            emit(copy);
+        emit_jump_to(target, CompiledOpcode::Jump);
+    }
+
+    void emit_conditional_branch(LabelIndex depth, u32 condition)
+    {
+        auto& target = frame_at_depth(depth);
+        auto copies = branch_copies(target);
+        if (copies.is_empty()) {
+            emit_jump_to(target, CompiledOpcode::JumpIfNotZero, condition);
+            return;
+        }
+        auto skip = emit({ .opcode = CompiledOpcode::JumpIfZero, .sources = { condition, 0, 0 } });
+        for (auto& copy : copies)
+            emit(copy);
+        emit_jump_to(target, CompiledOpcode::Jump);
+        m_function->m_instructions[skip].immediate = bind_label();
+    }
+
+    void emit_bridge(Instruction const& instruction, size_t argument_count, size_t result_count)
+    {
+        materialize_top(argument_count);
+        auto base = stack_slot(m_operands.size() - argument_count);
+        m_operands.shrink(m_operands.size() - argument_count);
+        for (size_t i = 0; i < result_count; ++i)
+            push_stack_value();
+
+        m_function->m_bridged_instructions.append({ &instruction, static_cast<u32>(argument_count), static_cast<u32>(result_count) });
+        emit({ .opcode = CompiledOpcode::Bridge, .destination = base, .sources = { base, 0, 0 }, .immediate = m_function->m_bridged_instructions.size() - 1 });
+    }
+
+    void emit_local_set(LocalIndex index, u32 value)
+    {
+        auto local_slot = static_cast<u32>(index.value());
+        if (value == local_slot)
+            return;
+        materialize_local(local_slot);
+
+        // OPTIMIZATION: Let the instruction that computed the value write it to the local directly.
+        if (m_last_value_producer.has_value()) {
+            auto& producer = m_function->m_instructions[*m_last_value_producer];
+            if (producer.destination == value) {
+                producer.destination = local_slot;
+                m_last_value_producer.clear();
+                return;
+            }
+        }
+
+        emit({ .opcode = CompiledOpcode::Copy, .destination = local_slot, .sources = { value, 0, 0 } });
+    }
+
+    bool compile_instruction(Instruction const&);
+    void finish();
+
+    Store& m_store;
+    ModuleInstance const& m_module;
+    FunctionType const& m_type;
+    CodeSection::Code const& m_code;
+    NonnullRefPtr<CompiledFunction> m_function;
+
+    Vector<u32> m_operands;
+    Vector<ControlFrame> m_frames;
+    HashMap<u64, size_t> m_constant_indices;
+    Optional<size_t> m_last_value_producer;
+    // How many blocks deep we are into code that can't be reached.
+    size_t m_unreachable_depth { 0 };
+};
+
+RefPtr<CompiledFunction> CompiledFunction::try_compile(Store& store, ModuleInstance const& module, FunctionType const& type, CodeSection::Code const& code)
+{
+    return FunctionCompiler { store, module, type, code }.compile();
+}
+
+Optional<FunctionCompiler::BlockArity> FunctionCompiler::block_arity(BlockType const& block_type) const
+{
+    switch (block_type.kind()) {
+    case BlockType::Empty:
+        return BlockArity {};
+    case BlockType::Type:
+        if (!block_type.value_type().is_numeric())
+            return {};
+        return BlockArity { 0, 1 };
+    case BlockType::Index: {
+        auto& type = m_module.types()[block_type.type_index().value()];
+        if (!is_numeric(type.parameters()) || !is_numeric(type.results()))
+            return {};
+        return BlockArity { type.parameters().size(), type.results().size() };
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+RefPtr<CompiledFunction> FunctionCompiler::compile()
+{
+    if (!is_numeric(m_type.parameters()) || !is_numeric(m_type.results()))
+        return nullptr;
+
+    size_t local_count = m_type.parameters().size();
+    for (auto& locals : m_code.func().locals()) {
+        if (!locals.type().is_numeric())
+            return nullptr;
+        local_count += locals.n();
+    }
+    if (local_count >= stack_slot_tag)
+        return nullptr;
+    m_function->m_local_count = local_count;
+    m_function->m_result_count = m_type.results().size();
+
+    if (!m_module.memories().is_empty())
+        m_function->m_memory_address = m_module.memories().first().value();
+
+    m_frames.append({ .kind = ControlFrame::Kind::Block, .result_count = m_type.results().size() });
+
+    for (auto& instruction : m_code.func().body().instructions()) {
+        if (m_frames.last().unreachable) {
+            // Skip over everything up to the else or end of the current block, since nothing will ever run it.
+            switch (instruction.opcode().value()) {
+            case Instructions::block.value():
+            case Instructions::loop.value():
+            case Instructions::if_.value():
+                ++m_unreachable_depth;
+                continue;
+            case Instructions::structured_else.value():
+                if (m_unreachable_depth > 0)
+                    continue;
+                break;
+            case Instructions::structured_end.value():
+                if (m_unreachable_depth > 0) {
+                    --m_unreachable_depth;
+                    continue;
+                }
+                break;
+            default:
+                continue;
+            }
+        }
+
+        if (!compile_instruction(instruction))
+            return nullptr;
+    }
+
+    // The function body's own end.
+    if (m_frames.size() != 1)
+        return nullptr;
+    auto& frame = m_frames.last();
+    if (!frame.unreachable)
+        materialize_top(frame.result_count);
+    auto return_index = bind_label();
+    for (auto index : frame.jumps_to_end)
+        m_function->m_instructions[index].immediate = return_index;
+    emit({ .opcode = CompiledOpcode::Return });
+
+    finish();
+    return m_function;
+}
+
+bool FunctionCompiler::compile_instruction(Instruction const& instruction)
+{
+    switch (instruction.opcode().value()) {
+    case Instructions::unreachable.value():
+        emit({ .opcode = CompiledOpcode::Unreachable });
+        m_frames.last().unreachable = true;
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::if_.value(): {
+        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+        auto arity = block_arity(args.block_type);
+        if (!arity.has_value())
+            return false;
+
+        Optional<u32> condition;
+        if (instruction.opcode() == Instructions::if_)
+            condition = pop();
+
+        materialize_locals();
+        ControlFrame frame {
+            .height = m_operands.size() - arity->parameter_count,
+            .parameter_count = arity->parameter_count,
+            .result_count = arity->result_count,
+        };
+
+        if (instruction.opcode() == Instructions::block) {
+            frame.kind = ControlFrame::Kind::Block;
+        } else if (instruction.opcode() == Instructions::loop) {
+            materialize_top(arity->parameter_count);
+            frame.kind = ControlFrame::Kind::Loop;
+            frame.loop_start = bind_label();
+        } else {
+            // The parameters are passed on as the results if the condition is false and there's no else.
+            materialize_top(arity->parameter_count);
+            frame.kind = ControlFrame::Kind::If;
+            frame.jump_to_else = emit({ .opcode = CompiledOpcode::JumpIfZero, .sources = { *condition, 0, 0 } });
+        }
+        m_frames.append(move(frame));
+        return true;
+    }
+    case Instructions::structured_else.value(): {
+        auto& frame = m_frames.last();
+        if (!frame.unreachable) {
+            materialize_top(frame.result_count);
+            emit_jump_to(frame, CompiledOpcode::Jump);
+        }
+        m_function->m_instructions[*frame.jump_to_else].immediate = bind_label();
+        frame.jump_to_else.clear();
+        frame.kind = ControlFrame::Kind::Else;
+        frame.unreachable = false;
+
+        m_operands.shrink(frame.height);
+        for (size_t i = 0; i < frame.parameter_count; ++i)
+            push_stack_value();
+        return true;
+    }
+    case Instructions::structured_end.value(): {
+        auto frame = m_frames.take_last();
+        if (!frame.unreachable)
+            materialize_top(frame.result_count);
+        auto end = bind_label();
+        for (auto index : frame.jumps_to_end)
+            m_function->m_instructions[index].immediate = end;
+        if (frame.jump_to_else.has_value())
+            m_function->m_instructions[*frame.jump_to_else].immediate = end;
+
+        m_operands.shrink(frame.height);
+        for (size_t i = 0; i < frame.result_count; ++i)
+            push_stack_value();
+        return true;
+    }
+    case Instructions::br.value():
+        emit_branch(instruction.arguments().get<LabelIndex>());
+        m_frames.last().unreachable = true;
+        return true;
+    case Instructions::br_if.value():
+        emit_conditional_branch(instruction.arguments().get<LabelIndex>(), pop());
+        return true;
+    case Instructions::br_table.value(): {
+        auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto index = pop();
+        emit({ .opcode = CompiledOpcode::JumpTable, .sources = { index, 0, 0 }, .immediate = m_function->m_jump_tables.size() });
+
+        // Each distinct label gets a little stub that moves the results where the label wants them before jumping.
+        // The default label comes last.
+        Vector<u32> table;
+        table.ensure_capacity(args.labels.size() + 1);
+        HashMap<size_t, u32> stubs;
+        auto stub_for = [&](LabelIndex depth) {
+            return stubs.ensure(depth.value(), [&] {
+                auto stub = static_cast<u32>(bind_label());
+                emit_branch(depth);
+                return stub;
+            });
+        };
+        for (auto depth : args.labels)
+            table.unchecked_append(stub_for(depth));
+        table.unchecked_append(stub_for(args.default_));
+        m_function->m_jump_tables.append(move(table));
+
+        m_frames.last().unreachable = true;
+        return true;
+    }
+    case Instructions::return_.value(): {
+        for (auto& copy : branch_copies(m_frames.first()))
+            emit(copy);
+        emit({ .opcode = CompiledOpcode::Return });
+        m_frames.last().unreachable = true;
+        return true;
+    }
+    case Instructions::call.value(): {
+        auto address = m_module.functions()[instruction.arguments().get<FunctionIndex>().value()];
+        auto* function = m_store.get(address);
+        if (!function)
+            return false;
+        auto& type = function->visit([](auto& function) -> FunctionType const& { return function.type(); });
+        if (!is_numeric(type.parameters()) || !is_numeric(type.results()))
+            return false;
+        emit_bridge(instruction, type.parameters().size(), type.results().size());
+        return true;
+    }
+    case Instructions::call_indirect.value(): {
+        auto& type = m_module.types()[instruction.arguments().get<Instruction::IndirectCallArgs>().type.value()];
+        if (!is_numeric(type.parameters()) || !is_numeric(type.results()))
+            return false;
+        // The table index comes after the arguments.
+        emit_bridge(instruction, type.parameters().size() + 1, type.results().size());
+        return true;
+    }
+    case Instructions::drop.value():
+        pop();
+        return true;
+    case Instructions::select.value():
+    case Instructions::select_typed.value(): {
+        if (auto* types = instruction.arguments().get_pointer<Vector<ValueType>>(); types && !is_numeric(*types))
+            return false;
+        auto condition = pop();
+        auto rhs = pop();
+        auto lhs = pop();
+        auto destination = push_stack_value();
+        emit_value_producer({ .opcode = CompiledOpcode::Select, .destination = destination, .sources = { lhs, rhs, condition } });
+        return true;
+    }
+    case Instructions::local_get.value():
+        m_operands.append(static_cast<u32>(instruction.arguments().get<LocalIndex>().value()));
+        return true;
+    case Instructions::local_set.value():
+        emit_local_set(instruction.arguments().get<LocalIndex>(), pop());
+        return true;
+    case Instructions::local_tee.value(): {
+        auto index = instruction.arguments().get<LocalIndex>();
+        emit_local_set(index, pop());
+        m_operands.append(static_cast<u32>(index.value()));
+        return true;
+    }
+    case Instructions::global_get.value(): {
+        auto address = m_module.globals()[instruction.arguments().get<GlobalIndex>().value()];
+        auto* global = m_store.get(address);
+        if (!global || !global->type().type().is_numeric())
+            return false;
+        auto destination = push_stack_value();
+        emit_value_producer({ .opcode = CompiledOpcode::GlobalGet, .destination = destination, .immediate = address.value() });
+        return true;
+    }
+    case Instructions::global_set.value(): {
+        auto address = m_module.globals()[instruction.arguments().get<GlobalIndex>().value()];
+        auto* global = m_store.get(address);
+        if (!global || !global->type().type().is_numeric())
+            return false;
+        emit({ .opcode = CompiledOpcode::GlobalSet, .sources = { pop(), 0, 0 }, .immediate = address.value() });
+        return true;
+    }
+    // NOTE: Constants are encoded the same way Value encodes them, so slots can be turned into Values and back as-is.
+    case Instructions::i32_const.value():
+        push_constant(static_cast<u64>(static_cast<i64>(instruction.arguments().get<i32>())));
+        return true;
+    case Instructions::i64_const.value():
+        push_constant(bit_cast<u64>(instruction.arguments().get<i64>()));
+        return true;
+    case Instructions::f32_const.value():
+        push_constant(static_cast<u64>(static_cast<i64>(bit_cast<i32>(instruction.arguments().get<float>()))));
+        return true;
+    case Instructions::f64_const.value():
+        push_constant(bit_cast<u64>(instruction.arguments().get<double>()));
+        return true;
+    case Instructions::memory_size.value():
+        emit_bridge(instruction, 0, 1);
+        return true;
+    case Instructions::memory_grow.value():
+        emit_bridge(instruction, 1, 1);
+        return true;
+    case Instructions::memory_fill.value():
+    case Instructions::memory_copy.value():
+    case Instructions::memory_init.value():
+        emit_bridge(instruction, 3, 0);
+        return true;
+    case Instructions::data_drop.value():
+        emit_bridge(instruction, 0, 0);
+        return true;
+
+#define __COMPILE_UNARY_OPERATION(name, ...)                                                                          \
+    case Instructions::name.value(): {                                                                                \
+        auto source = pop();                                                                                          \
+        auto destination = push_stack_value();                                                                        \
+        emit_value_producer({ .opcode = CompiledOpcode::name, .destination = destination, .sources = { source, 0, 0 } }); \
+        return true;                                                                                                  \
+    }
+        ENUMERATE_WASM_COMPILED_UNARY_OPERATIONS(__COMPILE_UNARY_OPERATION)
+#undef __COMPILE_UNARY_OPERATION
+
+#define __COMPILE_BINARY_OPERATION(name, ...)                                                                          \
+    case Instructions::name.value(): {                                                                                 \
+        auto rhs = pop();                                                                                              \
+        auto lhs = pop();                                                                                              \
+        auto destination = push_stack_value();                                                                         \
+        emit_value_producer({ .opcode = CompiledOpcode::name, .destination = destination, .sources = { lhs, rhs, 0 } }); \
+        return true;                                                                                                   \
+    }
+        ENUMERATE_WASM_COMPILED_BINARY_OPERATIONS(__COMPILE_BINARY_OPERATION)
+#undef __COMPILE_BINARY_OPERATION
+
+#define __COMPILE_LOAD(name, ...)                                                                                                            \
+    case Instructions::name.value(): {                                                                                                       \
+        auto& memory_argument = instruction.arguments().get<Instruction::MemoryArgument>();                                                  \
+        if (memory_argument.memory_index.value() != 0) {                                                                                     \
+            emit_bridge(instruction, 1, 1);                                                                                                  \
+            return true;                                                                                                                     \
+        }                                                                                                                                    \
+        auto address = pop();                                                                                                                \
+        auto destination = push_stack_value();                                                                                               \
+        emit_value_producer({ .opcode = CompiledOpcode::name, .destination = destination, .sources = { address, 0, 0 }, .immediate = memory_argument.offset }); \
+        return true;                                                                                                                         \
+    }
+        ENUMERATE_WASM_COMPILED_LOADS(__COMPILE_LOAD)
+#undef __COMPILE_LOAD
+
+#define __COMPILE_STORE(name, ...)                                                                                           \
+    case Instructions::name.value(): {                                                                                       \
+        auto& memory_argument = instruction.arguments().get<Instruction::MemoryArgument>();                                  \
+        if (memory_argument.memory_index.value() != 0) {                                                                     \
+            emit_bridge(instruction, 2, 0);                                                                                  \
+            return true;                                                                                                     \
+        }                                                                                                                    \
+        auto value = pop();                                                                                                  \
+        auto address = pop();                                                                                                \
+        emit({ .opcode = CompiledOpcode::name, .sources = { address, value, 0 }, .immediate = memory_argument.offset }); \
+        return true;                                                                                                         \
+    }
+        ENUMERATE_WASM_COMPILED_STORES(__COMPILE_STORE)
+#undef __COMPILE_STORE
+
+    default:
+        return false;
+    }
+}
+
+void FunctionCompiler::finish()
+{
+    auto first_stack_slot = m_function->m_local_count + m_function->m_constants.size();
+    auto fix_up = [&](u32& slot) {
+        if (slot & stack_slot_tag)
+            slot = first_stack_slot + (slot & ~stack_slot_tag);
+    };
+
+    for (auto& instruction : m_function->m_instructions) {
+        fix_up(instruction.destination);
+        for (auto& source : instruction.sources)
+            fix_up(source);
+    }
+}
+
+}
@@ -37,6 +37,7 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
             wasm_function->code().func().body(),
             wasm_function->type().results().size(),
         });
+        frame().set_compiled_function(wasm_function->compiled_function(m_store));
         m_ip = 0;
         return execute(interpreter);
     }
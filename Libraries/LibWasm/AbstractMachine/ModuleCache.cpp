@@ -0,0 +1,914 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/Hex.h>
+#include <AK/LexicalPath.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
+#include <unistd.h>
+
+namespace Wasm {
+
+static constexpr u32 cache_file_magic = 0x43534157; // "WASC"
+
+// NOTE: Bump this whenever the layout of the cache files changes, or when a type stored in them changes shape
+//       (e.g. an alternative is added to Instruction's arguments).
+static constexpr u32 cache_format_version = 2;
+
+// Every file ends in the SHA-256 of everything before it.
+static constexpr size_t checksum_size = 32;
+
+ModuleCache& ModuleCache::the()
+{
+    static ModuleCache cache;
+    return cache;
+}
+
+void ModuleCache::set_directory(ByteString directory)
+{
+    m_directory = move(directory);
+}
+
+Optional<ByteString> ModuleCache::path_for(ReadonlyBytes module_bytes) const
+{
+    if (!m_directory.has_value())
+        return {};
+
+    auto hasher = Crypto::Hash::SHA256::create();
+    hasher->update(reinterpret_cast<u8 const*>(&cache_format_version), sizeof(cache_format_version));
+    hasher->update(module_bytes);
+    return ByteString::formatted("{}/{}.wasmc", *m_directory, encode_hex(hasher->digest().bytes()));
+}
+
+// NOTE: Cache files are written and read in one go, so these work on memory directly instead of going through Stream.
+//       Going through Stream for each of the many small values in a module's code makes up most of the time otherwise.
+class Encoder {
+public:
+    template<typename T>
+    ALWAYS_INLINE ErrorOr<void> write_value(T const& value)
+    {
+        return write_until_depleted({ &value, sizeof(T) });
+    }
+
+    ALWAYS_INLINE ErrorOr<void> write_until_depleted(ReadonlyBytes bytes)
+    {
+        return m_buffer.try_append(bytes);
+    }
+
+    ReadonlyBytes bytes() const { return m_buffer.bytes(); }
+
+private:
+    ByteBuffer m_buffer;
+};
+
+class Decoder {
+public:
+    explicit Decoder(ReadonlyBytes bytes)
+        : m_bytes(bytes)
+    {
+    }
+
+    template<typename T>
+    ALWAYS_INLINE ErrorOr<T> read_value()
+    {
+        T value;
+        TRY(read_until_filled({ &value, sizeof(T) }));
+        return value;
+    }
+
+    ALWAYS_INLINE ErrorOr<void> read_until_filled(Bytes bytes)
+    {
+        if (bytes.size() > m_bytes.size() - m_offset)
+            return Error::from_string_literal("Unexpected end of module cache file");
+        __builtin_memcpy(bytes.data(), m_bytes.offset_pointer(m_offset), bytes.size());
+        m_offset += bytes.size();
+        return {};
+    }
+
+    bool is_eof() const { return m_offset == m_bytes.size(); }
+
+private:
+    ReadonlyBytes m_bytes;
+    size_t m_offset { 0 };
+};
+
+// Every type that appears in a Module gets a Serializer with an encode() and a decode() function.
+// Most of the types in Types.h aren't default-constructible, so decode() returns a fully constructed value.
+template<typename T>
+struct Serializer;
+
+template<Arithmetic T>
+struct Serializer<T> {
+    static ErrorOr<void> encode(Encoder& encoder, T value) { return encoder.write_value(value); }
+    static ErrorOr<T> decode(Decoder& decoder) { return decoder.read_value<T>(); }
+};
+
+template<typename T, typename X, typename... Opts>
+struct Serializer<DistinctNumeric<T, X, Opts...>> {
+    static ErrorOr<void> encode(Encoder& encoder, DistinctNumeric<T, X, Opts...> value) { return encoder.write_value<u64>(value.value()); }
+    static ErrorOr<DistinctNumeric<T, X, Opts...>> decode(Decoder& decoder) { return DistinctNumeric<T, X, Opts...> { static_cast<T>(TRY(decoder.read_value<u64>())) }; }
+};
+
+template<typename T>
+static ErrorOr<void> encode(Encoder& encoder, T const& value)
+{
+    return Serializer<T>::encode(encoder, value);
+}
+
+template<typename T>
+static ErrorOr<T> decode(Decoder& decoder)
+{
+    return Serializer<T>::decode(decoder);
+}
+
+template<>
+struct Serializer<u128> {
+    static ErrorOr<void> encode(Encoder& encoder, u128 value)
+    {
+        TRY(encoder.write_value<u64>(value.low()));
+        TRY(encoder.write_value<u64>(value.high()));
+        return {};
+    }
+    static ErrorOr<u128> decode(Decoder& decoder)
+    {
+        auto low = TRY(decoder.read_value<u64>());
+        auto high = TRY(decoder.read_value<u64>());
+        return u128 { low, high };
+    }
+};
+
+template<typename T>
+struct Serializer<Optional<T>> {
+    static ErrorOr<void> encode(Encoder& encoder, Optional<T> const& value)
+    {
+        TRY(encoder.write_value<u8>(value.has_value()));
+        if (value.has_value())
+            TRY(Wasm::encode(encoder, *value));
+        return {};
+    }
+    static ErrorOr<Optional<T>> decode(Decoder& decoder)
+    {
+        if (!TRY(decoder.read_value<u8>()))
+            return Optional<T> {};
+        return Optional<T> { TRY(Wasm::decode<T>(decoder)) };
+    }
+};
+
+template<typename T, size_t inline_capacity>
+struct Serializer<Vector<T, inline_capacity>> {
+    static ErrorOr<void> encode(Encoder& encoder, Vector<T, inline_capacity> const& vector)
+    {
+        TRY(encoder.write_value<u64>(vector.size()));
+        if constexpr (IsSame<T, u8>) {
+            TRY(encoder.write_until_depleted(vector.span()));
+        } else {
+            for (auto const& element : vector)
+                TRY(Wasm::encode(encoder, element));
+        }
+        return {};
+    }
+    static ErrorOr<Vector<T, inline_capacity>> decode(Decoder& decoder)
+    {
+        auto size = TRY(decoder.read_value<u64>());
+        Vector<T, inline_capacity> vector;
+        if constexpr (IsSame<T, u8>) {
+            TRY(vector.try_resize(size));
+            TRY(decoder.read_until_filled(vector.span()));
+        } else {
+            TRY(vector.try_ensure_capacity(size));
+            for (u64 i = 0; i < size; ++i)
+                vector.unchecked_append(TRY(Wasm::decode<T>(decoder)));
+        }
+        return vector;
+    }
+};
+
+template<typename... Ts>
+struct Serializer<Variant<Ts...>> {
+    static ErrorOr<void> encode(Encoder& encoder, Variant<Ts...> const& variant)
+    {
+        TRY(encoder.write_value<u8>(variant.index()));
+        return variant.visit([&]<typename T>(T const& value) { return Wasm::encode(encoder, value); });
+    }
+    static ErrorOr<Variant<Ts...>> decode(Decoder& decoder)
+    {
+        Optional<Variant<Ts...>> variant;
+        TRY(decode_and_visit(decoder, [&](auto value) { variant = Variant<Ts...> { move(value) }; }));
+        return variant.release_value();
+    }
+
+    // Decodes the stored alternative and hands it to the callback as its own type, which lets the caller construct
+    // a variant in place instead of moving one around.
+    template<typename Callback>
+    static ErrorOr<void> decode_and_visit(Decoder& decoder, Callback&& callback)
+    {
+        return decode_alternative<0, Ts...>(decoder, TRY(decoder.read_value<u8>()), callback);
+    }
+
+private:
+    template<size_t index, typename T, typename... Rest, typename Callback>
+    static ErrorOr<void> decode_alternative(Decoder& decoder, u8 stored_index, Callback& callback)
+    {
+        if (stored_index == index) {
+            callback(TRY(Wasm::decode<T>(decoder)));
+            return {};
+        }
+        if constexpr (sizeof...(Rest) > 0)
+            return decode_alternative<index + 1, Rest...>(decoder, stored_index, callback);
+        else
+            return Error::from_string_literal("Invalid variant index in module cache file");
+    }
+};
+
+template<>
+struct Serializer<ByteBuffer> {
+    static ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& buffer)
+    {
+        TRY(encoder.write_value<u64>(buffer.size()));
+        TRY(encoder.write_until_depleted(buffer.bytes()));
+        return {};
+    }
+    static ErrorOr<ByteBuffer> decode(Decoder& decoder)
+    {
+        auto buffer = TRY(ByteBuffer::create_uninitialized(TRY(decoder.read_value<u64>())));
+        TRY(decoder.read_until_filled(buffer.bytes()));
+        return buffer;
+    }
+};
+
+template<>
+struct Serializer<ByteString> {
+    static ErrorOr<void> encode(Encoder& encoder, ByteString const& string)
+    {
+        TRY(encoder.write_value<u64>(string.length()));
+        TRY(encoder.write_until_depleted(string.bytes()));
+        return {};
+    }
+    static ErrorOr<ByteString> decode(Decoder& decoder)
+    {
+        auto buffer = TRY(Wasm::decode<ByteBuffer>(decoder));
+        return ByteString { buffer.bytes() };
+    }
+};
+
+template<>
+struct Serializer<ValueType> {
+    static ErrorOr<void> encode(Encoder& encoder, ValueType type) { return encoder.write_value<u8>(type.kind()); }
+    static ErrorOr<ValueType> decode(Decoder& decoder)
+    {
+        auto kind = TRY(decoder.read_value<u8>());
+        if (kind > ValueType::ExternReference)
+            return Error::from_string_literal("Invalid value type in module cache file");
+        return ValueType { static_cast<ValueType::Kind>(kind) };
+    }
+};
+
+template<>
+struct Serializer<FunctionType> {
+    static ErrorOr<void> encode(Encoder& encoder, FunctionType const& type)
+    {
+        TRY(Wasm::encode(encoder, type.parameters()));
+        TRY(Wasm::encode(encoder, type.results()));
+        return {};
+    }
+    static ErrorOr<FunctionType> decode(Decoder& decoder)
+    {
+        auto parameters = TRY(Wasm::decode<Vector<ValueType>>(decoder));
+        auto results = TRY(Wasm::decode<Vector<ValueType>>(decoder));
+        return FunctionType { move(parameters), move(results) };
+    }
+};
+
+template<>
+struct Serializer<Limits> {
+    static ErrorOr<void> encode(Encoder& encoder, Limits const& limits)
+    {
+        TRY(encoder.write_value<u32>(limits.min()));
+        TRY(Wasm::encode(encoder, limits.max()));
+        return {};
+    }
+    static ErrorOr<Limits> decode(Decoder& decoder)
+    {
+        auto min = TRY(decoder.read_value<u32>());
+        auto max = TRY(Wasm::decode<Optional<u32>>(decoder));
+        return Limits { min, max };
+    }
+};
+
+template<>
+struct Serializer<MemoryType> {
+    static ErrorOr<void> encode(Encoder& encoder, MemoryType const& type) { return Wasm::encode(encoder, type.limits()); }
+    static ErrorOr<MemoryType> decode(Decoder& decoder) { return MemoryType { TRY(Wasm::decode<Limits>(decoder)) }; }
+};
+
+template<>
+struct Serializer<TableType> {
+    static ErrorOr<void> encode(Encoder& encoder, TableType const& type)
+    {
+        TRY(Wasm::encode(encoder, type.element_type()));
+        TRY(Wasm::encode(encoder, type.limits()));
+        return {};
+    }
+    static ErrorOr<TableType> decode(Decoder& decoder)
+    {
+        auto element_type = TRY(Wasm::decode<ValueType>(decoder));
+        if (!element_type.is_reference())
+            return Error::from_string_literal("Invalid table element type in module cache file");
+        auto limits = TRY(Wasm::decode<Limits>(decoder));
+        return TableType { element_type, limits };
+    }
+};
+
+template<>
+struct Serializer<GlobalType> {
+    static ErrorOr<void> encode(Encoder& encoder, GlobalType const& type)
+    {
+        TRY(Wasm::encode(encoder, type.type()));
+        TRY(encoder.write_value<u8>(type.is_mutable()));
+        return {};
+    }
+    static ErrorOr<GlobalType> decode(Decoder& decoder)
+    {
+        auto type = TRY(Wasm::decode<ValueType>(decoder));
+        auto is_mutable = TRY(decoder.read_value<u8>()) != 0;
+        return GlobalType { type, is_mutable };
+    }
+};
+
+template<>
+struct Serializer<BlockType> {
+    static ErrorOr<void> encode(Encoder& encoder, BlockType const& type)
+    {
+        TRY(encoder.write_value<u8>(type.kind()));
+        switch (type.kind()) {
+        case BlockType::Empty:
+            return {};
+        case BlockType::Type:
+            return Wasm::encode(encoder, type.value_type());
+        case BlockType::Index:
+            return Wasm::encode(encoder, type.type_index());
+        }
+        VERIFY_NOT_REACHED();
+    }
+    static ErrorOr<BlockType> decode(Decoder& decoder)
+    {
+        switch (TRY(decoder.read_value<u8>())) {
+        case BlockType::Empty:
+            return BlockType {};
+        case BlockType::Type:
+            return BlockType { TRY(Wasm::decode<ValueType>(decoder)) };
+        case BlockType::Index:
+            return BlockType { TRY(Wasm::decode<TypeIndex>(decoder)) };
+        }
+        return Error::from_string_literal("Invalid block type in module cache file");
+    }
+};
+
+template<>
+struct Serializer<Instruction::TableElementArgs> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::TableElementArgs const& args)
+    {
+        TRY(Wasm::encode(encoder, args.element_index));
+        TRY(Wasm::encode(encoder, args.table_index));
+        return {};
+    }
+    static ErrorOr<Instruction::TableElementArgs> decode(Decoder& decoder)
+    {
+        auto element_index = TRY(Wasm::decode<ElementIndex>(decoder));
+        auto table_index = TRY(Wasm::decode<TableIndex>(decoder));
+        return Instruction::TableElementArgs { element_index, table_index };
+    }
+};
+
+template<>
+struct Serializer<Instruction::TableTableArgs> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::TableTableArgs const& args)
+    {
+        TRY(Wasm::encode(encoder, args.lhs));
+        TRY(Wasm::encode(encoder, args.rhs));
+        return {};
+    }
+    static ErrorOr<Instruction::TableTableArgs> decode(Decoder& decoder)
+    {
+        auto lhs = TRY(Wasm::decode<TableIndex>(decoder));
+        auto rhs = TRY(Wasm::decode<TableIndex>(decoder));
+        return Instruction::TableTableArgs { lhs, rhs };
+    }
+};
+
+template<>
+struct Serializer<Instruction::StructuredInstructionArgs> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::StructuredInstructionArgs const& args)
+    {
+        TRY(Wasm::encode(encoder, args.block_type));
+        TRY(Wasm::encode(encoder, args.end_ip));
+        TRY(Wasm::encode(encoder, args.else_ip));
+        return {};
+    }
+    static ErrorOr<Instruction::StructuredInstructionArgs> decode(Decoder& decoder)
+    {
+        auto block_type = TRY(Wasm::decode<BlockType>(decoder));
+        auto end_ip = TRY(Wasm::decode<InstructionPointer>(decoder));
+        auto else_ip = TRY(Wasm::decode<Optional<InstructionPointer>>(decoder));
+        return Instruction::StructuredInstructionArgs { block_type, end_ip, else_ip };
+    }
+};
+
+template<>
+struct Serializer<Instruction::TableBranchArgs> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::TableBranchArgs const& args)
+    {
+        TRY(Wasm::encode(encoder, args.labels));
+        TRY(Wasm::encode(encoder, args.default_));
+        return {};
+    }
+    static ErrorOr<Instruction::TableBranchArgs> decode(Decoder& decoder)
+    {
+        auto labels = TRY(Wasm::decode<Vector<LabelIndex>>(decoder));
+        auto default_ = TRY(Wasm::decode<LabelIndex>(decoder));
+        return Instruction::TableBranchArgs { move(labels), default_ };
+    }
+};
+
+template<>
+struct Serializer<Instruction::IndirectCallArgs> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::IndirectCallArgs const& args)
+    {
+        TRY(Wasm::encode(encoder, args.type));
+        TRY(Wasm::encode(encoder, args.table));
+        return {};
+    }
+    static ErrorOr<Instruction::IndirectCallArgs> decode(Decoder& decoder)
+    {
+        auto type = TRY(Wasm::decode<TypeIndex>(decoder));
+        auto table = TRY(Wasm::decode<TableIndex>(decoder));
+        return Instruction::IndirectCallArgs { type, table };
+    }
+};
+
+template<>
+struct Serializer<Instruction::MemoryArgument> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::MemoryArgument const& args)
+    {
+        TRY(encoder.write_value<u32>(args.align));
+        TRY(encoder.write_value<u32>(args.offset));
+        TRY(Wasm::encode(encoder, args.memory_index));
+        return {};
+    }
+    static ErrorOr<Instruction::MemoryArgument> decode(Decoder& decoder)
+    {
+        auto align = TRY(decoder.read_value<u32>());
+        auto offset = TRY(decoder.read_value<u32>());
+        auto memory_index = TRY(Wasm::decode<MemoryIndex>(decoder));
+        return Instruction::MemoryArgument { align, offset, memory_index };
+    }
+};
+
+template<>
+struct Serializer<Instruction::MemoryAndLaneArgument> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::MemoryAndLaneArgument const& args)
+    {
+        TRY(Wasm::encode(encoder, args.memory));
+        TRY(encoder.write_value<u8>(args.lane));
+        return {};
+    }
+    static ErrorOr<Instruction::MemoryAndLaneArgument> decode(Decoder& decoder)
+    {
+        auto memory = TRY(Wasm::decode<Instruction::MemoryArgument>(decoder));
+        auto lane = TRY(decoder.read_value<u8>());
+        return Instruction::MemoryAndLaneArgument { memory, lane };
+    }
+};
+
+template<>
+struct Serializer<Instruction::LaneIndex> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::LaneIndex const& args) { return encoder.write_value<u8>(args.lane); }
+    static ErrorOr<Instruction::LaneIndex> decode(Decoder& decoder) { return Instruction::LaneIndex { TRY(decoder.read_value<u8>()) }; }
+};
+
+template<>
+struct Serializer<Instruction::MemoryCopyArgs> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::MemoryCopyArgs const& args)
+    {
+        TRY(Wasm::encode(encoder, args.src_index));
+        TRY(Wasm::encode(encoder, args.dst_index));
+        return {};
+    }
+    static ErrorOr<Instruction::MemoryCopyArgs> decode(Decoder& decoder)
+    {
+        auto src_index = TRY(Wasm::decode<MemoryIndex>(decoder));
+        auto dst_index = TRY(Wasm::decode<MemoryIndex>(decoder));
+        return Instruction::MemoryCopyArgs { src_index, dst_index };
+    }
+};
+
+template<>
+struct Serializer<Instruction::MemoryInitArgs> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::MemoryInitArgs const& args)
+    {
+        TRY(Wasm::encode(encoder, args.data_index));
+        TRY(Wasm::encode(encoder, args.memory_index));
+        return {};
+    }
+    static ErrorOr<Instruction::MemoryInitArgs> decode(Decoder& decoder)
+    {
+        auto data_index = TRY(Wasm::decode<DataIndex>(decoder));
+        auto memory_index = TRY(Wasm::decode<MemoryIndex>(decoder));
+        return Instruction::MemoryInitArgs { data_index, memory_index };
+    }
+};
+
+template<>
+struct Serializer<Instruction::MemoryIndexArgument> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::MemoryIndexArgument const& args) { return Wasm::encode(encoder, args.memory_index); }
+    static ErrorOr<Instruction::MemoryIndexArgument> decode(Decoder& decoder) { return Instruction::MemoryIndexArgument { TRY(Wasm::decode<MemoryIndex>(decoder)) }; }
+};
+
+template<>
+struct Serializer<Instruction::ShuffleArgument> {
+    static ErrorOr<void> encode(Encoder& encoder, Instruction::ShuffleArgument const& args) { return encoder.write_until_depleted({ args.lanes, sizeof(args.lanes) }); }
+    static ErrorOr<Instruction::ShuffleArgument> decode(Decoder& decoder)
+    {
+        u8 lanes[16];
+        TRY(decoder.read_until_filled({ lanes, sizeof(lanes) }));
+        return Instruction::ShuffleArgument { lanes };
+    }
+};
+
+template<>
+struct Serializer<Expression> {
+    using Arguments = RemoveCVReference<decltype(declval<Instruction>().arguments())>;
+
+    static ErrorOr<void> encode(Encoder& encoder, Expression const& expression)
+    {
+        TRY(encoder.write_value<u64>(expression.instructions().size()));
+        for (auto const& instruction : expression.instructions()) {
+            TRY(Wasm::encode(encoder, instruction.opcode()));
+            TRY(Wasm::encode(encoder, instruction.arguments()));
+        }
+        return {};
+    }
+    static ErrorOr<Expression> decode(Decoder& decoder)
+    {
+        auto size = TRY(decoder.read_value<u64>());
+        Vector<Instruction> instructions;
+        TRY(instructions.try_ensure_capacity(size));
+        for (u64 i = 0; i < size; ++i) {
+            auto opcode = TRY(Wasm::decode<OpCode>(decoder));
+            TRY(Serializer<Arguments>::decode_and_visit(decoder, [&](auto argument) {
+                instructions.empend(opcode, move(argument));
+            }));
+        }
+        return Expression { move(instructions) };
+    }
+};
+
+template<>
+struct Serializer<CustomSection> {
+    static ErrorOr<void> encode(Encoder& encoder, CustomSection const& section)
+    {
+        TRY(Wasm::encode(encoder, section.name()));
+        TRY(Wasm::encode(encoder, section.contents()));
+        return {};
+    }
+    static ErrorOr<CustomSection> decode(Decoder& decoder)
+    {
+        auto name = TRY(Wasm::decode<ByteString>(decoder));
+        auto contents = TRY(Wasm::decode<ByteBuffer>(decoder));
+        return CustomSection { move(name), move(contents) };
+    }
+};
+
+template<>
+struct Serializer<ImportSection::Import> {
+    static ErrorOr<void> encode(Encoder& encoder, ImportSection::Import const& import)
+    {
+        TRY(Wasm::encode(encoder, import.module()));
+        TRY(Wasm::encode(encoder, import.name()));
+        TRY(Wasm::encode(encoder, import.description()));
+        return {};
+    }
+    static ErrorOr<ImportSection::Import> decode(Decoder& decoder)
+    {
+        auto module = TRY(Wasm::decode<ByteString>(decoder));
+        auto name = TRY(Wasm::decode<ByteString>(decoder));
+        auto description = TRY(Wasm::decode<ImportSection::Import::ImportDesc>(decoder));
+        return ImportSection::Import { move(module), move(name), move(description) };
+    }
+};
+
+template<>
+struct Serializer<TableSection::Table> {
+    static ErrorOr<void> encode(Encoder& encoder, TableSection::Table const& table) { return Wasm::encode(encoder, table.type()); }
+    static ErrorOr<TableSection::Table> decode(Decoder& decoder) { return TableSection::Table { TRY(Wasm::decode<TableType>(decoder)) }; }
+};
+
+template<>
+struct Serializer<MemorySection::Memory> {
+    static ErrorOr<void> encode(Encoder& encoder, MemorySection::Memory const& memory) { return Wasm::encode(encoder, memory.type()); }
+    static ErrorOr<MemorySection::Memory> decode(Decoder& decoder) { return MemorySection::Memory { TRY(Wasm::decode<MemoryType>(decoder)) }; }
+};
+
+template<>
+struct Serializer<GlobalSection::Global> {
+    static ErrorOr<void> encode(Encoder& encoder, GlobalSection::Global const& global)
+    {
+        TRY(Wasm::encode(encoder, global.type()));
+        TRY(Wasm::encode(encoder, global.expression()));
+        return {};
+    }
+    static ErrorOr<GlobalSection::Global> decode(Decoder& decoder)
+    {
+        auto type = TRY(Wasm::decode<GlobalType>(decoder));
+        auto expression = TRY(Wasm::decode<Expression>(decoder));
+        return GlobalSection::Global { type, move(expression) };
+    }
+};
+
+template<>
+struct Serializer<ExportSection::Export> {
+    using Description = RemoveCVReference<decltype(declval<ExportSection::Export>().description())>;
+
+    static ErrorOr<void> encode(Encoder& encoder, ExportSection::Export const& export_)
+    {
+        TRY(Wasm::encode(encoder, export_.name()));
+        TRY(Wasm::encode(encoder, export_.description()));
+        return {};
+    }
+    static ErrorOr<ExportSection::Export> decode(Decoder& decoder)
+    {
+        auto name = TRY(Wasm::decode<ByteString>(decoder));
+        auto description = TRY(Wasm::decode<Description>(decoder));
+        return ExportSection::Export { move(name), move(description) };
+    }
+};
+
+template<>
+struct Serializer<StartSection::StartFunction> {
+    static ErrorOr<void> encode(Encoder& encoder, StartSection::StartFunction const& function) { return Wasm::encode(encoder, function.index()); }
+    static ErrorOr<StartSection::StartFunction> decode(Decoder& decoder) { return StartSection::StartFunction { TRY(Wasm::decode<FunctionIndex>(decoder)) }; }
+};
+
+template<>
+struct Serializer<ElementSection::Active> {
+    static ErrorOr<void> encode(Encoder& encoder, ElementSection::Active const& active)
+    {
+        TRY(Wasm::encode(encoder, active.index));
+        TRY(Wasm::encode(encoder, active.expression));
+        return {};
+    }
+    static ErrorOr<ElementSection::Active> decode(Decoder& decoder)
+    {
+        auto index = TRY(Wasm::decode<TableIndex>(decoder));
+        auto expression = TRY(Wasm::decode<Expression>(decoder));
+        return ElementSection::Active { index, move(expression) };
+    }
+};
+
+template<>
+struct Serializer<ElementSection::Passive> {
+    static ErrorOr<void> encode(Encoder&, ElementSection::Passive const&) { return {}; }
+    static ErrorOr<ElementSection::Passive> decode(Decoder&) { return ElementSection::Passive {}; }
+};
+
+template<>
+struct Serializer<ElementSection::Declarative> {
+    static ErrorOr<void> encode(Encoder&, ElementSection::Declarative const&) { return {}; }
+    static ErrorOr<ElementSection::Declarative> decode(Decoder&) { return ElementSection::Declarative {}; }
+};
+
+template<>
+struct Serializer<ElementSection::Element> {
+    static ErrorOr<void> encode(Encoder& encoder, ElementSection::Element const& element)
+    {
+        TRY(Wasm::encode(encoder, element.type));
+        TRY(Wasm::encode(encoder, element.init));
+        TRY(Wasm::encode(encoder, element.mode));
+        return {};
+    }
+    static ErrorOr<ElementSection::Element> decode(Decoder& decoder)
+    {
+        auto type = TRY(Wasm::decode<ValueType>(decoder));
+        auto init = TRY(Wasm::decode<Vector<Expression>>(decoder));
+        auto mode = TRY((Wasm::decode<Variant<ElementSection::Active, ElementSection::Passive, ElementSection::Declarative>>(decoder)));
+        return ElementSection::Element { type, move(init), move(mode) };
+    }
+};
+
+template<>
+struct Serializer<Locals> {
+    static ErrorOr<void> encode(Encoder& encoder, Locals const& locals)
+    {
+        TRY(encoder.write_value<u32>(locals.n()));
+        TRY(Wasm::encode(encoder, locals.type()));
+        return {};
+    }
+    static ErrorOr<Locals> decode(Decoder& decoder)
+    {
+        auto n = TRY(decoder.read_value<u32>());
+        auto type = TRY(Wasm::decode<ValueType>(decoder));
+        return Locals { n, type };
+    }
+};
+
+template<>
+struct Serializer<CodeSection::Code> {
+    static ErrorOr<void> encode(Encoder& encoder, CodeSection::Code const& code)
+    {
+        TRY(encoder.write_value<u32>(code.size()));
+        TRY(Wasm::encode(encoder, code.func().locals()));
+        TRY(Wasm::encode(encoder, code.func().body()));
+        return {};
+    }
+    static ErrorOr<CodeSection::Code> decode(Decoder& decoder)
+    {
+        auto size = TRY(decoder.read_value<u32>());
+        auto locals = TRY(Wasm::decode<Vector<Locals>>(decoder));
+        auto body = TRY(Wasm::decode<Expression>(decoder));
+        return CodeSection::Code { size, CodeSection::Func { move(locals), move(body) } };
+    }
+};
+
+template<>
+struct Serializer<DataSection::Data::Passive> {
+    static ErrorOr<void> encode(Encoder& encoder, DataSection::Data::Passive const& passive) { return Wasm::encode(encoder, passive.init); }
+    static ErrorOr<DataSection::Data::Passive> decode(Decoder& decoder) { return DataSection::Data::Passive { TRY(Wasm::decode<Vector<u8>>(decoder)) }; }
+};
+
+template<>
+struct Serializer<DataSection::Data::Active> {
+    static ErrorOr<void> encode(Encoder& encoder, DataSection::Data::Active const& active)
+    {
+        TRY(Wasm::encode(encoder, active.init));
+        TRY(Wasm::encode(encoder, active.index));
+        TRY(Wasm::encode(encoder, active.offset));
+        return {};
+    }
+    static ErrorOr<DataSection::Data::Active> decode(Decoder& decoder)
+    {
+        auto init = TRY(Wasm::decode<Vector<u8>>(decoder));
+        auto index = TRY(Wasm::decode<MemoryIndex>(decoder));
+        auto offset = TRY(Wasm::decode<Expression>(decoder));
+        return DataSection::Data::Active { move(init), index, move(offset) };
+    }
+};
+
+template<>
+struct Serializer<DataSection::Data> {
+    static ErrorOr<void> encode(Encoder& encoder, DataSection::Data const& data) { return Wasm::encode(encoder, data.value()); }
+    static ErrorOr<DataSection::Data> decode(Decoder& decoder) { return DataSection::Data { TRY(Wasm::decode<DataSection::Data::Value>(decoder)) }; }
+};
+
+static ErrorOr<void> serialize_module(Encoder& encoder, Module const& module)
+{
+    TRY(encoder.write_value(cache_file_magic));
+    TRY(encoder.write_value(cache_format_version));
+
+    TRY(encode(encoder, module.custom_sections()));
+    TRY(encode(encoder, module.type_section().types()));
+    TRY(encode(encoder, module.import_section().imports()));
+    TRY(encode(encoder, module.function_section().types()));
+    TRY(encode(encoder, module.table_section().tables()));
+    TRY(encode(encoder, module.memory_section().memories()));
+    TRY(encode(encoder, module.global_section().entries()));
+    TRY(encode(encoder, module.export_section().entries()));
+    TRY(encode(encoder, module.start_section().function()));
+    TRY(encode(encoder, module.element_section().segments()));
+    TRY(encode(encoder, module.code_section().functions()));
+    TRY(encode(encoder, module.data_section().data()));
+    TRY(encode(encoder, module.data_count_section().count()));
+
+    TRY(encoder.write_value(cache_file_magic));
+    return {};
+}
+
+static ErrorOr<NonnullRefPtr<Module>> deserialize_module(Decoder& decoder)
+{
+    if (TRY(decoder.read_value<u32>()) != cache_file_magic || TRY(decoder.read_value<u32>()) != cache_format_version)
+        return Error::from_string_literal("Not a module cache file");
+
+    auto module = make_ref_counted<Module>();
+    module->custom_sections() = TRY(decode<Vector<CustomSection>>(decoder));
+    module->type_section() = TypeSection { TRY(decode<Vector<FunctionType>>(decoder)) };
+    module->import_section() = ImportSection { TRY(decode<Vector<ImportSection::Import>>(decoder)) };
+    module->function_section() = FunctionSection { TRY(decode<Vector<TypeIndex>>(decoder)) };
+    module->table_section() = TableSection { TRY(decode<Vector<TableSection::Table>>(decoder)) };
+    module->memory_section() = MemorySection { TRY(decode<Vector<MemorySection::Memory>>(decoder)) };
+    module->global_section() = GlobalSection { TRY(decode<Vector<GlobalSection::Global>>(decoder)) };
+    module->export_section() = ExportSection { TRY(decode<Vector<ExportSection::Export>>(decoder)) };
+    module->start_section() = StartSection { TRY(decode<Optional<StartSection::StartFunction>>(decoder)) };
+    module->element_section() = ElementSection { TRY(decode<Vector<ElementSection::Element>>(decoder)) };
+    module->code_section() = CodeSection { TRY(decode<Vector<CodeSection::Code>>(decoder)) };
+    module->data_section() = DataSection { TRY(decode<Vector<DataSection::Data>>(decoder)) };
+    module->data_count_section() = DataCountSection { TRY(decode<Optional<u32>>(decoder)) };
+
+    // NOTE: A file that was written with a different layout is unlikely to decode this far and end right here.
+    if (TRY(decoder.read_value<u32>()) != cache_file_magic || !decoder.is_eof())
+        return Error::from_string_literal("Corrupted module cache file");
+
+    return module;
+}
+
+RefPtr<Module> ModuleCache::load(ReadonlyBytes module_bytes)
+{
+    auto path = path_for(module_bytes);
+    if (!path.has_value())
+        return {};
+
+    auto file = Core::MappedFile::map(*path);
+    if (file.is_error()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    auto module = [&]() -> ErrorOr<NonnullRefPtr<Module>> {
+        auto bytes = file.value()->bytes();
+        if (bytes.size() < checksum_size)
+            return Error::from_string_literal("Truncated module cache file");
+
+        auto contents = bytes.trim(bytes.size() - checksum_size);
+        if (Crypto::Hash::SHA256::hash(contents).bytes() != bytes.slice_from_end(checksum_size))
+            return Error::from_string_literal("Module cache file checksum mismatch");
+
+        Decoder decoder { contents };
+        auto module = TRY(deserialize_module(decoder));
+
+        // NOTE: Only validated modules are ever stored, and the checksum rules out files that were damaged or cut
+        //       short since, so there's no need to validate this one again.
+        module->set_validated_by_cache({});
+        return module;
+    }();
+
+    if (module.is_error()) {
+        dbgln("ModuleCache: Failed to load {}: {}", *path, module.error());
+        ++m_statistics.misses;
+        ++m_statistics.errors;
+        return {};
+    }
+
+    ++m_statistics.hits;
+    return module.release_value();
+}
+
+static ErrorOr<void> write_file_atomically(ByteString const& path, ReadonlyBytes bytes)
+{
+    // NOTE: Write to a temporary file first, so that nobody ever maps a partially written file. Several threads of
+    //       this process may store the same module at once, so the name has to be unique within the process too.
+    static Atomic<u64> s_next_temporary_file_id { 0 };
+    auto temporary_path = ByteString::formatted("{}.{}.{}.tmp", path, getpid(), s_next_temporary_file_id++);
+    auto result = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(bytes));
+        file->close();
+        TRY(Core::System::rename(temporary_path, path));
+        return {};
+    }();
+
+    // Don't leave a partially written file behind, e.g. when the disk filled up.
+    if (result.is_error())
+        (void)Core::System::unlink(temporary_path);
+    return result;
+}
+
+void ModuleCache::store(ReadonlyBytes module_bytes, Module const& module)
+{
+    if (module.validation_status() != Module::ValidationStatus::Valid)
+        return;
+
+    auto path = path_for(module_bytes);
+    if (!path.has_value())
+        return;
+
+    auto result = [&]() -> ErrorOr<void> {
+        Encoder encoder;
+        TRY(serialize_module(encoder, module));
+        TRY(encoder.write_until_depleted(Crypto::Hash::SHA256::hash(encoder.bytes()).bytes()));
+
+        TRY(Core::Directory::create(LexicalPath { *path }.parent(), Core::Directory::CreateDirectories::Yes));
+        TRY(write_file_atomically(*path, encoder.bytes()));
+        return {};
+    }();
+
+    if (result.is_error()) {
+        dbgln("ModuleCache: Failed to store {}: {}", *path, result.error());
+        ++m_statistics.errors;
+        return;
+    }
+    ++m_statistics.stores;
+}
+
+void ModuleCache::dump_statistics() const
+{
+    warnln("Module cache: {} hits, {} misses, {} stores, {} errors",
+        m_statistics.hits.load(), m_statistics.misses.load(), m_statistics.stores.load(), m_statistics.errors.load());
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// A persistent cache of validated modules, stored as one file per module below a directory and keyed by the
+// SHA-256 of the module's binary. A module loaded from the cache is already marked as valid, so neither parsing
+// nor validation has to run again for it. Every file ends in a checksum of its contents, and files whose checksum
+// doesn't match are ignored.
+//
+// NOTE: This may be used from several threads at once (e.g. by LibWeb's background compilation).
+class ModuleCache {
+public:
+    struct Statistics {
+        Atomic<u64> hits { 0 };
+        Atomic<u64> misses { 0 };
+        Atomic<u64> stores { 0 };
+        Atomic<u64> errors { 0 };
+    };
+
+    static ModuleCache& the();
+
+    // Enables the cache. The directory is created on the first store.
+    void set_directory(ByteString directory);
+    bool is_enabled() const { return m_directory.has_value(); }
+
+    RefPtr<Module> load(ReadonlyBytes module_bytes);
+    // Only valid modules are stored, anything else is ignored.
+    void store(ReadonlyBytes module_bytes, Module const&);
+
+    Statistics const& statistics() const { return m_statistics; }
+    void dump_statistics() const;
+
+private:
+    Optional<ByteString> path_for(ReadonlyBytes module_bytes) const;
+
+    Optional<ByteString> m_directory;
+    Statistics m_statistics;
+};
+
+}
@@ -8,6 +8,8 @@
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibCore/System.h>
+#include <LibThreading/Thread.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
@@ -253,28 +255,96 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
     return {};
 }
 
+// Below this many functions, spinning up helper threads costs more than validating the bodies on the calling thread.
+static constexpr size_t minimum_function_count_for_parallel_validation = 64;
+static constexpr size_t minimum_functions_per_validation_thread = 16;
+static constexpr size_t maximum_validation_helper_thread_count = 7;
+
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
+    auto const& functions = section.functions();
+
+    // NOTE: Forking shares the context by reference count, so all forks are made (and later destroyed) on this thread.
+    //       Validating a body only ever reads the shared context, which makes it safe to validate them in parallel.
+    Vector<NonnullOwnPtr<Validator>> function_validators;
+    function_validators.ensure_capacity(functions.size());
     size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
+    for (auto& entry : functions) {
         auto function_index = index++;
         TRY(validate(FunctionIndex { function_index }));
         auto& function_type = m_context.functions[function_index];
         auto& function = entry.func();
 
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
+        auto function_validator = adopt_own(*new Validator { m_context });
+        function_validator->m_context.locals = {};
+        function_validator->m_context.locals.extend(function_type.parameters());
         for (auto& local : function.locals()) {
             for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+                function_validator->m_context.locals.append(local.type());
         }
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+        function_validator->m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+        function_validators.unchecked_append(move(function_validator));
+    }
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
+    auto validate_function = [&](size_t function_index) -> ErrorOr<void, ValidationError> {
+        auto& function_type = m_context.functions[m_context.imported_function_count + function_index];
+        auto results = TRY(function_validators[function_index]->validate(functions[function_index].func().body(), function_type.results()));
         if (results.result_types.size() != function_type.results().size())
             return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+        return {};
+    };
+
+    size_t helper_thread_count = 0;
+    if (functions.size() >= minimum_function_count_for_parallel_validation) {
+        helper_thread_count = min(functions.size() / minimum_functions_per_validation_thread, maximum_validation_helper_thread_count);
+        helper_thread_count = min(helper_thread_count, max(Core::System::hardware_concurrency(), 1u) - 1);
+    }
+
+    if (helper_thread_count == 0) {
+        for (size_t i = 0; i < functions.size(); ++i)
+            TRY(validate_function(i));
+        return {};
+    }
+
+    // Functions are handed out in order, and nobody picks up a new one after an error has been found. So every function
+    // before the first invalid one still gets validated, and we report the same error as validating them in order would.
+    Vector<Optional<ValidationError>> errors;
+    errors.resize(functions.size());
+    Atomic<size_t> next_function_index { 0 };
+    Atomic<bool> found_error { false };
+    auto validate_functions = [&] {
+        while (!found_error.load(AK::MemoryOrder::memory_order_relaxed)) {
+            auto function_index = next_function_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (function_index >= functions.size())
+                break;
+            if (auto result = validate_function(function_index); result.is_error()) {
+                errors[function_index] = result.release_error();
+                found_error.store(true, AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+    };
+
+    Vector<NonnullRefPtr<Threading::Thread>> helper_threads;
+    helper_threads.ensure_capacity(helper_thread_count);
+    for (size_t i = 0; i < helper_thread_count; ++i) {
+        auto thread = Threading::Thread::construct([&] {
+            validate_functions();
+            return 0;
+        },
+            "Wasm Validator"sv);
+        thread->start();
+        helper_threads.unchecked_append(move(thread));
+    }
+
+    validate_functions();
+
+    for (auto& thread : helper_threads)
+        (void)thread->join();
+
+    for (auto& error : errors) {
+        if (error.has_value())
+            return error.release_value();
     }
 
     return {};
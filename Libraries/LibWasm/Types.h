@@ -1025,6 +1025,7 @@ public:
     auto& data_count_section() const { return m_data_count_section; }
 
     void set_validation_status(ValidationStatus status, Badge<Validator>) { set_validation_status(status); }
+    void set_validated_by_cache(Badge<ModuleCache>) { set_validation_status(ValidationStatus::Valid); }
     ValidationStatus validation_status() const { return m_validation_status; }
     StringView validation_error() const { return *m_validation_error; }
     void set_validation_error(ByteString error) { m_validation_error = move(error); }
@@ -26,9 +26,18 @@ public:
     [[nodiscard]] RefPtr<CSSStyleValue const> property(PropertyID) const;
     [[nodiscard]] GC::Ptr<CSSStyleDeclaration const> property_source(PropertyID) const;
     [[nodiscard]] bool is_property_important(PropertyID) const;
+    [[nodiscard]] bool is_empty() const { return m_properties.is_empty(); }
+
+    template<typename Callback>
+    void for_each_property_id(Callback callback) const
+    {
+        for (auto const& it : m_properties)
+            callback(it.key);
+    }
 
     void set_property(PropertyID, NonnullRefPtr<CSSStyleValue const>, Important, CascadeOrigin, Optional<FlyString> layer_name, GC::Ptr<CSS::CSSStyleDeclaration const> source);
     void set_property_from_presentational_hint(PropertyID, NonnullRefPtr<CSSStyleValue const>);
+    void set_properties_from(CascadedProperties const& other) { m_properties = other.m_properties; }
 
     void revert_property(PropertyID, Important, CascadeOrigin);
     void revert_layer_property(PropertyID, Important, Optional<FlyString> layer_name);
@@ -85,16 +85,84 @@ void ComputedProperties::set_property_inherited(PropertyID property_id, Inherite
         m_property_inherited[n / 8] &= ~(1 << (n % 8));
 }
 
+ComputedProperties::PropertyGroup& ComputedProperties::initial_property_group(size_t group)
+{
+    static Array<RefPtr<PropertyGroup>, property_group_count> initial_groups;
+    auto& initial_group = initial_groups[group];
+    if (!initial_group) {
+        initial_group = adopt_ref(*new PropertyGroup);
+        for (auto i = first_property_index_in_group(group); i < end_property_index_in_group(group); ++i)
+            initial_group->values[i - first_property_index_in_group(group)] = property_initial_value(static_cast<PropertyID>(i));
+    }
+    return *initial_group;
+}
+
+void ComputedProperties::set_property_value(PropertyID id, RefPtr<CSSStyleValue const> value)
+{
+    auto group_index = property_group_for(id);
+    auto index_in_group = to_underlying(id) - first_property_index_in_group(group_index);
+    auto& group = m_property_groups[group_index];
+
+    if (group) {
+        // Writing a value that's already there (or one that's equal to it) mustn't cause a copy of a shared group.
+        auto const& old_value = group->values[index_in_group];
+        if (old_value == value || (old_value && value && *old_value == *value))
+            return;
+        if (group->ref_count() > 1) {
+            auto copy = adopt_ref(*new PropertyGroup);
+            copy->values = group->values;
+            group = move(copy);
+        }
+    } else {
+        if (!value)
+            return;
+        group = adopt_ref(*new PropertyGroup);
+    }
+    group->values[index_in_group] = move(value);
+}
+
+void ComputedProperties::inherit_property_group(size_t group, ComputedProperties const& parent)
+{
+    m_property_groups[group] = parent.m_property_groups[group];
+    for (auto i = first_property_index_in_group(group); i < end_property_index_in_group(group); ++i) {
+        auto property_id = static_cast<PropertyID>(i);
+        set_property_important(property_id, Important::No);
+        set_property_inherited(property_id, Inherited::Yes);
+    }
+}
+
+void ComputedProperties::use_initial_property_group(size_t group)
+{
+    m_property_groups[group] = initial_property_group(group);
+    for (auto i = first_property_index_in_group(group); i < end_property_index_in_group(group); ++i) {
+        auto property_id = static_cast<PropertyID>(i);
+        set_property_important(property_id, Important::No);
+        set_property_inherited(property_id, Inherited::No);
+    }
+}
+
+void ComputedProperties::share_property_groups_with(ComputedProperties const& other)
+{
+    for (size_t i = 0; i < property_group_count; ++i) {
+        auto& group = m_property_groups[i];
+        auto const& other_group = other.m_property_groups[i];
+        if (!group || !other_group || group == other_group)
+            continue;
+        if (group->values == other_group->values)
+            group = other_group;
+    }
+}
+
 void ComputedProperties::set_property(PropertyID id, NonnullRefPtr<CSSStyleValue const> value, Inherited inherited, Important important)
 {
-    m_property_values[to_underlying(id)] = move(value);
+    set_property_value(id, move(value));
     set_property_important(id, important);
     set_property_inherited(id, inherited);
 }
 
 void ComputedProperties::revert_property(PropertyID id, ComputedProperties const& style_for_revert)
 {
-    m_property_values[to_underlying(id)] = style_for_revert.m_property_values[to_underlying(id)];
+    set_property_value(id, style_for_revert.property_value(id));
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 }
@@ -117,14 +185,14 @@ CSSStyleValue const& ComputedProperties::property(PropertyID property_id, WithAn
     }
 
     // By the time we call this method, all properties have values assigned.
-    return *m_property_values[to_underlying(property_id)];
+    return *property_value(property_id);
 }
 
 CSSStyleValue const* ComputedProperties::maybe_null_property(PropertyID property_id) const
 {
     if (auto animated_value = m_animated_property_values.get(property_id); animated_value.has_value())
         return animated_value.value();
-    return m_property_values[to_underlying(property_id)];
+    return property_value(property_id);
 }
 
 Variant<LengthPercentage, NormalGap> ComputedProperties::gap_value(PropertyID id) const
@@ -730,25 +798,27 @@ Positioning ComputedProperties::position() const
 
 bool ComputedProperties::operator==(ComputedProperties const& other) const
 {
-    if (m_property_values.size() != other.m_property_values.size())
-        return false;
+    for (size_t group = 0; group < property_group_count; ++group) {
+        if (m_property_groups[group] == other.m_property_groups[group])
+            continue;
 
-    for (size_t i = 0; i < m_property_values.size(); ++i) {
-        auto const& my_style = m_property_values[i];
-        auto const& other_style = other.m_property_values[i];
-        if (!my_style) {
-            if (other_style)
+        for (auto i = first_property_index_in_group(group); i < end_property_index_in_group(group); ++i) {
+            auto const* my_style = property_value(static_cast<PropertyID>(i));
+            auto const* other_style = other.property_value(static_cast<PropertyID>(i));
+            if (!my_style) {
+                if (other_style)
+                    return false;
+                continue;
+            }
+            if (!other_style)
+                return false;
+            auto const& my_value = *my_style;
+            auto const& other_value = *other_style;
+            if (my_value.type() != other_value.type())
+                return false;
+            if (my_value != other_value)
                 return false;
-            continue;
         }
-        if (!other_style)
-            return false;
-        auto const& my_value = *my_style;
-        auto const& other_value = *other_style;
-        if (my_value.type() != other_value.type())
-            return false;
-        if (my_value != other_value)
-            return false;
     }
 
     return true;
@@ -9,6 +9,7 @@
 
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Ptr.h>
 #include <LibGfx/Font/Font.h>
@@ -34,12 +35,46 @@ public:
 
     virtual ~ComputedProperties() override;
 
+    // Property values are stored in groups of up to property_group_size properties with neighboring IDs. Inherited and
+    // non-inherited longhands (and the shorthands) never share a group, since whole groups of inherited properties
+    // usually have the parent's values, and whole groups of non-inherited ones usually have their initial values.
+    // A group can be shared between any number of styles, and is copied on the first write.
+    static constexpr size_t property_group_size = 16;
+
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_property_values.size(); ++i) {
-            if (m_property_values[i])
-                callback((PropertyID)i, *m_property_values[i]);
+        for (size_t i = 0; i < number_of_properties; ++i) {
+            if (auto const* value = property_value(static_cast<PropertyID>(i)))
+                callback((PropertyID)i, *value);
+        }
+    }
+
+    // Calls the callback for every property that may have a different value in the other style. Groups of properties
+    // that are shared between the two styles are skipped.
+    template<typename Callback>
+    void for_each_property_that_may_differ(ComputedProperties const& other, Callback callback) const
+    {
+        bool has_animated_values = !m_animated_property_values.is_empty() || !other.m_animated_property_values.is_empty();
+        for (size_t group = 0; group < property_group_count; ++group) {
+            if (!has_animated_values && m_property_groups[group] == other.m_property_groups[group])
+                continue;
+            for (auto i = first_property_index_in_group(group); i < end_property_index_in_group(group); ++i)
+                callback(static_cast<PropertyID>(i));
+        }
+    }
+
+    // Makes this style share each group of property values that is identical in the other style.
+    void share_property_groups_with(ComputedProperties const&);
+
+    // Calls the callback with an identity for each group of property values this style holds, so that callers can
+    // measure how many groups are shared between styles.
+    template<typename Callback>
+    void for_each_property_group(Callback callback) const
+    {
+        for (auto const& group : m_property_groups) {
+            if (group)
+                callback(static_cast<void const*>(group.ptr()));
         }
     }
 
@@ -258,7 +293,71 @@ private:
     GC::Ptr<CSSStyleDeclaration const> m_animation_name_source;
     GC::Ptr<CSSStyleDeclaration const> m_transition_property_source;
 
-    Array<RefPtr<CSSStyleValue const>, number_of_properties> m_property_values;
+    static constexpr size_t first_longhand_index = to_underlying(first_longhand_property_id);
+    static constexpr size_t first_noninherited_longhand_index = to_underlying(last_inherited_longhand_property_id) + 1;
+    static constexpr size_t first_inherited_longhand_group = ceil_div(first_longhand_index, property_group_size);
+    static constexpr size_t first_noninherited_longhand_group = first_inherited_longhand_group + ceil_div(first_noninherited_longhand_index - first_longhand_index, property_group_size);
+    static constexpr size_t property_group_count = first_noninherited_longhand_group + ceil_div(number_of_properties - first_noninherited_longhand_index, property_group_size);
+
+    static constexpr size_t first_property_index_in_section(size_t group)
+    {
+        if (group >= first_noninherited_longhand_group)
+            return first_noninherited_longhand_index;
+        if (group >= first_inherited_longhand_group)
+            return first_longhand_index;
+        return 0;
+    }
+    static constexpr size_t first_group_in_section(size_t group)
+    {
+        if (group >= first_noninherited_longhand_group)
+            return first_noninherited_longhand_group;
+        if (group >= first_inherited_longhand_group)
+            return first_inherited_longhand_group;
+        return 0;
+    }
+    static constexpr size_t first_property_index_in_group(size_t group)
+    {
+        return first_property_index_in_section(group) + (group - first_group_in_section(group)) * property_group_size;
+    }
+    static constexpr size_t end_property_index_in_group(size_t group)
+    {
+        auto end_of_section = number_of_properties;
+        if (group < first_inherited_longhand_group)
+            end_of_section = first_longhand_index;
+        else if (group < first_noninherited_longhand_group)
+            end_of_section = first_noninherited_longhand_index;
+        return min(first_property_index_in_group(group) + property_group_size, end_of_section);
+    }
+    static constexpr size_t property_group_for(PropertyID property_id)
+    {
+        auto index = to_underlying(property_id);
+        if (index >= first_noninherited_longhand_index)
+            return first_noninherited_longhand_group + (index - first_noninherited_longhand_index) / property_group_size;
+        if (index >= first_longhand_index)
+            return first_inherited_longhand_group + (index - first_longhand_index) / property_group_size;
+        return index / property_group_size;
+    }
+
+    struct PropertyGroup : public RefCounted<PropertyGroup> {
+        Array<RefPtr<CSSStyleValue const>, property_group_size> values;
+    };
+    static PropertyGroup& initial_property_group(size_t group);
+
+    CSSStyleValue const* property_value(PropertyID property_id) const
+    {
+        auto group = property_group_for(property_id);
+        if (!m_property_groups[group])
+            return nullptr;
+        return m_property_groups[group]->values[to_underlying(property_id) - first_property_index_in_group(group)];
+    }
+    // Replaces the value without touching the important and inherited flags.
+    void set_property_value(PropertyID, RefPtr<CSSStyleValue const>);
+
+    // Gives a whole group the values (and inherited flags) of the other style's group, or the initial values.
+    void inherit_property_group(size_t group, ComputedProperties const& parent);
+    void use_initial_property_group(size_t group);
+
+    Array<RefPtr<PropertyGroup>, property_group_count> m_property_groups;
     Array<u8, ceil_div(number_of_properties, 8uz)> m_property_important {};
     Array<u8, ceil_div(number_of_properties, 8uz)> m_property_inherited {};
 
@@ -30,6 +30,11 @@ public:
         return (m_bits & (1LLU << index)) != 0;
     }
 
+    bool is_subset_of(PseudoClassBitmap const& other) const
+    {
+        return (m_bits & ~other.m_bits) == 0;
+    }
+
     void operator|=(PseudoClassBitmap const& other)
     {
         m_bits |= other.m_bits;
@@ -1686,6 +1686,35 @@ GC::Ref<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Element&
         element.set_custom_properties(pseudo_element, move(custom_properties));
     }
 
+    auto apply_presentational_hints = [&](GC::Ref<CascadedProperties> properties) {
+        element.apply_presentational_hints(properties);
+        if (element.supports_dimension_attributes()) {
+            apply_dimension_attribute(properties, element, HTML::AttributeNames::width, CSS::PropertyID::Width);
+            apply_dimension_attribute(properties, element, HTML::AttributeNames::height, CSS::PropertyID::Height);
+        }
+    };
+
+    // Unless the element has inline style or presentational hints, the rest of the cascade only depends on the matched
+    // rules, so elements that matched the same rules can reuse the same cascaded properties.
+    // NOTE: Hints are applied to the still empty cascaded properties to find out whether there are any.
+    Optional<Vector<MatchingRule const*>> matched_properties_cache_key;
+    bool has_presentational_hints = true;
+    if (m_style_sharing_enabled && !pseudo_element.has_value() && !element.inline_style()) {
+        apply_presentational_hints(cascaded_properties);
+        if (cascaded_properties->is_empty()) {
+            has_presentational_hints = false;
+            matched_properties_cache_key = flatten_matching_rule_set(matching_rule_set);
+            // NOTE: Every element gets its own copy, since style sharing between cousins takes the same cascaded
+            //       properties object to mean that the parents shared their style.
+            if (auto cached_properties = find_matched_properties(*matched_properties_cache_key)) {
+                cascaded_properties->set_properties_from(*cached_properties);
+                return cascaded_properties;
+            }
+        } else {
+            cascaded_properties = m_document->heap().allocate<CascadedProperties>();
+        }
+    }
+
     // Then we apply the declarations from the matched rules in cascade order:
 
     // Normal user agent declarations
@@ -1700,12 +1729,8 @@ GC::Ref<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Element&
     // however for the purpose of the revert keyword (but not for the revert-layer keyword) it is considered
     // part of the author origin."
     // https://drafts.csswg.org/css-cascade-5/#author-presentational-hint-origin
-    if (!pseudo_element.has_value()) {
-        element.apply_presentational_hints(cascaded_properties);
-        if (element.supports_dimension_attributes()) {
-            apply_dimension_attribute(cascaded_properties, element, HTML::AttributeNames::width, CSS::PropertyID::Width);
-            apply_dimension_attribute(cascaded_properties, element, HTML::AttributeNames::height, CSS::PropertyID::Height);
-        }
+    if (!pseudo_element.has_value() && has_presentational_hints) {
+        apply_presentational_hints(cascaded_properties);
 
         // SVG presentation attributes are parsed as CSS values, so we need to handle potential custom properties here.
         if (element.is_svg_element()) {
@@ -1733,6 +1758,9 @@ GC::Ref<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Element&
     // Note that we have to do these after finishing computing the style,
     // so they're not done here, but as the final step in compute_style_impl()
 
+    if (matched_properties_cache_key.has_value())
+        add_matched_properties(matched_properties_cache_key.release_value(), cascaded_properties);
+
     return cascaded_properties;
 }
 
@@ -1759,8 +1787,8 @@ NonnullRefPtr<CSSStyleValue const> StyleComputer::get_inherit_value(CSS::Propert
 
 void StyleComputer::compute_defaulted_property_value(ComputedProperties& style, DOM::Element const* element, CSS::PropertyID property_id, Optional<CSS::PseudoElement> pseudo_element) const
 {
-    auto& value_slot = style.m_property_values[to_underlying(property_id)];
-    if (!value_slot) {
+    auto const* value = style.property_value(property_id);
+    if (!value) {
         if (is_inherited_property(property_id)) {
             style.set_property(
                 property_id,
@@ -1773,27 +1801,27 @@ void StyleComputer::compute_defaulted_property_value(ComputedProperties& style,
         return;
     }
 
-    if (value_slot->is_initial()) {
-        value_slot = property_initial_value(property_id);
+    if (value->is_initial()) {
+        style.set_property_value(property_id, property_initial_value(property_id));
         return;
     }
 
-    if (value_slot->is_inherit()) {
-        value_slot = get_inherit_value(property_id, element, pseudo_element);
+    if (value->is_inherit()) {
+        style.set_property_value(property_id, get_inherit_value(property_id, element, pseudo_element));
         style.set_property_inherited(property_id, ComputedProperties::Inherited::Yes);
         return;
     }
 
     // https://www.w3.org/TR/css-cascade-4/#inherit-initial
     // If the cascaded value of a property is the unset keyword,
-    if (value_slot->is_unset()) {
+    if (value->is_unset()) {
         if (is_inherited_property(property_id)) {
             // then if it is an inherited property, this is treated as inherit,
-            value_slot = get_inherit_value(property_id, element, pseudo_element);
+            style.set_property_value(property_id, get_inherit_value(property_id, element, pseudo_element));
             style.set_property_inherited(property_id, ComputedProperties::Inherited::Yes);
         } else {
             // and if it is not, this is treated as initial.
-            value_slot = property_initial_value(property_id);
+            style.set_property_value(property_id, property_initial_value(property_id));
         }
     }
 }
@@ -2249,24 +2277,26 @@ void StyleComputer::absolutize_values(ComputedProperties& style, GC::Ptr<DOM::El
     //       We have to resolve them right away, so that the *computed* line-height is ready for inheritance.
     //       We can't simply absolutize *all* percentage values against the font size,
     //       because most percentages are relative to containing block metrics.
-    auto& line_height_value_slot = style.m_property_values[to_underlying(CSS::PropertyID::LineHeight)];
-    if (line_height_value_slot && line_height_value_slot->is_percentage()) {
-        line_height_value_slot = LengthStyleValue::create(
-            Length::make_px(CSSPixels::nearest_value_for(font_size * static_cast<double>(line_height_value_slot->as_percentage().percentage().as_fraction()))));
+    if (auto const* line_height_value = style.property_value(CSS::PropertyID::LineHeight); line_height_value && line_height_value->is_percentage()) {
+        style.set_property_value(CSS::PropertyID::LineHeight, LengthStyleValue::create(Length::make_px(CSSPixels::nearest_value_for(font_size * static_cast<double>(line_height_value->as_percentage().percentage().as_fraction()))));
     }
 
     auto line_height = style.compute_line_height(viewport_rect(), font_metrics, m_root_element_font_metrics);
     font_metrics.line_height = line_height;
 
     // NOTE: line-height might be using lh which should be resolved against the parent line height (like we did here already)
-    if (line_height_value_slot && line_height_value_slot->is_length())
-        line_height_value_slot = LengthStyleValue::create(Length::make_px(line_height));
+    if (auto const* line_height_value = style.property_value(CSS::PropertyID::LineHeight); line_height_value && line_height_value->is_length())
+        style.set_property_value(CSS::PropertyID::LineHeight, LengthStyleValue::create(Length::make_px(line_height)));
 
-    for (size_t i = 0; i < style.m_property_values.size(); ++i) {
-        auto& value_slot = style.m_property_values[i];
-        if (!value_slot)
+    for (size_t i = 0; i < ComputedProperties::number_of_properties; ++i) {
+        auto property_id = static_cast<PropertyID>(i);
+        auto const* value = style.property_value(property_id);
+        if (!value)
             continue;
-        value_slot = value_slot->absolutized(viewport_rect(), font_metrics, m_root_element_font_metrics);
+        // NOTE: Most values are already absolute. Only writing back the ones that changed keeps shared groups shared.
+        auto absolutized_value = value->absolutized(viewport_rect(), font_metrics, m_root_element_font_metrics);
+        if (absolutized_value.ptr() != value)
+            style.set_property_value(property_id, move(absolutized_value));
     }
 
     style.set_line_height({}, line_height);
@@ -2483,6 +2513,16 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_pseudo_element_style_if_neede
     return compute_style_impl(element, move(pseudo_element), ComputeStyleMode::CreatePseudoElementStyleIfNeeded);
 }
 
+static bool is_eligible_for_style_sharing(DOM::Element const& element)
+{
+    // NOTE: Shadow hosts match :host rules from their own shadow tree, and SVG presentation attributes may depend on
+    //       custom properties, so neither can be compared by looking at the element and its ancestors alone.
+    return element.parent_element()
+        && !element.inline_style()
+        && !element.is_shadow_host()
+        && !element.is_svg_element();
+}
+
 GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& element, Optional<CSS::PseudoElement> pseudo_element, ComputeStyleMode mode) const
 {
     build_rule_cache_if_needed();
@@ -2505,7 +2545,29 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
     PseudoClassBitmap attempted_pseudo_class_matches;
-    auto cascaded_properties = compute_cascaded_values(element, pseudo_element, did_match_any_pseudo_element_rules, attempted_pseudo_class_matches, mode);
+    auto cascaded_properties = [&] -> GC::Ref<CascadedProperties> {
+        if (!m_style_sharing_enabled || pseudo_element.has_value() || m_selector_insights->has_has_selectors)
+            return compute_cascaded_values(element, pseudo_element, did_match_any_pseudo_element_rules, attempted_pseudo_class_matches, mode);
+
+        if (!is_eligible_for_style_sharing(element)) {
+            ++m_style_sharing_statistics.ineligible_elements;
+            return compute_cascaded_values(element, pseudo_element, did_match_any_pseudo_element_rules, attempted_pseudo_class_matches, mode);
+        }
+
+        if (auto candidate = find_style_sharing_candidate(element); candidate.has_value()) {
+            attempted_pseudo_class_matches = candidate->attempted_pseudo_class_matches;
+            m_elements_sharing_style.set(element);
+            m_elements_sharing_style.set(candidate->element);
+            element.set_custom_properties({}, candidate->element->custom_properties({}));
+            if (candidate->element->style_uses_css_custom_properties())
+                element.set_style_uses_css_custom_properties(true);
+            return *candidate->element->cascaded_properties({});
+        }
+
+        auto matched_properties = compute_cascaded_values(element, pseudo_element, did_match_any_pseudo_element_rules, attempted_pseudo_class_matches, mode);
+        add_style_sharing_candidate(element, attempted_pseudo_class_matches);
+        return matched_properties;
+    }();
 
     element.set_cascaded_properties(pseudo_element, cascaded_properties);
 
@@ -2631,11 +2693,41 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& elem
     auto computed_style = document().heap().allocate<CSS::ComputedProperties>();
 
     auto new_font_size = recascade_font_size_if_needed(element, pseudo_element, cascaded_properties);
+
+    // A group of properties without any cascaded values ends up with either the parent's values (for inherited
+    // properties) or the initial values, so we can share the whole group instead of filling it in one by one.
+    Array<bool, ComputedProperties::property_group_count> group_is_shared {};
+    {
+        Array<bool, ComputedProperties::property_group_count> group_has_cascaded_values {};
+        cascaded_properties.for_each_property_id([&](PropertyID property_id) {
+            group_has_cascaded_values[ComputedProperties::property_group_for(property_id)] = true;
+        });
+        if (new_font_size)
+            group_has_cascaded_values[ComputedProperties::property_group_for(PropertyID::FontSize)] = true;
+
+        auto const* inheritance_parent = element_to_inherit_style_from(&element, pseudo_element);
+        auto parent_style = inheritance_parent ? inheritance_parent->computed_properties() : nullptr;
+        for (auto group = ComputedProperties::first_inherited_longhand_group; group < ComputedProperties::property_group_count; ++group) {
+            if (group_has_cascaded_values[group])
+                continue;
+            if (group >= ComputedProperties::first_noninherited_longhand_group || !inheritance_parent) {
+                computed_style->use_initial_property_group(group);
+                group_is_shared[group] = true;
+            } else if (parent_style && parent_style->animated_property_values().is_empty() && parent_style->m_property_groups[group]) {
+                // NOTE: Animated values aren't part of the groups, so they have to be inherited one by one.
+                computed_style->inherit_property_group(group, *parent_style);
+                group_is_shared[group] = true;
+            }
+        }
+    }
+
     if (new_font_size)
         computed_style->set_property(PropertyID::FontSize, *new_font_size, ComputedProperties::Inherited::No, Important::No);
 
     for (auto i = to_underlying(first_longhand_property_id); i <= to_underlying(last_longhand_property_id); ++i) {
         auto property_id = static_cast<CSS::PropertyID>(i);
+        if (group_is_shared[ComputedProperties::property_group_for(property_id)])
+            continue;
         auto value = cascaded_properties.property(property_id);
         auto inherited = ComputedProperties::Inherited::No;
 
@@ -2774,6 +2866,15 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& elem
         start_needed_transitions(*previous_style, computed_style, element, pseudo_element);
     }
 
+    // 10. Share groups of values with the styles most likely to have the same ones, so that the memory is only used
+    //     once, and so that comparing the styles when invalidating can skip those groups.
+    if (!pseudo_element.has_value()) {
+        if (auto previous_style = element.computed_properties())
+            computed_style->share_property_groups_with(*previous_style);
+        if (auto const* sibling = element.previous_element_sibling(); sibling && sibling->computed_properties())
+            computed_style->share_property_groups_with(*sibling->computed_properties());
+    }
+
     return computed_style;
 }
 
@@ -2820,6 +2921,27 @@ static Optional<SimplifiedSelectorForBucketing> is_roundabout_selector_bucketabl
     return {};
 }
 
+static bool has_sibling_combinators_outside_of_subject(Selector const& selector, bool selector_is_relative_to_subject = true)
+{
+    auto const& compound_selectors = selector.compound_selectors();
+    for (size_t i = 0; i < compound_selectors.size(); ++i) {
+        auto const& compound_selector = compound_selectors[i];
+        // NOTE: A combinator belongs to the compound selector on its right, so only the last one is matched against the subject itself.
+        bool is_subject = selector_is_relative_to_subject && i == compound_selectors.size() - 1;
+        if (!is_subject && first_is_one_of(compound_selector.combinator, Selector::Combinator::NextSibling, Selector::Combinator::SubsequentSibling))
+            return true;
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+                continue;
+            for (auto const& argument_selector : simple_selector.pseudo_class().argument_selector_list) {
+                if (has_sibling_combinators_outside_of_subject(*argument_selector, is_subject))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
 void StyleComputer::collect_selector_insights(Selector const& selector, SelectorInsights& insights)
 {
     for (auto const& compound_selector : selector.compound_selectors()) {
@@ -2834,134 +2956,144 @@ void StyleComputer::collect_selector_insights(Selector const& selector, Selector
             }
         }
     }
+    if (!insights.has_sibling_combinators_outside_of_subject)
+        insights.has_sibling_combinators_outside_of_subject = has_sibling_combinators_outside_of_subject(selector);
+}
+
+StyleComputer::RuleCaches& StyleComputer::rule_caches_for(CascadeOrigin cascade_origin, GC::Ptr<DOM::ShadowRoot const> shadow_root)
+{
+    RuleCachesForDocumentAndShadowRoots* rule_caches_for_document_or_shadow_root = nullptr;
+    switch (cascade_origin) {
+    case CascadeOrigin::Author:
+        rule_caches_for_document_or_shadow_root = m_author_rule_cache;
+        break;
+    case CascadeOrigin::User:
+        rule_caches_for_document_or_shadow_root = m_user_rule_cache;
+        break;
+    case CascadeOrigin::UserAgent:
+        rule_caches_for_document_or_shadow_root = m_user_agent_rule_cache;
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+    if (!shadow_root)
+        return rule_caches_for_document_or_shadow_root->for_document;
+    return *rule_caches_for_document_or_shadow_root->for_shadow_roots.ensure(*shadow_root, [] { return make<RuleCaches>(); });
 }
 
 void StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin, SelectorInsights& insights)
 {
-    Vector<MatchingRule> matching_rules;
     size_t style_sheet_index = 0;
     for_each_stylesheet(cascade_origin, [&](auto& sheet, GC::Ptr<DOM::ShadowRoot> shadow_root) {
-        auto& rule_caches = [&] -> RuleCaches& {
-            RuleCachesForDocumentAndShadowRoots* rule_caches_for_document_or_shadow_root = nullptr;
-            switch (cascade_origin) {
-            case CascadeOrigin::Author:
-                rule_caches_for_document_or_shadow_root = m_author_rule_cache;
-                break;
-            case CascadeOrigin::User:
-                rule_caches_for_document_or_shadow_root = m_user_rule_cache;
-                break;
-            case CascadeOrigin::UserAgent:
-                rule_caches_for_document_or_shadow_root = m_user_agent_rule_cache;
-                break;
-            default:
-                VERIFY_NOT_REACHED();
-            }
-            if (!shadow_root)
-                return rule_caches_for_document_or_shadow_root->for_document;
-            return *rule_caches_for_document_or_shadow_root->for_shadow_roots.ensure(*shadow_root, [] { return make<RuleCaches>(); });
+        add_style_sheet_to_rule_cache(cascade_origin, sheet, shadow_root, style_sheet_index, insights);
+        ++style_sheet_index;
+    });
+    if (cascade_origin == CascadeOrigin::Author)
+        m_next_author_style_sheet_index = style_sheet_index;
+}
+
+void StyleComputer::add_style_sheet_to_rule_cache(CascadeOrigin cascade_origin, CSSStyleSheet const& sheet, GC::Ptr<DOM::ShadowRoot const> shadow_root, size_t style_sheet_index, SelectorInsights& insights)
+{
+    auto& rule_caches = rule_caches_for(cascade_origin, shadow_root);
+    size_t rule_index = 0;
+    sheet.for_each_effective_style_producing_rule([&](auto const& rule) {
+        SelectorList const& absolutized_selectors = [&]() {
+            if (rule.type() == CSSRule::Type::Style)
+                return static_cast<CSSStyleRule const&>(rule).absolutized_selectors();
+            if (rule.type() == CSSRule::Type::NestedDeclarations)
+                return static_cast<CSSNestedDeclarations const&>(rule).parent_style_rule().absolutized_selectors();
+            VERIFY_NOT_REACHED();
         }();
 
-        size_t rule_index = 0;
-        sheet.for_each_effective_style_producing_rule([&](auto const& rule) {
-            SelectorList const& absolutized_selectors = [&]() {
-                if (rule.type() == CSSRule::Type::Style)
-                    return static_cast<CSSStyleRule const&>(rule).absolutized_selectors();
-                if (rule.type() == CSSRule::Type::NestedDeclarations)
-                    return static_cast<CSSNestedDeclarations const&>(rule).parent_style_rule().absolutized_selectors();
-                VERIFY_NOT_REACHED();
-            }();
-
-            for (auto const& selector : absolutized_selectors) {
-                m_style_invalidation_data->build_invalidation_sets_for_selector(selector);
-            }
+        for (auto const& selector : absolutized_selectors) {
+            m_style_invalidation_data->build_invalidation_sets_for_selector(selector);
+        }
+
+        for (CSS::Selector const& selector : absolutized_selectors) {
+            MatchingRule matching_rule {
+                shadow_root,
+                &rule,
+                sheet,
+                sheet.default_namespace(),
+                selector,
+                style_sheet_index,
+                rule_index,
+                selector.specificity(),
+                cascade_origin,
+                false,
+            };
 
-            for (CSS::Selector const& selector : absolutized_selectors) {
-                MatchingRule matching_rule {
-                    shadow_root,
-                    &rule,
-                    sheet,
-                    sheet.default_namespace(),
-                    selector,
-                    style_sheet_index,
-                    rule_index,
-                    selector.specificity(),
-                    cascade_origin,
-                    false,
-                };
-
-                auto const& qualified_layer_name = matching_rule.qualified_layer_name();
-                auto& rule_cache = qualified_layer_name.is_empty() ? rule_caches.main : *rule_caches.by_layer.ensure(qualified_layer_name, [] { return make<RuleCache>(); });
-
-                bool contains_root_pseudo_class = false;
-                Optional<CSS::PseudoElement> pseudo_element;
-
-                collect_selector_insights(selector, insights);
-
-                for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
-                    if (!matching_rule.contains_pseudo_element) {
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
-                            matching_rule.contains_pseudo_element = true;
-                            pseudo_element = simple_selector.pseudo_element().type();
-                        }
-                    }
-                    if (!contains_root_pseudo_class) {
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
-                            && simple_selector.pseudo_class().type == CSS::PseudoClass::Root) {
-                            contains_root_pseudo_class = true;
-                        }
+            auto const& qualified_layer_name = matching_rule.qualified_layer_name();
+            auto& rule_cache = qualified_layer_name.is_empty() ? rule_caches.main : *rule_caches.by_layer.ensure(qualified_layer_name, [] { return make<RuleCache>(); });
+
+            bool contains_root_pseudo_class = false;
+            Optional<CSS::PseudoElement> pseudo_element;
+
+            collect_selector_insights(selector, insights);
+
+            for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+                if (!matching_rule.contains_pseudo_element) {
+                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
+                        matching_rule.contains_pseudo_element = true;
+                        pseudo_element = simple_selector.pseudo_element().type();
                     }
                 }
-
-                for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
-                    auto pseudo_class = static_cast<PseudoClass>(i);
-                    // If we're not building a rule cache for this pseudo class, just ignore it.
-                    if (!m_pseudo_class_rule_cache[i])
-                        continue;
-                    if (selector.contains_pseudo_class(pseudo_class)) {
-                        // For pseudo class rule caches we intentionally pass no pseudo-element, because we don't want to bucket pseudo class rules by pseudo-element type.
-                        m_pseudo_class_rule_cache[i]->add_rule(matching_rule, {}, contains_root_pseudo_class);
+                if (!contains_root_pseudo_class) {
+                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
+                        && simple_selector.pseudo_class().type == CSS::PseudoClass::Root) {
+                        contains_root_pseudo_class = true;
                     }
                 }
-
-                rule_cache.add_rule(matching_rule, pseudo_element, contains_root_pseudo_class);
             }
-            ++rule_index;
-        });
 
-        // Loosely based on https://drafts.csswg.org/css-animations-2/#keyframe-processing
-        sheet.for_each_effective_keyframes_at_rule([&](CSSKeyframesRule const& rule) {
-            auto keyframe_set = adopt_ref(*new Animations::KeyframeEffect::KeyFrameSet);
-            HashTable<PropertyID> animated_properties;
-
-            // Forwards pass, resolve all the user-specified keyframe properties.
-            for (auto const& keyframe_rule : *rule.css_rules()) {
-                auto const& keyframe = as<CSSKeyframeRule>(*keyframe_rule);
-                Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame resolved_keyframe;
-
-                auto key = static_cast<u64>(keyframe.key().value() * Animations::KeyframeEffect::AnimationKeyFrameKeyScaleFactor);
-                auto const& keyframe_style = *keyframe.style();
-                for (auto const& it : keyframe_style.properties()) {
-                    // Unresolved properties will be resolved in collect_animation_into()
-                    for_each_property_expanding_shorthands(it.property_id, it.value, [&](PropertyID shorthand_id, CSSStyleValue const& shorthand_value) {
-                        animated_properties.set(shorthand_id);
-                        resolved_keyframe.properties.set(shorthand_id, NonnullRefPtr<CSSStyleValue const> { shorthand_value });
-                    });
+            for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
+                auto pseudo_class = static_cast<PseudoClass>(i);
+                // If we're not building a rule cache for this pseudo class, just ignore it.
+                if (!m_pseudo_class_rule_cache[i])
+                    continue;
+                if (selector.contains_pseudo_class(pseudo_class)) {
+                    // For pseudo class rule caches we intentionally pass no pseudo-element, because we don't want to bucket pseudo class rules by pseudo-element type.
+                    m_pseudo_class_rule_cache[i]->add_rule(matching_rule, {}, contains_root_pseudo_class);
                 }
-
-                keyframe_set->keyframes_by_key.insert(key, resolved_keyframe);
             }
 
-            Animations::KeyframeEffect::generate_initial_and_final_frames(keyframe_set, animated_properties);
+            rule_cache.add_rule(matching_rule, pseudo_element, contains_root_pseudo_class);
+        }
+        ++rule_index;
+    });
 
-            if constexpr (LIBWEB_CSS_DEBUG) {
-                dbgln("Resolved keyframe set '{}' into {} keyframes:", rule.name(), keyframe_set->keyframes_by_key.size());
-                for (auto it = keyframe_set->keyframes_by_key.begin(); it != keyframe_set->keyframes_by_key.end(); ++it)
-                    dbgln("    - keyframe {}: {} properties", it.key(), it->properties.size());
+    // Loosely based on https://drafts.csswg.org/css-animations-2/#keyframe-processing
+    sheet.for_each_effective_keyframes_at_rule([&](CSSKeyframesRule const& rule) {
+        auto keyframe_set = adopt_ref(*new Animations::KeyframeEffect::KeyFrameSet);
+        HashTable<PropertyID> animated_properties;
+
+        // Forwards pass, resolve all the user-specified keyframe properties.
+        for (auto const& keyframe_rule : *rule.css_rules()) {
+            auto const& keyframe = as<CSSKeyframeRule>(*keyframe_rule);
+            Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame resolved_keyframe;
+
+            auto key = static_cast<u64>(keyframe.key().value() * Animations::KeyframeEffect::AnimationKeyFrameKeyScaleFactor);
+            auto const& keyframe_style = *keyframe.style();
+            for (auto const& it : keyframe_style.properties()) {
+                // Unresolved properties will be resolved in collect_animation_into()
+                for_each_property_expanding_shorthands(it.property_id, it.value, [&](PropertyID shorthand_id, CSSStyleValue const& shorthand_value) {
+                    animated_properties.set(shorthand_id);
+                    resolved_keyframe.properties.set(shorthand_id, NonnullRefPtr<CSSStyleValue const> { shorthand_value });
+                });
             }
 
-            rule_caches.main.rules_by_animation_keyframes.set(rule.name(), move(keyframe_set));
-        });
-        ++style_sheet_index;
+            keyframe_set->keyframes_by_key.insert(key, resolved_keyframe);
+        }
+
+        Animations::KeyframeEffect::generate_initial_and_final_frames(keyframe_set, animated_properties);
+
+        if constexpr (LIBWEB_CSS_DEBUG) {
+            dbgln("Resolved keyframe set '{}' into {} keyframes:", rule.name(), keyframe_set->keyframes_by_key.size());
+            for (auto it = keyframe_set->keyframes_by_key.begin(); it != keyframe_set->keyframes_by_key.end(); ++it)
+                dbgln("    - keyframe {}: {} properties", it.key(), it->properties.size());
+        }
+
+        rule_caches.main.rules_by_animation_keyframes.set(rule.name(), move(keyframe_set));
     });
 }
 
@@ -3039,48 +3171,212 @@ void StyleComputer::build_qualified_layer_names_cache()
 
 void StyleComputer::build_rule_cache()
 {
-    m_author_rule_cache = make<RuleCachesForDocumentAndShadowRoots>();
-    m_user_rule_cache = make<RuleCachesForDocumentAndShadowRoots>();
-    m_user_agent_rule_cache = make<RuleCachesForDocumentAndShadowRoots>();
+    if (m_user_agent_and_user_rule_data && m_user_agent_and_user_rule_data->is_for_quirks_mode != document().in_quirks_mode())
+        invalidate_user_rule_cache();
 
-    m_selector_insights = make<SelectorInsights>();
-    m_style_invalidation_data = make<StyleInvalidationData>();
+    if (!m_user_agent_and_user_rule_data) {
+        m_user_rule_cache = make<RuleCachesForDocumentAndShadowRoots>();
+        m_user_agent_rule_cache = make<RuleCachesForDocumentAndShadowRoots>();
 
-    if (auto user_style_source = document().page().user_style(); user_style_source.has_value()) {
-        m_user_style_sheet = GC::make_root(parse_css_stylesheet(CSS::Parser::ParsingParams(document()), user_style_source.value()));
-    }
+        m_selector_insights = make<SelectorInsights>();
+        m_style_invalidation_data = make<StyleInvalidationData>();
 
-    build_qualified_layer_names_cache();
+        if (auto user_style_source = document().page().user_style(); user_style_source.has_value()) {
+            m_user_style_sheet = GC::make_root(parse_css_stylesheet(CSS::Parser::ParsingParams(document()), user_style_source.value()));
+        }
+
+        m_pseudo_class_rule_cache = {};
+        m_pseudo_class_rule_cache[to_underlying(PseudoClass::Hover)] = make<RuleCache>();
+        m_pseudo_class_rule_cache[to_underlying(PseudoClass::Active)] = make<RuleCache>();
+        m_pseudo_class_rule_cache[to_underlying(PseudoClass::Focus)] = make<RuleCache>();
+        m_pseudo_class_rule_cache[to_underlying(PseudoClass::FocusWithin)] = make<RuleCache>();
+        m_pseudo_class_rule_cache[to_underlying(PseudoClass::FocusVisible)] = make<RuleCache>();
+        m_pseudo_class_rule_cache[to_underlying(PseudoClass::Target)] = make<RuleCache>();
+        m_pseudo_class_rule_cache[to_underlying(PseudoClass::TargetWithin)] = make<RuleCache>();
+
+        make_rule_cache_for_cascade_origin(CascadeOrigin::User, *m_selector_insights);
+        make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent, *m_selector_insights);
 
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Hover)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Active)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Focus)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::FocusWithin)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::FocusVisible)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::Target)] = make<RuleCache>();
-    m_pseudo_class_rule_cache[to_underlying(PseudoClass::TargetWithin)] = make<RuleCache>();
+        m_user_agent_and_user_rule_data = make<UserAgentAndUserRuleData>();
+        m_user_agent_and_user_rule_data->is_for_quirks_mode = document().in_quirks_mode();
+        m_user_agent_and_user_rule_data->selector_insights = *m_selector_insights;
+        m_user_agent_and_user_rule_data->style_invalidation_data = *m_style_invalidation_data;
+        for (size_t i = 0; i < m_pseudo_class_rule_cache.size(); ++i) {
+            if (m_pseudo_class_rule_cache[i])
+                m_user_agent_and_user_rule_data->pseudo_class_rule_cache[i] = make<RuleCache>(*m_pseudo_class_rule_cache[i]);
+        }
+    } else {
+        auto const& data = *m_user_agent_and_user_rule_data;
+        m_selector_insights = make<SelectorInsights>(data.selector_insights);
+        m_style_invalidation_data = make<StyleInvalidationData>(data.style_invalidation_data);
+        for (size_t i = 0; i < m_pseudo_class_rule_cache.size(); ++i) {
+            if (data.pseudo_class_rule_cache[i])
+                m_pseudo_class_rule_cache[i] = make<RuleCache>(*data.pseudo_class_rule_cache[i]);
+        }
+    }
 
+    m_author_rule_cache = make<RuleCachesForDocumentAndShadowRoots>();
+    build_qualified_layer_names_cache();
     make_rule_cache_for_cascade_origin(CascadeOrigin::Author, *m_selector_insights);
-    make_rule_cache_for_cascade_origin(CascadeOrigin::User, *m_selector_insights);
-    make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent, *m_selector_insights);
 }
 
 void StyleComputer::invalidate_rule_cache()
 {
     m_author_rule_cache = nullptr;
 
-    // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
-    //       Currently we are re-parsing the user style sheet every time we build the caches,
-    //       as it may have changed.
+    m_pseudo_class_rule_cache = {};
+    m_style_invalidation_data = nullptr;
+    m_style_sharing_candidates.clear();
+    m_elements_sharing_style.clear();
+    m_matched_properties_cache.clear();
+}
+
+void StyleComputer::invalidate_user_rule_cache()
+{
+    // NOTE: The user style sheet is parsed again when rebuilding the rule cache, since its source may have changed.
     m_user_rule_cache = nullptr;
     m_user_style_sheet = nullptr;
-
-    // NOTE: It might not be necessary to throw away the UA rule cache.
-    //       If we are sure that it's safe, we could keep it as an optimization.
     m_user_agent_rule_cache = nullptr;
+    m_user_agent_and_user_rule_data = nullptr;
+    invalidate_rule_cache();
+}
 
-    m_pseudo_class_rule_cache = {};
-    m_style_invalidation_data = nullptr;
+static bool has_layer_rules(CSSStyleSheet const& sheet)
+{
+    bool found = false;
+    sheet.for_each_effective_rule(TraversalOrder::Preorder, [&](CSSRule const& rule) {
+        if (first_is_one_of(rule.type(), CSSRule::Type::LayerBlock, CSSRule::Type::LayerStatement))
+            found = true;
+    });
+    return found;
+}
+
+bool StyleComputer::add_style_sheet_to_rule_cache(CSSStyleSheet const& sheet)
+{
+    if (!has_valid_rule_cache())
+        return false;
+
+    // NOTE: New @layer names may go anywhere in the layer order, so those need a full rebuild.
+    if (has_layer_rules(sheet))
+        return false;
+
+    // The sheet's rules can only be appended if it comes after every other active style sheet.
+    CSSStyleSheet const* last_sheet = nullptr;
+    GC::Ptr<DOM::ShadowRoot const> last_sheet_shadow_root;
+    document().for_each_active_css_style_sheet([&](CSSStyleSheet& active_sheet, GC::Ptr<DOM::ShadowRoot> shadow_root) {
+        last_sheet = &active_sheet;
+        last_sheet_shadow_root = shadow_root;
+    });
+    if (last_sheet != &sheet)
+        return false;
+
+    add_style_sheet_to_rule_cache(CascadeOrigin::Author, sheet, last_sheet_shadow_root, m_next_author_style_sheet_index++, *m_selector_insights);
+    m_style_sharing_candidates.clear();
+    m_elements_sharing_style.clear();
+    m_matched_properties_cache.clear();
+    return true;
+}
+
+bool StyleComputer::remove_style_sheet_from_rule_cache(CSSStyleSheet const& sheet)
+{
+    if (!has_valid_rule_cache())
+        return false;
+
+    // NOTE: An earlier definition of the same @keyframes may have to come back, so those need a full rebuild as well.
+    bool has_keyframes = false;
+    sheet.for_each_effective_keyframes_at_rule([&](auto const&) { has_keyframes = true; });
+    if (has_keyframes || has_layer_rules(sheet))
+        return false;
+
+    auto remove_from_rule_caches = [&](RuleCaches& rule_caches) {
+        rule_caches.main.remove_rules_from_style_sheet(sheet);
+        for (auto& it : rule_caches.by_layer)
+            it.value->remove_rules_from_style_sheet(sheet);
+    };
+    remove_from_rule_caches(m_author_rule_cache->for_document);
+    for (auto& it : m_author_rule_cache->for_shadow_roots)
+        remove_from_rule_caches(*it.value);
+    for (auto& rule_cache : m_pseudo_class_rule_cache) {
+        if (rule_cache)
+            rule_cache->remove_rules_from_style_sheet(sheet);
+    }
+
+    // NOTE: The selector insights and invalidation data still cover the removed rules. That can only cause more
+    //       invalidation than necessary until the next rebuild, never less.
+    m_style_sharing_candidates.clear();
+    m_elements_sharing_style.clear();
+    m_matched_properties_cache.clear();
+    return true;
+}
+
+InvalidationSet StyleComputer::invalidation_set_for_style_sheet(CSSStyleSheet const& sheet) const
+{
+    InvalidationSet invalidation_set;
+
+    // NOTE: Class and id selectors match case-insensitively in quirks mode, which the invalidation set can't express.
+    if (document().in_quirks_mode()) {
+        invalidation_set.set_needs_invalidate_whole_subtree();
+        return invalidation_set;
+    }
+
+    // A rule can only match an element that has every class and id named in the rightmost compound selector, so one
+    // of those is enough to find the elements that may be affected.
+    auto add_selector = [&](Selector const& selector) {
+        if (selector.contains_pseudo_class(PseudoClass::Has)) {
+            invalidation_set.set_needs_invalidate_whole_subtree();
+            return;
+        }
+        Optional<FlyString> id;
+        Optional<FlyString> class_name;
+        for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+            if (simple_selector.type == Selector::SimpleSelector::Type::Id)
+                id = simple_selector.name();
+            else if (simple_selector.type == Selector::SimpleSelector::Type::Class)
+                class_name = simple_selector.name();
+        }
+        if (id.has_value())
+            invalidation_set.set_needs_invalidate_id(*id);
+        else if (class_name.has_value())
+            invalidation_set.set_needs_invalidate_class(*class_name);
+        else
+            invalidation_set.set_needs_invalidate_whole_subtree();
+    };
+
+    // Custom properties set by a rule can change the style of any descendant that uses them.
+    auto add_declaration = [&](CSSStyleProperties const& declaration) {
+        if (!declaration.custom_properties().is_empty())
+            invalidation_set.set_needs_invalidate_whole_subtree();
+    };
+
+    sheet.for_each_effective_rule(TraversalOrder::Preorder, [&](CSSRule const& rule) {
+        if (invalidation_set.needs_invalidate_whole_subtree())
+            return;
+        switch (rule.type()) {
+        case CSSRule::Type::Style: {
+            auto const& style_rule = static_cast<CSSStyleRule const&>(rule);
+            for (auto const& selector : style_rule.absolutized_selectors())
+                add_selector(selector);
+            add_declaration(style_rule.declaration());
+            break;
+        }
+        case CSSRule::Type::NestedDeclarations:
+            add_declaration(static_cast<CSSNestedDeclarations const&>(rule).declaration());
+            break;
+        case CSSRule::Type::FontFace:
+        case CSSRule::Type::Keyframes:
+        case CSSRule::Type::LayerBlock:
+        case CSSRule::Type::LayerStatement:
+        case CSSRule::Type::Property:
+            // These can change the style of elements that no selector in the sheet matches. For @font-face, that's
+            // every element using the family, which has to be restyled when the font is added or goes away.
+            invalidation_set.set_needs_invalidate_whole_subtree();
+            break;
+        default:
+            break;
+        }
+    });
+
+    return invalidation_set;
 }
 
 void StyleComputer::did_load_font(FlyString const&)
@@ -3218,6 +3514,20 @@ static void for_each_element_hash(DOM::Element const& element, auto callback)
     });
 }
 
+void AncestorFilter::push(DOM::Element const& element)
+{
+    for_each_element_hash(element, [&](u32 hash) {
+        m_filter.increment(hash);
+    });
+}
+
+void AncestorFilter::pop(DOM::Element const& element)
+{
+    for_each_element_hash(element, [&](u32 hash) {
+        m_filter.decrement(hash);
+    });
+}
+
 void StyleComputer::reset_ancestor_filter()
 {
     m_ancestor_filter.clear();
@@ -3225,16 +3535,200 @@ void StyleComputer::reset_ancestor_filter()
 
 void StyleComputer::push_ancestor(DOM::Element const& element)
 {
-    for_each_element_hash(element, [&](u32 hash) {
-        m_ancestor_filter.increment(hash);
-    });
+    m_ancestor_filter.push(element);
 }
 
 void StyleComputer::pop_ancestor(DOM::Element const& element)
 {
-    for_each_element_hash(element, [&](u32 hash) {
-        m_ancestor_filter.decrement(hash);
-    });
+    m_ancestor_filter.pop(element);
+}
+
+void StyleComputer::set_style_sharing_enabled(Badge<DOM::Document>, bool enabled)
+{
+    m_style_sharing_enabled = enabled;
+    m_style_sharing_candidates.clear();
+    m_elements_sharing_style.clear();
+    m_matched_properties_cache.clear();
+}
+
+void StyleComputer::visit_edges(JS::Cell::Visitor& visitor) const
+{
+    for (auto const& candidate : m_style_sharing_candidates)
+        visitor.visit(candidate.element);
+    for (auto const& element : m_elements_sharing_style)
+        visitor.visit(element);
+    for (auto const& it : m_matched_properties_cache)
+        visitor.visit(it.value.cascaded_properties);
+}
+
+Vector<MatchingRule const*> StyleComputer::flatten_matching_rule_set(MatchingRuleSet const& matching_rule_set)
+{
+    // NOTE: The lists are separated by null entries, so that a rule moving from one layer to the next changes the key.
+    Vector<MatchingRule const*> matched_rules;
+    matched_rules.extend(matching_rule_set.user_agent_rules);
+    matched_rules.append(nullptr);
+    matched_rules.extend(matching_rule_set.user_rules);
+    for (auto const& layer : matching_rule_set.author_rules) {
+        matched_rules.append(nullptr);
+        matched_rules.extend(layer.rules);
+    }
+    return matched_rules;
+}
+
+static u32 hash_matched_rules(Vector<MatchingRule const*> const& matched_rules)
+{
+    u32 hash = 0;
+    for (auto const* rule : matched_rules)
+        hash = pair_int_hash(hash, ptr_hash(rule));
+    return hash;
+}
+
+GC::Ptr<CascadedProperties> StyleComputer::find_matched_properties(Vector<MatchingRule const*> const& matched_rules) const
+{
+    auto it = m_matched_properties_cache.find(hash_matched_rules(matched_rules));
+    if (it == m_matched_properties_cache.end() || it->value.matched_rules != matched_rules) {
+        ++m_style_sharing_statistics.matched_properties_misses;
+        return nullptr;
+    }
+    ++m_style_sharing_statistics.matched_properties_hits;
+    return it->value.cascaded_properties;
+}
+
+void StyleComputer::add_matched_properties(Vector<MatchingRule const*> matched_rules, GC::Ref<CascadedProperties> cascaded_properties) const
+{
+    if (m_matched_properties_cache.size() >= matched_properties_cache_size)
+        return;
+
+    // Declarations that need var() substitution depend on the custom properties of the element that matched them.
+    for (auto const* rule : matched_rules) {
+        if (!rule)
+            continue;
+        for (auto const& property : rule->declaration().properties()) {
+            if (property.value->is_unresolved())
+                return;
+        }
+    }
+
+    auto hash = hash_matched_rules(matched_rules);
+    m_matched_properties_cache.set(hash, MatchedPropertiesCacheEntry { move(matched_rules), cascaded_properties });
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    auto attribute_count = a.attribute_list_size();
+    if (attribute_count != b.attribute_list_size())
+        return false;
+    if (attribute_count == 0)
+        return true;
+
+    auto const& a_attributes = *a.attributes();
+    auto const& b_attributes = *b.attributes();
+    for (size_t i = 0; i < attribute_count; ++i) {
+        auto const& a_attribute = *a_attributes.item(i);
+        auto const& b_attribute = *b_attributes.item(i);
+        if (a_attribute.local_name() != b_attribute.local_name()
+            || a_attribute.namespace_uri() != b_attribute.namespace_uri()
+            || a_attribute.value() != b_attribute.value())
+            return false;
+    }
+    return true;
+}
+
+// Returns whether the element, or anything inside it, is what :hover, :active, :focus, :focus-visible, :focus-within,
+// :target or :target-within look at.
+static bool contains_node_in_dynamic_state(DOM::Element const& element)
+{
+    auto const& document = element.document();
+    auto contains = [&](DOM::Node const* node) {
+        return node && element.is_shadow_including_inclusive_ancestor_of(*node);
+    };
+    return contains(document.hovered_node())
+        || contains(document.active_element())
+        || contains(document.focused_element())
+        || contains(document.target_element());
+}
+
+static PseudoClassBitmap const& pseudo_classes_that_allow_style_sharing()
+{
+    // These only depend on the element's attributes, its ancestors, or on state that is checked by can_share_style_with().
+    static auto const pseudo_classes = [] {
+        PseudoClassBitmap pseudo_classes;
+        for (auto pseudo_class : { PseudoClass::Active, PseudoClass::AnyLink, PseudoClass::Focus, PseudoClass::FocusVisible,
+                 PseudoClass::FocusWithin, PseudoClass::Hover, PseudoClass::Is, PseudoClass::Link, PseudoClass::LocalLink,
+                 PseudoClass::Not, PseudoClass::Root, PseudoClass::Target, PseudoClass::TargetWithin, PseudoClass::Visited,
+                 PseudoClass::Where })
+            pseudo_classes.set(pseudo_class, true);
+        return pseudo_classes;
+    }();
+    return pseudo_classes;
+}
+
+bool StyleComputer::can_share_style_with(DOM::Element const& element, DOM::Element const& candidate) const
+{
+    if (&element == &candidate
+        || element.local_name() != candidate.local_name()
+        || element.namespace_uri() != candidate.namespace_uri())
+        return false;
+
+    auto const* parent = element.parent_element();
+    auto const* candidate_parent = candidate.parent_element();
+    if (parent != candidate_parent) {
+        // Cousins match the same rules if their parents do, which we know for sure when the parents ended up with the
+        // same cascaded properties through style sharing. That only holds if it happened during this style update;
+        // parents that weren't restyled may still hold on to cascaded properties from before the last DOM change.
+        if (m_selector_insights->has_sibling_combinators_outside_of_subject)
+            return false;
+        if (!m_elements_sharing_style.contains(*parent) || !m_elements_sharing_style.contains(*candidate_parent))
+            return false;
+        auto parent_cascaded_properties = parent->cascaded_properties({});
+        if (!parent_cascaded_properties || parent_cascaded_properties != candidate_parent->cascaded_properties({}))
+            return false;
+    }
+
+    if (!have_same_attributes(element, candidate))
+        return false;
+
+    // Everything above the closest common ancestor is shared, so only the two branches below it can be in a different
+    // dynamic state.
+    auto const* branch = &element;
+    auto const* candidate_branch = &candidate;
+    while (branch->parent_element() != candidate_branch->parent_element()) {
+        branch = branch->parent_element();
+        candidate_branch = candidate_branch->parent_element();
+        if (!branch || !candidate_branch)
+            return false;
+    }
+    return !contains_node_in_dynamic_state(*branch) && !contains_node_in_dynamic_state(*candidate_branch);
+}
+
+Optional<StyleComputer::StyleSharingCandidate> StyleComputer::find_style_sharing_candidate(DOM::Element const& element) const
+{
+    for (size_t i = 0; i < m_style_sharing_candidates.size(); ++i) {
+        if (!can_share_style_with(element, m_style_sharing_candidates[i].element))
+            continue;
+
+        auto candidate = m_style_sharing_candidates.take(i);
+        m_style_sharing_candidates.prepend(candidate);
+        ++m_style_sharing_statistics.hits;
+        return candidate;
+    }
+    ++m_style_sharing_statistics.misses;
+    return {};
+}
+
+void StyleComputer::add_style_sharing_candidate(DOM::Element& element, PseudoClassBitmap const& attempted_pseudo_class_matches) const
+{
+    // Elements whose matching looked at their siblings, or at per-element state we don't compare, can't share their style.
+    if (element.affected_by_direct_sibling_combinator()
+        || element.affected_by_indirect_sibling_combinator()
+        || element.affected_by_sibling_position_or_count_pseudo_class()
+        || element.affected_by_nth_child_pseudo_class()
+        || !attempted_pseudo_class_matches.is_subset_of(pseudo_classes_that_allow_style_sharing()))
+        return;
+
+    if (m_style_sharing_candidates.size() == style_sharing_cache_size)
+        m_style_sharing_candidates.take_last();
+    m_style_sharing_candidates.prepend(StyleSharingCandidate { element, attempted_pseudo_class_matches });
 }
 
 size_t StyleComputer::number_of_css_font_faces_with_loading_in_progress() const
@@ -3329,6 +3823,25 @@ void RuleCache::add_rule(MatchingRule const& matching_rule, Optional<PseudoEleme
     }
 }
 
+void RuleCache::remove_rules_from_style_sheet(CSSStyleSheet const& sheet)
+{
+    auto remove_from = [&](Vector<MatchingRule>& rules) {
+        rules.remove_all_matching([&](MatchingRule const& rule) { return rule.sheet == &sheet; });
+    };
+    for (auto& it : rules_by_id)
+        remove_from(it.value);
+    for (auto& it : rules_by_class)
+        remove_from(it.value);
+    for (auto& it : rules_by_tag_name)
+        remove_from(it.value);
+    for (auto& it : rules_by_attribute_name)
+        remove_from(it.value);
+    for (auto& rules : rules_by_pseudo_element)
+        remove_from(rules);
+    remove_from(root_rules);
+    remove_from(other_rules);
+}
+
 void RuleCache::for_each_matching_rules(DOM::Element const& element, Optional<PseudoElement> pseudo_element, Function<IterationDecision(Vector<MatchingRule> const&)> callback) const
 {
     for (auto const& class_name : element.class_names()) {
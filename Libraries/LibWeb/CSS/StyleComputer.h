@@ -74,6 +74,23 @@ private:
     CounterType m_buckets[bucket_count];
 };
 
+// Keeps track of the ancestors of the element being matched, so that selectors that need an ancestor that isn't there
+// can be rejected without running them. Elements have to be pushed and popped in tree order.
+// NOTE: The filter belongs to the traversal that fills it, so that separate traversals don't interfere with each other.
+class AncestorFilter {
+public:
+    AncestorFilter() { clear(); }
+
+    void clear() { m_filter.clear(); }
+    void push(DOM::Element const&);
+    void pop(DOM::Element const&);
+
+    [[nodiscard]] inline bool should_reject(Selector const&) const;
+
+private:
+    CountingBloomFilter<u8, 14> m_filter;
+};
+
 struct MatchingRule {
     GC::Ptr<DOM::ShadowRoot const> shadow_root;
     GC::Ptr<CSSRule const> rule; // Either CSSStyleRule or CSSNestedDeclarations
@@ -121,6 +138,7 @@ struct RuleCache {
     HashMap<FlyString, NonnullRefPtr<Animations::KeyframeEffect::KeyFrameSet>> rules_by_animation_keyframes;
 
     void add_rule(MatchingRule const&, Optional<PseudoElement>, bool contains_root_pseudo_class);
+    void remove_rules_from_style_sheet(CSSStyleSheet const&);
     void for_each_matching_rules(DOM::Element const&, Optional<PseudoElement>, Function<IterationDecision(Vector<MatchingRule> const&)> callback) const;
 };
 
@@ -164,7 +182,30 @@ public:
     bool invalidation_property_used_in_has_selector(InvalidationSet::Property const&) const;
 
     [[nodiscard]] bool has_valid_rule_cache() const { return m_author_rule_cache; }
+    // Throws away the rules from author style sheets. The rules from the user-agent and user style sheets are kept, since
+    // those only change along with the user style sheet or the document's quirks mode.
     void invalidate_rule_cache();
+    void invalidate_user_rule_cache();
+
+    // Try to update the rule cache for a single style sheet being added to or removed from the document or one of its
+    // shadow roots, and return whether that worked. If it didn't, the rule cache has to be invalidated.
+    [[nodiscard]] bool add_style_sheet_to_rule_cache(CSSStyleSheet const&);
+    [[nodiscard]] bool remove_style_sheet_from_rule_cache(CSSStyleSheet const&);
+
+    // Counts how adding and removing style sheets updated the rule cache and the style of the document.
+    struct RuleCacheUpdateStatistics {
+        u64 incremental_updates { 0 };
+        u64 full_rebuilds { 0 };
+        // Invalidations of a whole document or shadow root, whether the rule cache was updated incrementally or not.
+        u64 full_style_invalidations { 0 };
+        // Elements that were marked as needing a style update by an incremental update.
+        u64 invalidated_elements { 0 };
+    };
+    RuleCacheUpdateStatistics& rule_cache_update_statistics() { return m_rule_cache_update_statistics; }
+    RuleCacheUpdateStatistics const& rule_cache_update_statistics() const { return m_rule_cache_update_statistics; }
+
+    // Returns an invalidation set that covers every element that a rule from the style sheet could match.
+    [[nodiscard]] InvalidationSet invalidation_set_for_style_sheet(CSSStyleSheet const&) const;
 
     Gfx::Font const& initial_font() const;
 
@@ -183,6 +224,25 @@ public:
 
     void set_viewport_rect(Badge<DOM::Document>, CSSPixelRect const& viewport_rect) { m_viewport_rect = viewport_rect; }
 
+    // Style sharing lets an element skip selector matching and the cascade by reusing the cascaded properties of a
+    // recently styled sibling or cousin that is known to match exactly the same rules. Elements that can't share style
+    // that way still skip the cascade if another element has already matched the same list of rules.
+    // NOTE: This is only enabled while the document is updating its style, since the caches hold on to GC objects.
+    void set_style_sharing_enabled(Badge<DOM::Document>, bool);
+
+    struct StyleSharingStatistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 ineligible_elements { 0 };
+        u64 matched_properties_hits { 0 };
+        u64 matched_properties_misses { 0 };
+    };
+    StyleSharingStatistics const& style_sharing_statistics() const { return m_style_sharing_statistics; }
+    void reset_style_sharing_statistics() { m_style_sharing_statistics = {}; }
+
+    // Visits the GC objects held by the style sharing and matched properties caches. Called by the document.
+    void visit_edges(JS::Cell::Visitor&) const;
+
     enum class AnimationRefresh {
         No,
         Yes,
@@ -270,6 +330,9 @@ private:
 
     struct SelectorInsights {
         bool has_has_selectors { false };
+        // Sibling combinators that are not relative to the subject of a selector make its result depend on the
+        // siblings of the subject's ancestors, which rules out sharing style between cousins.
+        bool has_sibling_combinators_outside_of_subject { false };
     };
 
     struct RuleCaches {
@@ -283,6 +346,8 @@ private:
     };
 
     void make_rule_cache_for_cascade_origin(CascadeOrigin, SelectorInsights&);
+    void add_style_sheet_to_rule_cache(CascadeOrigin, CSSStyleSheet const&, GC::Ptr<DOM::ShadowRoot const>, size_t style_sheet_index, SelectorInsights&);
+    [[nodiscard]] RuleCaches& rule_caches_for(CascadeOrigin, GC::Ptr<DOM::ShadowRoot const>);
 
     [[nodiscard]] RuleCache const* rule_cache_for_cascade_origin(CascadeOrigin, FlyString const& qualified_layer_name, GC::Ptr<DOM::ShadowRoot const>) const;
 
@@ -295,6 +360,17 @@ private:
     OwnPtr<RuleCachesForDocumentAndShadowRoots> m_user_rule_cache;
     OwnPtr<RuleCachesForDocumentAndShadowRoots> m_user_agent_rule_cache;
     GC::Root<CSSStyleSheet> m_user_style_sheet;
+    size_t m_next_author_style_sheet_index { 0 };
+
+    // What the rules from the user-agent and user style sheets contribute to the data above, so that only the author
+    // rules have to be added again when rebuilding the rule cache.
+    struct UserAgentAndUserRuleData {
+        bool is_for_quirks_mode { false };
+        SelectorInsights selector_insights;
+        StyleInvalidationData style_invalidation_data;
+        Array<OwnPtr<RuleCache>, to_underlying(PseudoClass::__Count)> pseudo_class_rule_cache;
+    };
+    OwnPtr<UserAgentAndUserRuleData> m_user_agent_and_user_rule_data;
 
     using FontLoaderList = Vector<NonnullOwnPtr<FontLoader>>;
     HashMap<OwnFontFaceKey, FontLoaderList> m_loaded_fonts;
@@ -306,7 +382,37 @@ private:
 
     CSSPixelRect m_viewport_rect;
 
-    CountingBloomFilter<u8, 14> m_ancestor_filter;
+    AncestorFilter m_ancestor_filter;
+
+    struct StyleSharingCandidate {
+        GC::Ref<DOM::Element> element;
+        PseudoClassBitmap attempted_pseudo_class_matches;
+    };
+    static constexpr size_t style_sharing_cache_size = 32;
+
+    [[nodiscard]] bool can_share_style_with(DOM::Element const&, DOM::Element const& candidate) const;
+    [[nodiscard]] Optional<StyleSharingCandidate> find_style_sharing_candidate(DOM::Element const&) const;
+    void add_style_sharing_candidate(DOM::Element&, PseudoClassBitmap const& attempted_pseudo_class_matches) const;
+
+    bool m_style_sharing_enabled { false };
+    // Most recently used first.
+    mutable Vector<StyleSharingCandidate, style_sharing_cache_size> m_style_sharing_candidates;
+    // Elements that shared their cascaded properties with another element during the current style update.
+    mutable HashTable<GC::Ref<DOM::Element const>> m_elements_sharing_style;
+    mutable StyleSharingStatistics m_style_sharing_statistics;
+    RuleCacheUpdateStatistics m_rule_cache_update_statistics;
+
+    [[nodiscard]] static Vector<MatchingRule const*> flatten_matching_rule_set(MatchingRuleSet const&);
+    [[nodiscard]] GC::Ptr<CascadedProperties> find_matched_properties(Vector<MatchingRule const*> const& matched_rules) const;
+    void add_matched_properties(Vector<MatchingRule const*> matched_rules, GC::Ref<CascadedProperties>) const;
+
+    // Cascaded properties keyed by the rules that produced them, in cascade order.
+    struct MatchedPropertiesCacheEntry {
+        Vector<MatchingRule const*> matched_rules;
+        GC::Ref<CascadedProperties> cascaded_properties;
+    };
+    static constexpr size_t matched_properties_cache_size = 1024;
+    mutable HashMap<u32, MatchedPropertiesCacheEntry> m_matched_properties_cache;
 };
 
 class FontLoader : public Weakable<FontLoader> {
@@ -338,15 +444,20 @@ private:
     Function<void(RefPtr<Gfx::Typeface const>)> m_on_load;
 };
 
-inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+inline bool AncestorFilter::should_reject(Selector const& selector) const
 {
     for (u32 hash : selector.ancestor_hashes()) {
         if (hash == 0)
             break;
-        if (!m_ancestor_filter.may_contain(hash))
+        if (!m_filter.may_contain(hash))
             return true;
     }
     return false;
 }
 
+inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+{
+    return m_ancestor_filter.should_reject(selector);
+}
+
 }
@@ -10,6 +10,7 @@
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
 #include <LibWeb/HTML/Window.h>
 
 namespace Web::CSS {
@@ -116,9 +117,22 @@ void StyleSheetList::add_sheet(CSSStyleSheet& sheet)
         return;
     }
 
-    document().style_computer().invalidate_rule_cache();
-    document().style_computer().load_fonts_from_sheet(sheet);
-    document_or_shadow_root().invalidate_style(DOM::StyleInvalidationReason::StyleSheetListAddSheet);
+    auto& style_computer = document().style_computer();
+
+    // NOTE: Whether an alternate sheet ends up enabled is only decided after this, so those always rebuild the rule cache.
+    if (sheet.is_alternate() || !style_computer.add_style_sheet_to_rule_cache(sheet)) {
+        ++style_computer.rule_cache_update_statistics().full_rebuilds;
+        ++style_computer.rule_cache_update_statistics().full_style_invalidations;
+        style_computer.invalidate_rule_cache();
+        style_computer.load_fonts_from_sheet(sheet);
+        document_or_shadow_root().invalidate_style(DOM::StyleInvalidationReason::StyleSheetListAddSheet);
+        return;
+    }
+
+    ++style_computer.rule_cache_update_statistics().incremental_updates;
+
+    style_computer.load_fonts_from_sheet(sheet);
+    invalidate_style_affected_by_sheet(sheet, DOM::StyleInvalidationReason::StyleSheetListAddSheet);
 }
 
 void StyleSheetList::remove_sheet(CSSStyleSheet& sheet)
@@ -132,9 +146,53 @@ void StyleSheetList::remove_sheet(CSSStyleSheet& sheet)
         return;
     }
 
-    m_document_or_shadow_root->document().style_computer().unload_fonts_from_sheet(sheet);
-    m_document_or_shadow_root->document().style_computer().invalidate_rule_cache();
-    document_or_shadow_root().invalidate_style(DOM::StyleInvalidationReason::StyleSheetListRemoveSheet);
+    auto& style_computer = document().style_computer();
+    style_computer.unload_fonts_from_sheet(sheet);
+
+    if (!style_computer.remove_style_sheet_from_rule_cache(sheet)) {
+        ++style_computer.rule_cache_update_statistics().full_rebuilds;
+        ++style_computer.rule_cache_update_statistics().full_style_invalidations;
+        style_computer.invalidate_rule_cache();
+        document_or_shadow_root().invalidate_style(DOM::StyleInvalidationReason::StyleSheetListRemoveSheet);
+        return;
+    }
+
+    ++style_computer.rule_cache_update_statistics().incremental_updates;
+
+    invalidate_style_affected_by_sheet(sheet, DOM::StyleInvalidationReason::StyleSheetListRemoveSheet);
+}
+
+// Marks only the elements that the sheet's rules may apply to as needing a style update, after the rule cache has been
+// updated for the sheet being added or removed.
+void StyleSheetList::invalidate_style_affected_by_sheet(CSSStyleSheet const& sheet, DOM::StyleInvalidationReason reason)
+{
+    auto& statistics = document().style_computer().rule_cache_update_statistics();
+    if (!document_or_shadow_root().is_document()) {
+        ++statistics.full_style_invalidations;
+        document_or_shadow_root().invalidate_style(reason);
+        return;
+    }
+
+    auto invalidation_set = document().style_computer().invalidation_set_for_style_sheet(sheet);
+    if (invalidation_set.needs_invalidate_whole_subtree()) {
+        ++statistics.full_style_invalidations;
+        document_or_shadow_root().invalidate_style(reason);
+        return;
+    }
+    if (invalidation_set.is_empty())
+        return;
+
+    document_or_shadow_root().for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+        if (!node.is_element())
+            return TraversalDecision::Continue;
+        auto& element = static_cast<DOM::Element&>(node);
+        if (element.includes_properties_from_invalidation_set(invalidation_set)) {
+            element.set_needs_style_update(true);
+            ++statistics.invalidated_elements;
+        }
+        return TraversalDecision::Continue;
+    });
+    document().schedule_style_update();
 }
 
 GC::Ref<StyleSheetList> StyleSheetList::create(GC::Ref<DOM::Node> document_or_shadow_root)
@@ -60,6 +60,7 @@ private:
 
     void add_sheet(CSSStyleSheet&);
     void remove_sheet(CSSStyleSheet&);
+    void invalidate_style_affected_by_sheet(CSSStyleSheet const&, DOM::StyleInvalidationReason);
 
     GC::Ref<DOM::Node> m_document_or_shadow_root;
     Vector<GC::Ref<CSSStyleSheet>> m_sheets;
@@ -603,6 +603,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_session_storage_holder);
     visitor.visit(m_render_blocking_elements);
     visitor.visit(m_policy_container);
+    m_style_computer->visit_edges(visitor);
 }
 
 // https://w3c.github.io/selection-api/#dom-document-getselection
@@ -1553,7 +1554,13 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
+    // FIXME: Style independent dirty subtrees in parallel, each with its own CSS::AncestorFilter. This isn't safe yet:
+    //        - String, FlyString and RefPtr reference counts aren't atomic, and matching and cascading copy them.
+    //        - Selector matching writes invalidation flags to the matched element, its siblings and :has() anchors.
+    //        - Computing properties allocates GC cells, and creates and plays CSS animations in the document's realm.
+    style_computer().set_style_sharing_enabled({}, true);
     auto invalidation = update_style_recursively(*this, style_computer(), false);
+    style_computer().set_style_sharing_enabled({}, false);
     if (!invalidation.is_none())
         invalidate_display_list();
     if (invalidation.rebuild_stacking_context_tree)
@@ -1801,7 +1808,9 @@ void Document::invalidate_style_for_elements_affected_by_pseudo_class_change(CSS
     auto& root = old_new_common_ancestor.root();
     auto shadow_root = is<ShadowRoot>(root) ? static_cast<ShadowRoot const*>(&root) : nullptr;
 
-    auto& style_computer = this->style_computer();
+    // NOTE: This traversal starts at the root, so it keeps its own ancestor filter instead of disturbing the one used
+    //       for computing style.
+    CSS::AncestorFilter ancestor_filter;
     auto does_rule_match_on_element = [&](Element const& element, CSS::MatchingRule const& rule) {
         auto rule_root = rule.shadow_root;
         auto from_user_agent_or_user_stylesheet = rule.cascade_origin == CSS::CascadeOrigin::UserAgent || rule.cascade_origin == CSS::CascadeOrigin::User;
@@ -1812,7 +1821,7 @@ void Document::invalidate_style_for_elements_affected_by_pseudo_class_change(CSS
             return false;
 
         auto const& selector = rule.selector;
-        if (selector.can_use_ancestor_filter() && style_computer.should_reject_with_ancestor_filter(selector))
+        if (selector.can_use_ancestor_filter() && ancestor_filter.should_reject(selector))
             return false;
 
         SelectorEngine::MatchContext context;
@@ -1849,7 +1858,7 @@ void Document::invalidate_style_for_elements_affected_by_pseudo_class_change(CSS
     Function<void(Node&)> invalidate_affected_elements_recursively = [&](Node& node) -> void {
         if (node.is_element()) {
             auto& element = static_cast<Element&>(node);
-            style_computer.push_ancestor(element);
+            ancestor_filter.push(element);
             if (element.affected_by_pseudo_class(pseudo_class) && matches_different_set_of_rules_after_state_change(element)) {
                 element.set_needs_style_update(true);
             }
@@ -1861,7 +1870,7 @@ void Document::invalidate_style_for_elements_affected_by_pseudo_class_change(CSS
         });
 
         if (node.is_element())
-            style_computer.pop_ancestor(static_cast<Element&>(node));
+            ancestor_filter.pop(static_cast<Element&>(node));
     };
 
     invalidate_affected_elements_recursively(root);
@@ -609,15 +609,16 @@ static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation(C
     if (!old_style.computed_font_list().equals(new_style.computed_font_list()))
         invalidation.relayout = true;
 
-    for (auto i = to_underlying(CSS::first_property_id); i <= to_underlying(CSS::last_property_id); ++i) {
-        auto property_id = static_cast<CSS::PropertyID>(i);
+    old_style.for_each_property_that_may_differ(new_style, [&](CSS::PropertyID property_id) {
+        if (property_id < CSS::first_property_id || property_id > CSS::last_property_id)
+            return;
         auto old_value = old_style.maybe_null_property(property_id);
         auto new_value = new_style.maybe_null_property(property_id);
         if (!old_value && !new_value)
-            continue;
+            return;
 
         invalidation |= CSS::compute_property_invalidation(property_id, old_value, new_value);
-    }
+    });
     return invalidation;
 }
 
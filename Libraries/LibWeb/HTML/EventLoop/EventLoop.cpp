@@ -214,6 +214,12 @@ void EventLoop::process()
         for (auto& win : same_loop_windows()) {
             win->start_an_idle_period();
         }
+
+        // OPTIMIZATION: Use the idle period to collect garbage if a collection is coming due anyway,
+        //               so that it doesn't end up interrupting a task or a rendering update later.
+        auto idle_time_remaining = compute_deadline() - HighResolutionTime::unsafe_shared_current_time();
+        if (idle_time_remaining > 0)
+            heap().collect_garbage_during_idle_period(AK::Duration::from_microseconds(static_cast<i64>(idle_time_remaining * 1000)));
     }
 
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
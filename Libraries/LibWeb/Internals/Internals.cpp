@@ -7,6 +7,8 @@
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/ComputedProperties.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -239,6 +241,61 @@ void Internals::set_browser_zoom(double factor)
     page().client().page_did_set_browser_zoom(factor);
 }
 
+JS::Object* Internals::get_style_sharing_statistics()
+{
+    auto const& statistics = window().associated_document().style_computer().style_sharing_statistics();
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("hits"_fly_string, JS::Value(statistics.hits), JS::default_attributes);
+    result->define_direct_property("misses"_fly_string, JS::Value(statistics.misses), JS::default_attributes);
+    result->define_direct_property("ineligibleElements"_fly_string, JS::Value(statistics.ineligible_elements), JS::default_attributes);
+    result->define_direct_property("matchedPropertiesHits"_fly_string, JS::Value(statistics.matched_properties_hits), JS::default_attributes);
+    result->define_direct_property("matchedPropertiesMisses"_fly_string, JS::Value(statistics.matched_properties_misses), JS::default_attributes);
+    return result;
+}
+
+void Internals::reset_style_sharing_statistics()
+{
+    window().associated_document().style_computer().reset_style_sharing_statistics();
+}
+
+JS::Object* Internals::get_computed_property_group_statistics()
+{
+    // Counts the groups of computed property values held by the elements of the document, and how many of those are
+    // distinct, i.e. not shared with another element.
+    size_t groups = 0;
+    HashTable<void const*> distinct_groups;
+    window().associated_document().for_each_in_inclusive_subtree_of_type<DOM::Element>([&](DOM::Element const& element) {
+        if (auto computed_properties = element.computed_properties()) {
+            computed_properties->for_each_property_group([&](void const* group) {
+                ++groups;
+                distinct_groups.set(group);
+            });
+        }
+        return TraversalDecision::Continue;
+    });
+
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("groups"_fly_string, JS::Value(groups), JS::default_attributes);
+    result->define_direct_property("distinctGroups"_fly_string, JS::Value(distinct_groups.size()), JS::default_attributes);
+    return result;
+}
+
+JS::Object* Internals::get_rule_cache_update_statistics()
+{
+    auto const& statistics = window().associated_document().style_computer().rule_cache_update_statistics();
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("incrementalUpdates"_fly_string, JS::Value(statistics.incremental_updates), JS::default_attributes);
+    result->define_direct_property("fullRebuilds"_fly_string, JS::Value(statistics.full_rebuilds), JS::default_attributes);
+    result->define_direct_property("fullStyleInvalidations"_fly_string, JS::Value(statistics.full_style_invalidations), JS::default_attributes);
+    result->define_direct_property("invalidatedElements"_fly_string, JS::Value(statistics.invalidated_elements), JS::default_attributes);
+    return result;
+}
+
+void Internals::reset_rule_cache_update_statistics()
+{
+    window().associated_document().style_computer().rule_cache_update_statistics() = {};
+}
+
 bool Internals::headless()
 {
     return page().client().is_headless();
@@ -58,6 +58,12 @@ public:
 
     void set_browser_zoom(double factor);
 
+    JS::Object* get_style_sharing_statistics();
+    void reset_style_sharing_statistics();
+    JS::Object* get_computed_property_group_statistics();
+    JS::Object* get_rule_cache_update_statistics();
+    void reset_rule_cache_update_statistics();
+
     bool headless();
 
 private:
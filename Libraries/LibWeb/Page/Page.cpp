@@ -581,7 +581,7 @@ void Page::set_user_style(String source)
 {
     m_user_style_sheet_source = source;
     if (top_level_traversable_is_initialized() && top_level_traversable()->active_document()) {
-        top_level_traversable()->active_document()->style_computer().invalidate_rule_cache();
+        top_level_traversable()->active_document()->style_computer().invalidate_user_rule_cache();
     }
 }
 
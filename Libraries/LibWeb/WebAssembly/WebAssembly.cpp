@@ -19,6 +19,8 @@
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
+#include <LibThreading/BackgroundAction.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/ResponsePrototype.h>
@@ -409,24 +411,44 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
     return instance_result.release_value();
 }
 
-// // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
-JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+using ModuleOrCompileError = ErrorOr<NonnullRefPtr<Wasm::Module>, ByteString>;
+
+// Parses and validates a module. This doesn't touch the JS heap, so it's safe to do off the main thread.
+static ModuleOrCompileError parse_and_validate_a_webassembly_module(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data.bytes() };
+    auto& module_cache = Wasm::ModuleCache::the();
+    if (auto module = module_cache.load(data))
+        return module.release_nonnull();
+
+    FixedMemoryStream stream { data };
     auto module_result = Wasm::Module::parse(stream);
-    if (module_result.is_error()) {
-        return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
-    }
+    if (module_result.is_error())
+        return Wasm::parse_error_to_byte_string(module_result.error());
+
+    if (auto validation_result = Wasm::AbstractMachine::validate(module_result.value()); validation_result.is_error())
+        return validation_result.release_error().error_string;
+
+    module_cache.store(data, module_result.value());
+    return module_result.release_value();
+}
+
+static JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> create_a_compiled_webassembly_module(JS::VM& vm, ModuleOrCompileError module_or_error)
+{
+    if (module_or_error.is_error())
+        return vm.throw_completion<CompileError>(module_or_error.release_error());
 
     auto& cache = get_cache(*vm.current_realm());
-    if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
-        return vm.throw_completion<CompileError>(validation_result.error().error_string);
-    }
-    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
+    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_or_error.release_value());
     cache.add_compiled_module(compiled_module);
     return compiled_module;
 }
 
+// // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+{
+    return create_a_compiled_webassembly_module(vm, parse_and_validate_a_webassembly_module(data));
+}
+
 GC_DEFINE_ALLOCATOR(ExportedWasmFunction);
 
 GC::Ref<ExportedWasmFunction> ExportedWasmFunction::create(JS::Realm& realm, FlyString const& name, Function<JS::ThrowCompletionOr<JS::Value>(JS::VM&)> behavior, Wasm::FunctionAddress exported_address)
@@ -637,32 +659,40 @@ GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, B
     auto promise = WebIDL::create_promise(realm);
 
     // 2. Run the following steps in parallel:
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(vm.heap(), [&vm, &realm, bytes = move(bytes), promise, task_source]() mutable {
-        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
-        // 1. Compile the WebAssembly module bytes and store the result as module.
-        auto module_or_error = Detail::compile_a_webassembly_module(vm, move(bytes));
-
-        // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
-        HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
-            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
-            auto& realm = HTML::relevant_realm(*promise->promise());
-
-            // 1. If module is error, reject promise with a CompileError exception.
-            if (module_or_error.is_error()) {
-                WebIDL::reject_promise(realm, promise, module_or_error.error_value());
-            }
-
-            // 2. Otherwise,
-            else {
-                // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
-                // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
-                auto module_object = realm.create<Module>(realm, module_or_error.release_value());
-
-                // 2. Resolve promise with moduleObject.
-                WebIDL::resolve_promise(realm, promise, module_object);
-            }
-        }));
-    }));
+    // NOTE: Parsing and validating the module happens on a background thread, everything that touches the JS heap
+    //       happens once we're back on the main thread.
+    (void)Threading::BackgroundAction<Detail::ModuleOrCompileError>::construct(
+        [bytes = move(bytes)](auto&) -> ErrorOr<Detail::ModuleOrCompileError> {
+            return Detail::ModuleOrCompileError { Detail::parse_and_validate_a_webassembly_module(bytes) };
+        },
+        [&vm, realm = GC::make_root(realm), promise = GC::make_root(promise), task_source](Detail::ModuleOrCompileError parsed_module_or_error) -> ErrorOr<void> {
+            HTML::TemporaryExecutionContext context(*realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+            // 1. Compile the WebAssembly module bytes and store the result as module.
+            auto module_or_error = Detail::create_a_compiled_webassembly_module(vm, move(parsed_module_or_error));
+
+            // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
+            HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [promise = GC::Ref(*promise), module_or_error = move(module_or_error)]() mutable {
+                auto& realm = HTML::relevant_realm(*promise->promise());
+                HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+                // 1. If module is error, reject promise with a CompileError exception.
+                if (module_or_error.is_error()) {
+                    WebIDL::reject_promise(realm, promise, module_or_error.error_value());
+                }
+
+                // 2. Otherwise,
+                else {
+                    // 1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
+                    // FIXME: Save bytes to the Module instance instead of moving into compile_a_webassembly_module
+                    auto module_object = realm.create<Module>(realm, module_or_error.release_value());
+
+                    // 2. Resolve promise with moduleObject.
+                    WebIDL::resolve_promise(realm, promise, module_object);
+                }
+            }));
+
+            return {};
+        });
 
     // 3. Return promise.
     return promise;
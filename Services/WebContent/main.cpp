@@ -10,6 +10,7 @@
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
 #include <LibCore/Resource.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/SystemServerTakeover.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/PathFontProvider.h>
@@ -18,6 +19,7 @@
 #include <LibMain/Main.h>
 #include <LibMedia/Audio/Loader.h>
 #include <LibRequests/RequestClient.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/Internals.h>
@@ -108,6 +110,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool disable_site_isolation = false;
     bool enable_idl_tracing = false;
     bool enable_http_cache = false;
+    bool enable_wasm_module_cache = false;
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
@@ -130,6 +133,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(disable_site_isolation, "Disable site isolation", "disable-site-isolation");
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
+    args_parser.add_option(enable_wasm_module_cache, "Enable the on-disk WebAssembly module cache", "enable-wasm-module-cache");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
@@ -170,6 +174,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         Web::Fetch::Fetching::g_http_cache_enabled = true;
     }
 
+    if (enable_wasm_module_cache)
+        Wasm::ModuleCache::the().set_directory(ByteString::formatted("{}/Ladybird/WasmModuleCache", Core::StandardPaths::user_data_directory()));
+
     Web::Painting::g_paint_viewport_scrollbars = !disable_scrollbar_painting;
 
     if (!echo_server_port_string_view.is_empty()) {
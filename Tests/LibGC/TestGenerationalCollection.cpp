@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+static size_t s_destroyed_node_count = 0;
+static size_t s_visited_node_count = 0;
+
+class ListNode final : public GC::Cell {
+    GC_CELL(ListNode, GC::Cell);
+    GC_DECLARE_WRITE_BARRIER(ListNode);
+
+public:
+    virtual ~ListNode() override { ++s_destroyed_node_count; }
+
+    void set_next(ListNode& next)
+    {
+        m_next = next;
+        did_store_edge();
+    }
+
+private:
+    ListNode() = default;
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        ++s_visited_node_count;
+        visitor.visit(m_next);
+    }
+
+    GC::Ptr<ListNode> m_next;
+};
+
+static Vector<GC::Root<ListNode>> allocate_old_nodes(GC::Heap& heap, size_t count)
+{
+    Vector<GC::Root<ListNode>> nodes;
+    for (size_t i = 0; i < count; ++i)
+        nodes.append(heap.allocate<ListNode>());
+    heap.collect_garbage(GC::Heap::CollectionType::CollectMinor);
+    return nodes;
+}
+
+NEVER_INLINE static void store_young_node(GC::Heap& heap, ListNode& old_node)
+{
+    old_node.set_next(heap.allocate<ListNode>());
+}
+
+TEST_CASE(minor_collection_only_visits_remembered_old_cells)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_generational_collection_enabled(true);
+    auto nodes = allocate_old_nodes(heap, 1000);
+
+    s_visited_node_count = 0;
+    heap.collect_garbage(GC::Heap::CollectionType::CollectMinor);
+    EXPECT_EQ(s_visited_node_count, 0u);
+
+    store_young_node(heap, *nodes[500]);
+    s_visited_node_count = 0;
+    heap.collect_garbage(GC::Heap::CollectionType::CollectMinor);
+
+    // The remembered node and the young node it points to.
+    EXPECT_EQ(s_visited_node_count, 2u);
+
+    // The store was forgotten by the previous collection, after which nothing points into the young generation.
+    s_visited_node_count = 0;
+    heap.collect_garbage(GC::Heap::CollectionType::CollectMinor);
+    EXPECT_EQ(s_visited_node_count, 0u);
+}
+
+TEST_CASE(remembered_old_cell_keeps_young_cell_alive)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_generational_collection_enabled(true);
+    auto nodes = allocate_old_nodes(heap, 1);
+
+    store_young_node(heap, *nodes[0]);
+    s_destroyed_node_count = 0;
+    heap.collect_garbage(GC::Heap::CollectionType::CollectMinor);
+    EXPECT_EQ(s_destroyed_node_count, 0u);
+
+    // The young node has been promoted, so a full collection has to keep it alive through its old parent.
+    heap.collect_garbage();
+    EXPECT_EQ(s_destroyed_node_count, 0u);
+}
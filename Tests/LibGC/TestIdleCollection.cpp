@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Time.h>
+#include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
+#include <LibTest/TestCase.h>
+
+class Garbage final : public GC::Cell {
+    GC_CELL(Garbage, GC::Cell);
+
+private:
+    Garbage() = default;
+
+    [[maybe_unused]] u8 m_payload[112];
+};
+
+NEVER_INLINE static void allocate_garbage(GC::Heap& heap, size_t byte_count)
+{
+    for (size_t i = 0; i < byte_count / sizeof(Garbage); ++i)
+        (void)heap.allocate<Garbage>();
+}
+
+TEST_CASE(first_idle_collection_needs_room_for_a_conservative_estimate)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+
+    // Make a collection more than halfway due, without any collection having happened yet.
+    allocate_garbage(heap, 3 * MiB);
+
+    EXPECT(!heap.collect_garbage_during_idle_period(AK::Duration::from_microseconds(1)));
+    EXPECT_EQ(heap.collection_statistics().major_collections, 0u);
+
+    EXPECT(heap.collect_garbage_during_idle_period(AK::Duration::from_seconds(10)));
+    EXPECT_EQ(heap.collection_statistics().major_collections, 1u);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+#include <LibTest/TestCase.h>
+
+static size_t s_destroyed_node_count = 0;
+static size_t s_destroyed_tree_node_count = 0;
+
+class TreeNode final : public GC::Cell {
+    GC_CELL(TreeNode, GC::Cell);
+
+public:
+    virtual ~TreeNode() override
+    {
+        ++s_destroyed_node_count;
+        if (m_is_in_tree)
+            ++s_destroyed_tree_node_count;
+    }
+
+    void append_child(TreeNode& child) { m_children.append(child); }
+    void set_in_tree() { m_is_in_tree = true; }
+
+    // Counts the nodes reachable from this one, including itself.
+    size_t count_nodes() const
+    {
+        size_t count = 0;
+        Vector<TreeNode const*> stack;
+        stack.append(this);
+        while (!stack.is_empty()) {
+            auto const* node = stack.take_last();
+            ++count;
+            for (auto const& child : node->m_children)
+                stack.append(child.ptr());
+        }
+        return count;
+    }
+
+private:
+    TreeNode() = default;
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(m_children);
+    }
+
+    Vector<GC::Ref<TreeNode>> m_children;
+    bool m_is_in_tree { false };
+};
+
+static GC::Root<TreeNode> build_tree(GC::Heap& heap, size_t node_count, size_t fan_out)
+{
+    Vector<GC::Root<TreeNode>> nodes;
+    nodes.ensure_capacity(node_count);
+    nodes.append(heap.allocate<TreeNode>());
+    nodes.first()->set_in_tree();
+    for (size_t i = 1; i < node_count; ++i) {
+        auto node = heap.allocate<TreeNode>();
+        node->set_in_tree();
+        nodes[(i - 1) / fan_out]->append_child(node);
+        nodes.append(node);
+    }
+    return nodes.first();
+}
+
+NEVER_INLINE static void allocate_garbage(GC::Heap& heap, size_t node_count)
+{
+    for (size_t i = 0; i < node_count; ++i)
+        (void)heap.allocate<TreeNode>();
+}
+
+static void collect_and_verify_tree_survives(size_t helper_thread_count)
+{
+    static constexpr size_t tree_node_count = 20'000;
+    static constexpr size_t garbage_node_count = 5'000;
+
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_marking_helper_thread_count(helper_thread_count);
+
+    auto root = build_tree(heap, tree_node_count, 4);
+    allocate_garbage(heap, garbage_node_count);
+
+    for (size_t collection = 0; collection < 2; ++collection) {
+        s_destroyed_node_count = 0;
+        s_destroyed_tree_node_count = 0;
+        heap.collect_garbage();
+
+        // Conservative stack scanning may keep a few garbage nodes alive, but none of the tree may be collected.
+        EXPECT_EQ(s_destroyed_tree_node_count, 0u);
+        EXPECT(s_destroyed_node_count <= garbage_node_count);
+        EXPECT_EQ(root->count_nodes(), tree_node_count);
+    }
+}
+
+TEST_CASE(serial_marking_keeps_reachable_cells_alive)
+{
+    collect_and_verify_tree_survives(0);
+}
+
+TEST_CASE(parallel_marking_keeps_reachable_cells_alive)
+{
+    collect_and_verify_tree_survives(1);
+    collect_and_verify_tree_survives(3);
+    collect_and_verify_tree_survives(7);
+}
+
+BENCHMARK_CASE(parallel_marking_scaling)
+{
+    static constexpr Array node_counts { 100'000uz, 1'000'000uz };
+    static constexpr Array helper_thread_counts { 0uz, 1uz, 3uz, 7uz };
+
+    for (auto node_count : node_counts) {
+        GC::Heap heap(nullptr, [](auto&) { });
+        auto root = build_tree(heap, node_count, 8);
+
+        for (auto helper_thread_count : helper_thread_counts) {
+            heap.set_marking_helper_thread_count(helper_thread_count);
+
+            // Warm up, then measure the average pause over a few collections.
+            heap.collect_garbage();
+            static constexpr size_t iterations = 5;
+            auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+            for (size_t i = 0; i < iterations; ++i)
+                heap.collect_garbage();
+
+            outln("{:>8} cells, {} marking threads: {} us per collection", node_count, helper_thread_count + 1, timer.elapsed_time().to_microseconds() / iterations);
+        }
+    }
+}
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Enumerate.h>
+#include <AK/TemporaryChange.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/Date.h>
 #include <LibJS/Runtime/TypedArray.h>
@@ -24,6 +25,8 @@ TESTJS_GLOBAL_FUNCTION(is_strict_mode, isStrictMode, 0)
 TESTJS_GLOBAL_FUNCTION(can_parse_source, canParseSource)
 {
     auto source = TRY(vm.argument(0).to_string(vm));
+    // NOTE: Pre-parsed function bodies leave most early errors for their first call, but this asks about all of them.
+    TemporaryChange lazy_function_parsing_change(JS::g_lazy_function_parsing, false);
     auto parser = JS::Parser(JS::Lexer(source));
     (void)parser.parse_program();
     return JS::Value(!parser.has_errors());
@@ -1050,6 +1050,37 @@ BENCHMARK_CASE(fork_performance)
     }
 }
 
+BENCHMARK_CASE(fork_performance_worst_case)
+{
+    // These take exponential time with a backtracking engine, and are searched for at every position.
+    auto lots_of_a_s = g_lots_of_a_s.bytes_as_string_view().substring_view(0, 100'000);
+    auto lots_of_a_s_and_a_b = MUST(String::formatted("{}b", lots_of_a_s));
+    auto options = ECMAScriptFlags::Global | ECMAScriptFlags::BrowserExtended;
+    {
+        Regex<ECMA262> re("(a|aa)*b", options);
+        EXPECT_EQ(re.match(lots_of_a_s).success, false);
+        EXPECT_EQ(re.match(lots_of_a_s_and_a_b).success, true);
+    }
+    {
+        Regex<ECMA262> re("(a+)+b", options);
+        EXPECT_EQ(re.match(lots_of_a_s).success, false);
+    }
+    {
+        Regex<ECMA262> re("^(a|a?)+$", options);
+        EXPECT_EQ(re.match(lots_of_a_s_and_a_b).success, false);
+    }
+}
+
+BENCHMARK_CASE(literal_prefix_search_performance)
+{
+    auto subject = MUST(String::repeated('x', 1'000'000));
+    Regex<ECMA262> re("xyz"sv, ECMAScriptFlags::Global | ECMAScriptFlags::BrowserExtended);
+    for (size_t i = 0; i < 100; ++i) {
+        auto result = re.match(subject);
+        EXPECT_EQ(result.success, false);
+    }
+}
+
 BENCHMARK_CASE(anchor_performance)
 {
     Regex<ECMA262> re("^b");
@@ -1059,6 +1090,154 @@ BENCHMARK_CASE(anchor_performance)
     }
 }
 
+TEST_CASE(execution_engine_selection)
+{
+    struct Test {
+        StringView pattern;
+        regex::ExecutionEngine engine;
+    };
+    using enum regex::ExecutionEngine;
+    Array tests {
+        Test { "abc"sv, Backtracking },
+        Test { "a*b*c*"sv, Backtracking },
+        Test { ".*foo.*"sv, Backtracking },
+        Test { "(\\w+)\\s(\\w+)?"sv, Backtracking },
+        Test { "(a|ab)(c|bcd)(d*)"sv, Backtracking },
+        // Loops that can match the same input in more than one way.
+        Test { "(a|aa)*b"sv, PikeVM },
+        Test { "(a+)+b"sv, PikeVM },
+        Test { "^(a|a?)+$"sv, PikeVM },
+        Test { "(a{2,3})+"sv, PikeVM },
+        // The Pike VM doesn't support backreferences and lookarounds.
+        Test { "((a|aa)*)\\1"sv, Backtracking },
+        Test { "(?=(a|aa)*)(a+)+"sv, Backtracking },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern);
+        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+        EXPECT_EQ(re.parser_result.optimization_data.execution_engine, test.engine);
+    }
+}
+
+TEST_CASE(pike_vm)
+{
+    struct Test {
+        StringView pattern;
+        StringView subject;
+        size_t match_column;
+        StringView match;
+        Vector<StringView> captures;
+    };
+    Array tests {
+        Test { "(a|aa)*b"sv, "aaab"sv, 0, "aaab"sv, { "a"sv } },
+        // Alternatives must be preferred in the same order as with backtracking, not by match length.
+        Test { "(a|ab)(c|bcd)(d*)"sv, "abcd"sv, 0, "abcd"sv, { "a"sv, "bcd"sv, ""sv } },
+        Test { "(a*?)(a*)"sv, "aaa"sv, 0, "aaa"sv, { ""sv, "aaa"sv } },
+        // A thread that matches a whole string at once must keep its priority over those that match one character.
+        Test { "(?:(abc)|(a)(b)(c))"sv, "abc"sv, 0, "abc"sv, { "abc"sv, {}, {}, {} } },
+        Test { "(?:(a)(b)(c)|(abc))"sv, "abc"sv, 0, "abc"sv, { "a"sv, "b"sv, "c"sv, {} } },
+        Test { "(a{2,3})+"sv, "aaaaa"sv, 0, "aaaaa"sv, { "aa"sv } },
+        Test { "(\\w+)\\s(\\w+)?"sv, "hello "sv, 0, "hello "sv, { "hello"sv, {} } },
+        // The leftmost match wins, even if a later one would be found sooner.
+        Test { "(a+)+b"sv, "aaaa-aab"sv, 5, "aab"sv, { "aa"sv } },
+        Test { "x(a|aa)*y|b"sv, "xaaaaab xaay"sv, 6, "b"sv, { {} } },
+        Test { "(a|aa)*b"sv, "xxaab"sv, 2, "aab"sv, { "a"sv } },
+        Test { "(?:a|b)*c"sv, "ababab abc"sv, 7, "abc"sv, {} },
+    };
+
+    // Both engines must agree, so run the tests on each of them.
+    for (auto engine : { regex::ExecutionEngine::Backtracking, regex::ExecutionEngine::PikeVM }) {
+        for (auto& test : tests) {
+            Regex<ECMA262> re(test.pattern, ECMAScriptFlags::Global | ECMAScriptFlags::BrowserExtended);
+            re.parser_result.optimization_data.execution_engine = engine;
+
+            auto result = re.match(test.subject);
+            EXPECT_EQ(result.success, true);
+            if (!result.success)
+                continue;
+            EXPECT_EQ(result.matches[0].column, test.match_column);
+            EXPECT_EQ(result.matches[0].view, test.match);
+            EXPECT_EQ(result.capture_group_matches[0].size(), test.captures.size());
+            for (size_t i = 0; i < min(result.capture_group_matches[0].size(), test.captures.size()); ++i)
+                EXPECT_EQ(result.capture_group_matches[0][i].view, test.captures[i]);
+        }
+    }
+}
+
+TEST_CASE(pike_vm_global_matches)
+{
+    Regex<ECMA262> re("(a|aa)*b"sv, ECMAScriptFlags::Global | ECMAScriptFlags::BrowserExtended);
+    EXPECT_EQ(re.parser_result.optimization_data.execution_engine, regex::ExecutionEngine::PikeVM);
+
+    auto result = re.match("ab-aab-b-aaa"sv);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.matches.size(), 3u);
+    if (result.matches.size() != 3)
+        return;
+    EXPECT_EQ(result.matches[0].view, "ab"sv);
+    EXPECT_EQ(result.matches[1].view, "aab"sv);
+    EXPECT_EQ(result.matches[1].column, 3u);
+    EXPECT_EQ(result.matches[2].view, "b"sv);
+    EXPECT_EQ(result.matches[2].column, 7u);
+}
+
+TEST_CASE(pike_vm_search_is_linear)
+{
+    // A failed search has to try every start position, which must not mean running over the rest of the input again
+    // for each of them.
+    auto operations_for = [](StringView pattern, size_t length) {
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Global | ECMAScriptFlags::BrowserExtended);
+        EXPECT_EQ(re.parser_result.optimization_data.execution_engine, regex::ExecutionEngine::PikeVM);
+        auto result = re.match(g_lots_of_a_s.bytes_as_string_view().substring_view(0, length));
+        EXPECT_EQ(result.success, false);
+        return result.n_operations;
+    };
+
+    for (auto pattern : { "(a|aa)*b"sv, "(a+)+b"sv }) {
+        auto short_operations = operations_for(pattern, 10'000);
+        auto long_operations = operations_for(pattern, 40'000);
+        EXPECT(long_operations < short_operations * 5);
+    }
+}
+
+TEST_CASE(skip_to_possible_match_starts)
+{
+    struct Test {
+        StringView pattern;
+        StringView subject;
+        Vector<size_t> match_columns;
+    };
+    Array tests {
+        // Literal prefixes, where the rarest character isn't the first one.
+        Test { "foo"sv, "fofoo foo fo"sv, { 2, 6 } },
+        Test { "ezq\\d"sv, "ezq ezqe ezq1 zq2 ezq3"sv, { 9, 18 } },
+        Test { "(?:ab)c+"sv, "abab abc abcc bc"sv, { 5, 9 } },
+        Test { "xy"sv, "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxy"sv, { 33 } },
+        // Starting character classes, both inside and outside of a whole vector of characters.
+        Test { "[0-9]+"sv, "abc 12 def 3 ghijklmnopqrstuvwxyz 456"sv, { 4, 11, 40 } },
+        Test { "[a-c][x-z]|[m-p]q"sv, "--------------------------------ay-nq-bx"sv, { 32, 35, 38 } },
+        Test { "[0-9]"sv, "no digits in here, not even near the end"sv, {} },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern, ECMAScriptFlags::Global | ECMAScriptFlags::BrowserExtended);
+        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+
+        auto check_result = [&](RegexResult const& result) {
+            EXPECT_EQ(result.success, !test.match_columns.is_empty());
+            EXPECT_EQ(result.matches.size(), test.match_columns.size());
+            for (size_t i = 0; i < min(result.matches.size(), test.match_columns.size()); ++i)
+                EXPECT_EQ(result.matches[i].column, test.match_columns[i]);
+        };
+
+        check_result(re.match(test.subject));
+
+        auto subject = MUST(AK::utf8_to_utf16(test.subject));
+        check_result(re.match(Utf16View { subject }));
+    }
+}
+
 TEST_CASE(optimizer_atomic_groups)
 {
     Array tests {
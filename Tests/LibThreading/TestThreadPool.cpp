@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Time.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+#include <LibThreading/ThreadPool.h>
+#include <unistd.h>
+
+static void wait_until(Function<bool()> condition)
+{
+    for (auto i = 0; i < 500; ++i) {
+        if (condition())
+            return;
+        usleep(10'000);
+    }
+    FAIL("Timed out waiting for the thread pool");
+}
+
+TEST_CASE(runs_all_submitted_tasks)
+{
+    Threading::ThreadPool pool { 4 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> sum { 0 };
+
+    for (size_t i = 1; i <= 1000; ++i)
+        pool.submit([&sum, i] { sum += i; });
+
+    wait_until([&] { return sum.load() == 500500; });
+}
+
+TEST_CASE(tasks_can_submit_tasks)
+{
+    Threading::ThreadPool pool { 4 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> leaves { 0 };
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Function<void(size_t)> spawn;
+    spawn = [&](size_t depth) {
+        if (depth == 0) {
+            ++leaves;
+            return;
+        }
+        pool.submit([&spawn, depth] { spawn(depth - 1); });
+        pool.submit([&spawn, depth] { spawn(depth - 1); });
+    };
+    pool.submit([&] { spawn(10); });
+
+    wait_until([&] { return leaves.load() == 1024; });
+    pool.shutdown();
+}
+
+TEST_CASE(higher_priority_tasks_run_first)
+{
+    Threading::ThreadPool pool { 1 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> blocker_started { false };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> blocker_may_finish { false };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> finished { 0 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Vector<char> order;
+
+    // Keep the only worker busy until everything else has been queued.
+    pool.submit([&] {
+        blocker_started = true;
+        while (!blocker_may_finish.load())
+            usleep(1000);
+    });
+    wait_until([&] { return blocker_started.load(); });
+
+    auto submit = [&](char name, Threading::ThreadPool::Priority priority) {
+        pool.submit([&order, &finished, name] {
+            order.append(name);
+            ++finished;
+        },
+            priority);
+    };
+    submit('l', Threading::ThreadPool::Priority::Low);
+    submit('n', Threading::ThreadPool::Priority::Normal);
+    submit('h', Threading::ThreadPool::Priority::High);
+    submit('N', Threading::ThreadPool::Priority::Normal);
+    blocker_may_finish = true;
+
+    wait_until([&] { return finished.load() == 4; });
+    EXPECT_EQ(StringView(order.data(), order.size()), "hnNl"sv);
+}
+
+TEST_CASE(canceled_tasks_do_not_run)
+{
+    Threading::ThreadPool pool { 1 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> blocker_may_finish { false };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> canceled_task_ran { false };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> last_task_ran { false };
+
+    pool.submit([&] {
+        while (!blocker_may_finish.load())
+            usleep(1000);
+    });
+    auto task = pool.submit([&] { canceled_task_ran = true; });
+    pool.submit([&] { last_task_ran = true; });
+
+    EXPECT(task->cancel());
+    EXPECT(task->is_canceled());
+    EXPECT(!task->cancel());
+    blocker_may_finish = true;
+
+    wait_until([&] { return last_task_ran.load(); });
+    EXPECT(!canceled_task_ran.load());
+}
+
+TEST_CASE(results_are_posted_to_the_submitting_event_loop)
+{
+    Core::EventLoop event_loop;
+    Threading::ThreadPool pool { 2 };
+    auto main_thread = pthread_self();
+
+    Optional<int> result;
+    bool completed_on_main_thread = false;
+    pool.submit_and_post_result(
+        [] { return 42; },
+        [&](int value) {
+            result = value;
+            completed_on_main_thread = pthread_equal(pthread_self(), main_thread);
+            event_loop.quit(0);
+        });
+    event_loop.exec();
+
+    EXPECT_EQ(result, 42);
+    EXPECT(completed_on_main_thread);
+}
+
+TEST_CASE(shutdown_and_restart)
+{
+    Threading::ThreadPool pool { 2 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> count { 0 };
+
+    pool.submit([&] { ++count; });
+    wait_until([&] { return count.load() == 1; });
+    pool.shutdown();
+
+    pool.submit([&] { ++count; });
+    wait_until([&] { return count.load() == 2; });
+}
+
+TEST_CASE(tasks_submitted_during_shutdown_are_not_lost)
+{
+    static constexpr size_t task_count = 2000;
+    Threading::ThreadPool pool { 2 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> done_submitting { false };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> ran { 0 };
+
+    auto shutdown_thread = Threading::Thread::construct([&] {
+        while (!done_submitting.load())
+            pool.shutdown();
+        return static_cast<intptr_t>(0);
+    });
+    shutdown_thread->start();
+
+    Vector<NonnullRefPtr<Threading::ThreadPool::Task>> tasks;
+    for (size_t i = 0; i < task_count; ++i)
+        tasks.append(pool.submit([&] { ++ran; }));
+    done_submitting = true;
+    MUST(shutdown_thread->join());
+
+    // Every task has either run, or was canceled by a shutdown; none may be left sitting in a queue without workers.
+    wait_until([&] {
+        size_t canceled = 0;
+        for (auto const& task : tasks)
+            canceled += task->is_canceled() ? 1 : 0;
+        return ran.load() + canceled == task_count;
+    });
+}
+
+// Runs the same amount of CPU-bound work on pools of growing size, to see how well the pool scales with cores.
+BENCHMARK_CASE(scaling)
+{
+    static constexpr size_t task_count = 4096;
+    static constexpr size_t iterations_per_task = 50'000;
+
+    auto run = [](size_t worker_count) {
+        Threading::ThreadPool pool { worker_count };
+        IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> remaining { task_count };
+        IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<u64> checksum { 0 };
+
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        for (size_t i = 0; i < task_count; ++i) {
+            pool.submit([&, i] {
+                u64 value = i;
+                for (size_t j = 0; j < iterations_per_task; ++j)
+                    value = value * 6364136223846793005ull + 1442695040888963407ull;
+                checksum += value;
+                --remaining;
+            });
+        }
+        while (remaining.load() != 0)
+            usleep(100);
+        return timer.elapsed_time();
+    };
+
+    auto baseline = run(1);
+    outln("1 worker: {}ms", baseline.to_milliseconds());
+    for (size_t workers = 2; workers <= max(Core::System::hardware_concurrency(), 2u); workers *= 2) {
+        auto elapsed = run(workers);
+        outln("{} workers: {}ms ({:.2}x)", workers, elapsed.to_milliseconds(), static_cast<double>(baseline.to_microseconds()) / static_cast<double>(max(elapsed.to_microseconds(), 1)));
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+// Each module exports a single CPU-bound function, run(i32) -> i32.
+
+// (func (export "run") (param $n i32) (result i32)): the $n-th Fibonacci number, computed in an i64 loop and wrapped to i32.
+static constexpr Array<u8, 83> fibonacci_loop_module {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x00, 0x0a, 0x34, 0x01,
+    0x32, 0x01, 0x03, 0x7e, 0x42, 0x00, 0x21, 0x01, 0x42, 0x01, 0x21, 0x02, 0x02, 0x40, 0x03, 0x40,
+    0x20, 0x00, 0x45, 0x0d, 0x01, 0x20, 0x01, 0x20, 0x02, 0x7c, 0x21, 0x03, 0x20, 0x02, 0x21, 0x01,
+    0x20, 0x03, 0x21, 0x02, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x0b, 0x20,
+    0x01, 0xa7, 0x0b,
+};
+
+// (func (export "run") (param $n i32) (result i32)): the $n-th Fibonacci number, computed with two recursive calls.
+static constexpr Array<u8, 61> fibonacci_recursive_module {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x00, 0x0a, 0x1e, 0x01,
+    0x1c, 0x00, 0x20, 0x00, 0x41, 0x02, 0x48, 0x04, 0x7f, 0x20, 0x00, 0x05, 0x20, 0x00, 0x41, 0x01,
+    0x6b, 0x10, 0x00, 0x20, 0x00, 0x41, 0x02, 0x6b, 0x10, 0x00, 0x6a, 0x0b, 0x0b,
+};
+
+// (memory 1) (func (export "run") (param $n i32) (result i32)): the number of primes below $n (at most 65536), found
+// with a sieve of Eratosthenes in memory.
+static constexpr Array<u8, 155> prime_sieve_module {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e,
+    0x00, 0x00, 0x0a, 0x77, 0x01, 0x75, 0x01, 0x03, 0x7f, 0x41, 0x00, 0x21, 0x02, 0x02, 0x40, 0x03,
+    0x40, 0x20, 0x02, 0x20, 0x00, 0x4f, 0x0d, 0x01, 0x20, 0x02, 0x41, 0x00, 0x3a, 0x00, 0x00, 0x20,
+    0x02, 0x41, 0x01, 0x6a, 0x21, 0x02, 0x0c, 0x00, 0x0b, 0x0b, 0x41, 0x02, 0x21, 0x01, 0x02, 0x40,
+    0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4f, 0x0d, 0x01, 0x20, 0x01, 0x2d, 0x00, 0x00, 0x45, 0x04,
+    0x40, 0x20, 0x03, 0x41, 0x01, 0x6a, 0x21, 0x03, 0x20, 0x01, 0x20, 0x01, 0x6c, 0x21, 0x02, 0x02,
+    0x40, 0x03, 0x40, 0x20, 0x02, 0x20, 0x00, 0x4f, 0x0d, 0x01, 0x20, 0x02, 0x41, 0x01, 0x3a, 0x00,
+    0x00, 0x20, 0x02, 0x20, 0x01, 0x6a, 0x21, 0x02, 0x0c, 0x00, 0x0b, 0x0b, 0x0b, 0x20, 0x01, 0x41,
+    0x01, 0x6a, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x03, 0x0b,
+};
+
+// (func (export "run") (param $n i32) (result i32)): h = rotl(h ^ (i * j), 5) + i for all i, j < $n.
+static constexpr Array<u8, 103> nested_loop_hash_module {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x00, 0x0a, 0x48, 0x01,
+    0x46, 0x01, 0x03, 0x7f, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4f, 0x0d, 0x01, 0x41,
+    0x00, 0x21, 0x02, 0x02, 0x40, 0x03, 0x40, 0x20, 0x02, 0x20, 0x00, 0x4f, 0x0d, 0x01, 0x20, 0x03,
+    0x20, 0x01, 0x20, 0x02, 0x6c, 0x73, 0x41, 0x05, 0x77, 0x20, 0x01, 0x6a, 0x21, 0x03, 0x20, 0x02,
+    0x41, 0x01, 0x6a, 0x21, 0x02, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01,
+    0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x03, 0x0b,
+};
+
+// (func (export "run") (param $n i32) (result i32)): the first $n terms of the Leibniz series for pi, as
+// i32.trunc_f64_s(4000000 * sum).
+static constexpr Array<u8, 121> leibniz_series_module {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x00, 0x0a, 0x5a, 0x01,
+    0x58, 0x02, 0x01, 0x7f, 0x02, 0x7c, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x3f, 0x21,
+    0x03, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x4f, 0x0d, 0x01, 0x20, 0x02, 0x20, 0x03,
+    0x20, 0x01, 0xb7, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xa2, 0x44, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xf0, 0x3f, 0xa0, 0xa3, 0xa0, 0x21, 0x02, 0x20, 0x03, 0x9a, 0x21, 0x03,
+    0x20, 0x01, 0x41, 0x01, 0x6a, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x02, 0x44, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0x84, 0x4e, 0x41, 0xa2, 0xaa, 0x0b,
+};
+
+struct BenchmarkModule {
+    StringView name;
+    ReadonlyBytes bytes;
+    i32 small_argument;
+    i32 small_result;
+    i32 large_argument;
+    i32 large_result;
+};
+
+static Array<BenchmarkModule, 5> const benchmark_modules {
+    BenchmarkModule { "fibonacci_loop"sv, fibonacci_loop_module.span(), 90, -1581614984, 1'000'000, 1884755131 },
+    BenchmarkModule { "fibonacci_recursive"sv, fibonacci_recursive_module.span(), 20, 6765, 25, 75025 },
+    BenchmarkModule { "prime_sieve"sv, prime_sieve_module.span(), 100, 25, 65536, 6542 },
+    BenchmarkModule { "nested_loop_hash"sv, nested_loop_hash_module.span(), 10, 715276632, 1000, 395175026 },
+    BenchmarkModule { "leibniz_series"sv, leibniz_series_module.span(), 1000, 3140592, 1'000'000, 3141591 },
+};
+
+enum class CompiledFunctions {
+    No,
+    Yes,
+};
+
+class ModuleRunner {
+public:
+    ModuleRunner(ReadonlyBytes bytes, CompiledFunctions compiled_functions)
+    {
+        FixedMemoryStream stream { bytes };
+        m_module = MUST(Wasm::Module::parse(stream));
+        MUST(Wasm::AbstractMachine::validate(*m_module));
+        if (compiled_functions == CompiledFunctions::Yes)
+            m_machine.enable_compiled_functions();
+        m_instance = MUST(m_machine.instantiate(*m_module, {}));
+        VERIFY(m_instance->exports().size() == 1);
+        m_run = m_instance->exports().first().value().get<Wasm::FunctionAddress>();
+    }
+
+    i32 run(i32 argument)
+    {
+        auto result = m_machine.invoke(m_run, { Wasm::Value { argument } });
+        VERIFY(!result.is_trap());
+        return result.values().first().to<i32>();
+    }
+
+private:
+    Wasm::AbstractMachine m_machine;
+    RefPtr<Wasm::Module> m_module;
+    OwnPtr<Wasm::ModuleInstance> m_instance;
+    Wasm::FunctionAddress m_run;
+};
+
+TEST_CASE(compiled_functions_match_the_interpreter)
+{
+    for (auto const& module : benchmark_modules) {
+        ModuleRunner interpreted { module.bytes, CompiledFunctions::No };
+        ModuleRunner compiled { module.bytes, CompiledFunctions::Yes };
+        EXPECT_EQ(interpreted.run(module.small_argument), module.small_result);
+        EXPECT_EQ(compiled.run(module.small_argument), module.small_result);
+    }
+}
+
+static void run_benchmark_modules(CompiledFunctions compiled_functions)
+{
+    for (auto const& module : benchmark_modules) {
+        ModuleRunner runner { module.bytes, compiled_functions };
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        EXPECT_EQ(runner.run(module.large_argument), module.large_result);
+        outln("{}: {}ms", module.name, timer.elapsed_time().to_milliseconds());
+    }
+}
+
+BENCHMARK_CASE(cpu_bound_modules_interpreted)
+{
+    run_benchmark_modules(CompiledFunctions::No);
+}
+
+BENCHMARK_CASE(cpu_bound_modules_compiled)
+{
+    run_benchmark_modules(CompiledFunctions::Yes);
+}
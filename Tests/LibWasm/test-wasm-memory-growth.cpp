@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/Constants.h>
+
+static constexpr size_t page_size = Wasm::Constants::page_size;
+
+static u8 pattern_byte(size_t offset)
+{
+    return static_cast<u8>((offset * 31 + offset / page_size) & 0xff);
+}
+
+static void fill_page(Wasm::MemoryInstance& memory, size_t page)
+{
+    for (size_t offset = page * page_size; offset < (page + 1) * page_size; ++offset)
+        memory.data()[offset] = pattern_byte(offset);
+}
+
+static bool pages_hold_pattern(Wasm::MemoryInstance const& memory, size_t page_count)
+{
+    for (size_t offset = 0; offset < page_count * page_size; ++offset) {
+        if (memory.data()[offset] != pattern_byte(offset))
+            return false;
+    }
+    return true;
+}
+
+static bool page_is_zeroed(Wasm::MemoryInstance const& memory, size_t page)
+{
+    for (size_t offset = page * page_size; offset < (page + 1) * page_size; ++offset) {
+        if (memory.data()[offset] != 0)
+            return false;
+    }
+    return true;
+}
+
+static void grow_page_by_page(Wasm::MemoryInstance& memory, size_t initial_pages, size_t final_pages)
+{
+    for (size_t page = 0; page < initial_pages; ++page)
+        fill_page(memory, page);
+    auto const data = reinterpret_cast<FlatPtr>(memory.data().data());
+
+    for (size_t pages = initial_pages; pages < final_pages; ++pages) {
+        EXPECT(memory.grow(page_size));
+        EXPECT_EQ(memory.size(), (pages + 1) * page_size);
+#ifdef AK_ARCH_64_BIT
+        // The whole range the memory may grow to was reserved when it was created.
+        EXPECT_EQ(reinterpret_cast<FlatPtr>(memory.data().data()), data);
+#else
+        (void)data;
+#endif
+        EXPECT(pages_hold_pattern(memory, pages));
+        EXPECT(page_is_zeroed(memory, pages));
+        fill_page(memory, pages);
+    }
+}
+
+TEST_CASE(growing_up_to_the_maximum_keeps_data_in_place)
+{
+    auto memory = MUST(Wasm::MemoryInstance::create(Wasm::MemoryType { Wasm::Limits { 1, 16 } }));
+    grow_page_by_page(memory, 1, 16);
+
+    // Growing past the maximum fails and leaves the memory as it was.
+    auto const data = reinterpret_cast<FlatPtr>(memory.data().data());
+    EXPECT(!memory.grow(page_size));
+    EXPECT_EQ(memory.size(), 16 * page_size);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(memory.data().data()), data);
+    EXPECT(pages_hold_pattern(memory, 16));
+}
+
+TEST_CASE(growing_without_a_maximum_keeps_data_in_place)
+{
+    auto memory = MUST(Wasm::MemoryInstance::create(Wasm::MemoryType { Wasm::Limits { 2 } }));
+    grow_page_by_page(memory, 2, 34);
+}
+
+TEST_CASE(growing_by_several_pages_at_once)
+{
+    auto memory = MUST(Wasm::MemoryInstance::create(Wasm::MemoryType { Wasm::Limits { 0, 64 } }));
+    EXPECT_EQ(memory.size(), 0u);
+
+    EXPECT(memory.grow(4 * page_size));
+    for (size_t page = 0; page < 4; ++page)
+        fill_page(memory, page);
+    auto const data = reinterpret_cast<FlatPtr>(memory.data().data());
+
+    for (size_t pages = 4; pages < 64; pages += 12) {
+        EXPECT(memory.grow(12 * page_size));
+#ifdef AK_ARCH_64_BIT
+        EXPECT_EQ(reinterpret_cast<FlatPtr>(memory.data().data()), data);
+#else
+        (void)data;
+#endif
+        EXPECT(pages_hold_pattern(memory, pages));
+        for (size_t page = pages; page < pages + 12; ++page) {
+            EXPECT(page_is_zeroed(memory, page));
+            fill_page(memory, page);
+        }
+    }
+    EXPECT_EQ(memory.size(), 64 * page_size);
+}
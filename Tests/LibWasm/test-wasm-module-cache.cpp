@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibFileSystem/TempFile.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+// (module (func (export "answer") (result i32) (i32.const 42)))
+static constexpr Array<u8, 39> module_bytes {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,                   // Magic and version
+    0x01, 0x05, 0x01, 0x60, 0x00, 0x01, 0x7f,                         // Type section: [] -> [i32]
+    0x03, 0x02, 0x01, 0x00,                                           // Function section
+    0x07, 0x0a, 0x01, 0x06, 'a', 'n', 's', 'w', 'e', 'r', 0x00, 0x00, // Export section
+    0x0a, 0x06, 0x01, 0x04, 0x00, 0x41, 0x2a, 0x0b,                   // Code section: i32.const 42
+};
+
+struct Statistics {
+    u64 hits { 0 };
+    u64 misses { 0 };
+    u64 stores { 0 };
+    u64 errors { 0 };
+};
+
+static Statistics statistics()
+{
+    auto const& statistics = Wasm::ModuleCache::the().statistics();
+    return { statistics.hits.load(), statistics.misses.load(), statistics.stores.load(), statistics.errors.load() };
+}
+
+static NonnullRefPtr<Wasm::Module> parse_and_validate()
+{
+    FixedMemoryStream stream { module_bytes.span() };
+    auto module = MUST(Wasm::Module::parse(stream));
+    MUST(Wasm::AbstractMachine::validate(module));
+    return module;
+}
+
+static i32 call_answer(Wasm::Module const& module)
+{
+    Wasm::AbstractMachine machine;
+    auto instance = MUST(machine.instantiate(module, {}));
+    auto const& exports = instance->exports();
+    VERIFY(exports.size() == 1);
+    EXPECT_EQ(exports.first().name(), "answer"sv);
+    auto result = machine.invoke(exports.first().value().get<Wasm::FunctionAddress>(), {});
+    VERIFY(!result.is_trap());
+    return result.values().first().to<i32>();
+}
+
+static Vector<ByteString> cache_files(StringView directory)
+{
+    Vector<ByteString> files;
+    MUST(Core::Directory::for_each_entry(directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        files.append(ByteString::formatted("{}/{}", directory, entry.name));
+        return IterationDecision::Continue;
+    }));
+    return files;
+}
+
+static void rewrite_cache_files(StringView directory, Function<void(ByteBuffer&)> mutate)
+{
+    for (auto const& path : cache_files(directory)) {
+        auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+        auto contents = MUST(file->read_until_eof());
+        mutate(contents);
+        file = MUST(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        MUST(file->write_until_depleted(contents));
+    }
+}
+
+TEST_CASE(round_trip)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto& cache = Wasm::ModuleCache::the();
+    cache.set_directory(directory->path().to_byte_string());
+    auto before = statistics();
+
+    EXPECT(!cache.load(module_bytes.span()));
+    cache.store(module_bytes.span(), parse_and_validate());
+    EXPECT_EQ(cache_files(directory->path()).size(), 1u);
+
+    auto module = cache.load(module_bytes.span());
+    EXPECT(module);
+    EXPECT_EQ(module->validation_status(), Wasm::Module::ValidationStatus::Valid);
+    EXPECT_EQ(module->code_section().functions().size(), 1u);
+    EXPECT_EQ(call_answer(*module), 42);
+
+    auto after = statistics();
+    EXPECT_EQ(after.hits - before.hits, 1u);
+    EXPECT_EQ(after.misses - before.misses, 1u);
+    EXPECT_EQ(after.stores - before.stores, 1u);
+    EXPECT_EQ(after.errors - before.errors, 0u);
+}
+
+TEST_CASE(unvalidated_modules_are_not_stored)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto& cache = Wasm::ModuleCache::the();
+    cache.set_directory(directory->path().to_byte_string());
+
+    FixedMemoryStream stream { module_bytes.span() };
+    auto unchecked_module = MUST(Wasm::Module::parse(stream));
+    cache.store(module_bytes.span(), unchecked_module);
+    EXPECT_EQ(cache_files(directory->path()).size(), 0u);
+}
+
+TEST_CASE(corrupted_cache_files_are_rejected)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto& cache = Wasm::ModuleCache::the();
+    cache.set_directory(directory->path().to_byte_string());
+    cache.store(module_bytes.span(), parse_and_validate());
+
+    // Change the constant the function returns (the last 42 before the checksum). This still decodes fine, so only the
+    // checksum can catch it.
+    rewrite_cache_files(directory->path(), [](ByteBuffer& contents) {
+        auto offset = contents.size() - 32;
+        while (offset > 0 && contents[--offset] != 42)
+            ;
+        VERIFY(contents[offset] == 42);
+        contents[offset] = 43;
+    });
+
+    auto before = statistics();
+    EXPECT(!cache.load(module_bytes.span()));
+    auto after = statistics();
+    EXPECT_EQ(after.hits - before.hits, 0u);
+    EXPECT_EQ(after.errors - before.errors, 1u);
+}
+
+TEST_CASE(truncated_cache_files_are_rejected)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto& cache = Wasm::ModuleCache::the();
+    cache.set_directory(directory->path().to_byte_string());
+    cache.store(module_bytes.span(), parse_and_validate());
+
+    rewrite_cache_files(directory->path(), [](ByteBuffer& contents) {
+        contents.resize(contents.size() - 1);
+    });
+
+    auto before = statistics();
+    EXPECT(!cache.load(module_bytes.span()));
+    auto after = statistics();
+    EXPECT_EQ(after.hits - before.hits, 0u);
+    EXPECT_EQ(after.errors - before.errors, 1u);
+}
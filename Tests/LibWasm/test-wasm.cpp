@@ -13,6 +13,8 @@
 
 TEST_ROOT("Libraries/LibWasm/Tests");
 
+TESTJS_PROGRAM_FLAG(compiled_functions, "Run functions through their compiled form instead of interpreting every instruction", "compiled-functions", 0);
+
 TESTJS_GLOBAL_FUNCTION(read_binary_wasm_file, readBinaryWasmFile)
 {
     auto& realm = *vm.current_realm();
@@ -47,7 +49,11 @@ public:
     explicit WebAssemblyModule(JS::Object& prototype)
         : JS::Object(ConstructWithPrototypeTag::Tag, prototype)
     {
-        m_machine.enable_instruction_count_limit();
+        // NOTE: Compiled functions don't count the instructions they execute, so they're only used without the limit.
+        if (compiled_functions)
+            m_machine.enable_compiled_functions();
+        else
+            m_machine.enable_instruction_count_limit();
     }
 
     static Wasm::AbstractMachine& machine() { return m_machine; }
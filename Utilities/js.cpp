@@ -17,8 +17,10 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Print.h>
 #include <LibJS/Runtime/ConsoleObject.h>
@@ -788,6 +790,11 @@ static ErrorOr<int> run_repl(bool gc_on_every_allocation, bool syntax_highlight)
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     bool gc_on_every_allocation = false;
+    bool precise_gc_roots_only = false;
+    bool use_jit = false;
+    bool dump_bytecode_pass_statistics = false;
+    bool lazy_function_parsing = false;
+    bool dump_property_cache_statistics = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
@@ -803,6 +810,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(use_jit, "Compile hot code with the baseline JIT", "jit", {});
+    args_parser.add_option(JS::Bytecode::g_optimize_bytecode, "Run the bytecode optimization passes", "optimize-bytecode", {});
+    args_parser.add_option(dump_bytecode_pass_statistics, "Print timing and instruction counts for each bytecode optimization pass on exit", "dump-bytecode-pass-statistics", {});
+    args_parser.add_option(lazy_function_parsing, "Only pre-parse nested function bodies and parse them on their first call, and print statistics on exit", "lazy-functions", {});
+    args_parser.add_option(dump_property_cache_statistics, "Print how many property lookup sites went polymorphic or megamorphic, and stub cache hit/miss counts on exit", "dump-property-cache-statistics", {});
+    args_parser.add_option(precise_gc_roots_only, "Don't scan the native stack for GC roots, and report root counts on exit (unsafe, for measurement only)", "precise-gc-roots-only", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(s_disable_string_quotes, "Disable quotes around strings", "disable-string-quotes", {});
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
@@ -814,11 +827,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     [[maybe_unused]] bool syntax_highlight = !disable_syntax_highlight;
 
     AK::set_debug_enabled(!disable_debug_printing);
+    JS::JIT::g_enabled = use_jit;
+    JS::g_lazy_function_parsing = lazy_function_parsing;
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
     g_vm_storage.get() = JS::VM::create();
     g_vm = g_vm_storage->ptr();
     g_vm->set_dynamic_imports_allowed(true);
+    g_vm->heap().set_conservative_stack_scanning_enabled(!precise_gc_roots_only);
 
     if (!disable_debug_printing) {
         // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
@@ -894,6 +910,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
             return 1;
+
+        if (precise_gc_roots_only) {
+            g_vm->heap().collect_garbage();
+            auto const& statistics = g_vm->heap().collection_statistics();
+            warnln("GC roots: {} precise, {} conservative", statistics.precise_roots, statistics.conservative_roots);
+        }
+
+        if (dump_bytecode_pass_statistics)
+            JS::Bytecode::PassManager::default_pipeline().dump_statistics();
+
+        if (lazy_function_parsing)
+            JS::dump_lazy_function_parsing_statistics();
+
+        if (dump_property_cache_statistics)
+            g_vm->bytecode_interpreter().stub_cache().dump_statistics();
     }
 
     return s_exit_code;
@@ -17,6 +17,7 @@
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Runtime/Agent.h>
 #include <LibJS/Runtime/VM.h>
@@ -579,6 +580,7 @@ int main(int argc, char** argv)
     int timeout = 10;
     bool enable_debug_printing = false;
     bool disable_core_dumping = false;
+    bool use_jit = false;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("LibJS test262 runner for streaming tests");
@@ -587,8 +589,15 @@ int main(int argc, char** argv)
     args_parser.add_option(timeout, "Seconds before test should timeout", "timeout", 't', "seconds");
     args_parser.add_option(enable_debug_printing, "Enable debug printing", "debug", 'd');
     args_parser.add_option(disable_core_dumping, "Disable core dumping", "disable-core-dump");
+    args_parser.add_option(use_jit, "Compile every executable with the baseline JIT", "jit");
     args_parser.parse(arguments);
 
+    if (use_jit) {
+        // Most test262 code only runs once, so compile eagerly to exercise the JIT as much as possible.
+        JS::JIT::g_enabled = true;
+        JS::JIT::g_compile_threshold = 1;
+    }
+
 #ifdef AK_OS_GNU_HURD
     if (disable_core_dumping)
         setenv("CRASHSERVER", "/servers/crash-kill", true);
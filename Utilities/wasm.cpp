@@ -10,6 +10,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/StackInfo.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibFileSystem/FileSystem.h>
@@ -17,6 +18,8 @@
 #include <LibMain/Main.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/ModuleCache.h>
+#include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
 #include <LibWasm/Wasi.h>
@@ -500,13 +503,38 @@ static RefPtr<Wasm::Module> parse(StringView filename)
         return {};
     }
 
-    auto parse_result = Wasm::Module::parse(*result.value());
+    auto& module_cache = Wasm::ModuleCache::the();
+    if (!module_cache.is_enabled()) {
+        auto parse_result = Wasm::Module::parse(*result.value());
+        if (parse_result.is_error()) {
+            warnln("Something went wrong, either the file is invalid, or there's a bug with LibWasm!");
+            warnln("The parse error was {}", Wasm::parse_error_to_byte_string(parse_result.error()));
+            return {};
+        }
+        return parse_result.release_value();
+    }
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    auto bytes = result.value()->bytes();
+    if (auto module = module_cache.load(bytes)) {
+        warnln("Loaded {} from the module cache in {}us", filename, timer.elapsed_time().to_microseconds());
+        return module;
+    }
+
+    FixedMemoryStream stream { bytes };
+    auto parse_result = Wasm::Module::parse(stream);
     if (parse_result.is_error()) {
         warnln("Something went wrong, either the file is invalid, or there's a bug with LibWasm!");
         warnln("The parse error was {}", Wasm::parse_error_to_byte_string(parse_result.error()));
         return {};
     }
-    return parse_result.release_value();
+    auto module = parse_result.release_value();
+    // NOTE: Validation would otherwise happen during instantiation, but only valid modules can be cached.
+    if (!Wasm::AbstractMachine::validate(module).is_error()) {
+        warnln("Parsed and validated {} in {}us", filename, timer.elapsed_time().to_microseconds());
+        module_cache.store(bytes, module);
+    }
+    return module;
 }
 
 static void print_link_error(Wasm::LinkError const& error)
@@ -524,6 +552,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool export_all_imports = false;
     bool shell_mode = false;
     bool wasi = false;
+    bool compiled_functions = false;
+    size_t benchmark_iterations = 0;
+    StringView module_cache_directory;
     ByteString exported_function_to_execute;
     Vector<ParsedValue> values_to_push;
     Vector<ByteString> modules_to_link_in;
@@ -539,6 +570,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop");
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
+    parser.add_option(compiled_functions, "Run functions from their compiled form instead of interpreting every instruction", "compiled-functions");
+    parser.add_option(module_cache_directory, "Load and store validated modules in this directory, and report how long loading took", "module-cache", 0, "dir");
+    parser.add_option(benchmark_iterations, "Run the executed function this many times with and without compiled functions, and report the instruction throughput of both", "benchmark", 0, "iterations");
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Directory mappings to expose via WASI",
@@ -596,6 +630,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
+    if (benchmark_iterations > 0 && (debug || exported_function_to_execute.is_empty())) {
+        warnln("Benchmark what? (pass -e fn, and no -d or -s)");
+        return 1;
+    }
+
     if (debug || shell_mode) {
         old_signal = signal(SIGINT, sigint_handler);
     }
@@ -603,6 +642,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (!exported_function_to_execute.is_empty())
         attempt_instantiate = true;
 
+    if (!module_cache_directory.is_empty())
+        Wasm::ModuleCache::the().set_directory(module_cache_directory);
+
     auto parse_result = parse(filename);
     if (parse_result.is_null())
         return 1;
@@ -646,10 +688,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
 
         Core::EventLoop main_loop;
+        g_interpreter.set_compiled_functions_enabled(compiled_functions);
         if (debug) {
             g_line_editor = Line::Editor::construct();
             g_interpreter.pre_interpret_hook = pre_interpret_hook;
             g_interpreter.post_interpret_hook = post_interpret_hook;
+            // NOTE: Compiled functions don't go through the per-instruction hooks, so the debugger can't step through them.
+            g_interpreter.set_compiled_functions_enabled(false);
         }
 
         // First, resolve the linked modules
@@ -834,6 +879,41 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 outln();
             }
 
+            if (benchmark_iterations > 0) {
+                auto run_benchmark = [&](bool compiled_functions_enabled) -> Optional<AK::Duration> {
+                    g_interpreter.set_compiled_functions_enabled(compiled_functions_enabled);
+                    g_interpreter.reset_executed_instruction_count();
+                    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+                    for (size_t i = 0; i < benchmark_iterations; ++i) {
+                        auto result = machine.invoke(g_interpreter, run_address.value(), values);
+                        if (result.is_trap()) {
+                            warnln("Execution trapped: {}", result.trap().format());
+                            return {};
+                        }
+                    }
+                    return timer.elapsed_time();
+                };
+
+                // NOTE: Compiled functions only count the instructions they hand back to the interpreter, so the
+                //       instruction count of the interpreted run is used for both.
+                auto interpreted_time = run_benchmark(false);
+                if (!interpreted_time.has_value())
+                    return 1;
+                auto instruction_count = g_interpreter.executed_instruction_count();
+                auto compiled_time = run_benchmark(true);
+                if (!compiled_time.has_value())
+                    return 1;
+
+                auto instructions_per_second = [&](AK::Duration time) {
+                    return static_cast<double>(instruction_count) / max(time.to_nanoseconds(), 1) * 1'000'000'000.0;
+                };
+                outln("Executed {} instructions in {} iterations", instruction_count, benchmark_iterations);
+                outln("  interpreted: {}ms, {:.0} instructions/s", interpreted_time->to_milliseconds(), instructions_per_second(*interpreted_time));
+                outln("  compiled:    {}ms, {:.0} instructions/s", compiled_time->to_milliseconds(), instructions_per_second(*compiled_time));
+                outln("  speedup:     {:.2}x", static_cast<double>(max(interpreted_time->to_nanoseconds(), 1)) / max(compiled_time->to_nanoseconds(), 1));
+                return 0;
+            }
+
             auto result = machine.invoke(g_interpreter, run_address.value(), move(values));
 
             if (debug)